@@ -0,0 +1,60 @@
+# collect.cmake — merge per-case benchmark rows into one CSV
+#
+# Usage:
+#   cmake -DTL_BENCH_RESULTS_DIR=<dir> -DTL_BENCH_CSV=<file> -P collect.cmake
+#
+# Also prints every 'admission' row beside its 'admission_recursive'
+# baseline: instantiated functions (Clang only) and wall time.
+#
+# Copyright (c) 2024-2026 TypeLayout Development Team
+# Distributed under the Boost Software License, Version 1.0.
+
+cmake_minimum_required(VERSION 3.16)
+
+if(NOT TL_BENCH_RESULTS_DIR OR NOT TL_BENCH_CSV)
+    message(FATAL_ERROR "collect.cmake: TL_BENCH_RESULTS_DIR and TL_BENCH_CSV are required")
+endif()
+
+set(_csv "case,kind,size,probe,compiler,compiler_version,constexpr_steps,")
+string(APPEND _csv "status,wall_s,peak_rss_kb,frontend_ms,")
+string(APPEND _csv "instantiate_function_ms,instantiate_function_count,constexpr_eval_ms\n")
+
+file(GLOB _rows "${TL_BENCH_RESULTS_DIR}/*.csv")
+list(SORT _rows)
+set(_count 0)
+set(_admission_cases)
+foreach(_row IN LISTS _rows)
+    file(READ "${_row}" _line)
+    string(APPEND _csv "${_line}")
+    math(EXPR _count "${_count} + 1")
+
+    # Zero-based columns 1-3 (kind, size, probe), 8 (wall_s) and 12
+    # (instantiate_function_count); empty columns keep their place.
+    string(STRIP "${_line}" _line)
+    string(REPLACE "," ";" _fields "${_line}")
+    list(GET _fields 1 _kind)
+    list(GET _fields 2 _size)
+    list(GET _fields 3 _probe)
+    list(GET _fields 8 _wall)
+    list(GET _fields 12 _inst)
+    if(_inst STREQUAL "")
+        set(_inst "-")
+    endif()
+    set(_key "${_kind}_${_size}")
+    if(_probe STREQUAL "admission")
+        list(APPEND _admission_cases ${_key})
+        set(_new_${_key} "${_inst} functions, ${_wall} s")
+    elseif(_probe STREQUAL "admission_recursive")
+        set(_old_${_key} "${_inst} functions, ${_wall} s")
+    endif()
+endforeach()
+
+file(WRITE "${TL_BENCH_CSV}" "${_csv}")
+message(STATUS "[TypeLayout bench] ${_count} case(s) -> ${TL_BENCH_CSV}")
+
+foreach(_key IN LISTS _admission_cases)
+    if(DEFINED _old_${_key})
+        message(STATUS "[TypeLayout bench] ${_key} admission: "
+                       "${_new_${_key}} (recursive: ${_old_${_key}})")
+    endif()
+endforeach()
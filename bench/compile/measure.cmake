@@ -0,0 +1,157 @@
+# measure.cmake — compiler launcher for the compile-time benchmark cases
+#
+# Usage (set as CXX_COMPILER_LAUNCHER by bench/compile/CMakeLists.txt):
+#   cmake -DTL_BENCH_RESULT=<file> -DTL_BENCH_ROW=<csv prefix>
+#         -P measure.cmake -- <compiler> <args...>
+#
+# Runs the compile command once and writes a single CSV row to
+# TL_BENCH_RESULT:
+#   <row prefix>,status,wall_s,peak_rss_kb,
+#   frontend_ms,instantiate_function_ms,instantiate_function_count,
+#   constexpr_eval_ms
+#
+# Wall time and peak RSS come from GNU time when available (wall time
+# falls back to CMake timestamps -- whole seconds before CMake 3.23 --
+# and RSS is left empty).  The trace columns
+# are the "Total ..." entries of the Clang -ftime-trace JSON written next
+# to the object file; they are empty for compilers without -ftime-trace.
+# The compiler's exit status is propagated, so a case that exceeds
+# BOOST_TYPELAYOUT_CONSTEXPR_STEPS still fails the build -- but only after
+# its row has been recorded with status "fail".
+#
+# Copyright (c) 2024-2026 TypeLayout Development Team
+# Distributed under the Boost Software License, Version 1.0.
+
+cmake_minimum_required(VERSION 3.16)
+
+if(NOT TL_BENCH_RESULT OR NOT TL_BENCH_ROW)
+    message(FATAL_ERROR "measure.cmake: TL_BENCH_RESULT and TL_BENCH_ROW are required")
+endif()
+
+# ---- Collect the compile command (everything after "--") ----
+set(_cmd)
+set(_object)
+set(_seen_sep OFF)
+set(_next_is_object OFF)
+math(EXPR _last "${CMAKE_ARGC} - 1")
+foreach(_i RANGE ${_last})
+    set(_arg "${CMAKE_ARGV${_i}}")
+    if(_seen_sep)
+        list(APPEND _cmd "${_arg}")
+        if(_next_is_object)
+            set(_object "${_arg}")
+            set(_next_is_object OFF)
+        elseif(_arg STREQUAL "-o")
+            set(_next_is_object ON)
+        endif()
+    elseif(_arg STREQUAL "--")
+        set(_seen_sep ON)
+    endif()
+endforeach()
+
+if(NOT _cmd)
+    message(FATAL_ERROR "measure.cmake: no compile command after '--'")
+endif()
+
+# ---- Run it ----
+set(_time_file "${TL_BENCH_RESULT}.time")
+file(REMOVE "${_time_file}")
+
+execute_process(COMMAND /usr/bin/time --version
+                RESULT_VARIABLE _gnu_time_rc
+                OUTPUT_QUIET ERROR_QUIET)
+
+# Microsecond timestamps; %f needs CMake 3.23, older ones count seconds.
+if(CMAKE_VERSION VERSION_LESS 3.23)
+    set(_ts_format "%s000000")
+else()
+    set(_ts_format "%s%f")
+endif()
+
+string(TIMESTAMP _t0 "${_ts_format}")
+if(_gnu_time_rc EQUAL 0)
+    execute_process(COMMAND /usr/bin/time -f "%e %M" -o "${_time_file}" ${_cmd}
+                    RESULT_VARIABLE _rc)
+else()
+    execute_process(COMMAND ${_cmd} RESULT_VARIABLE _rc)
+endif()
+string(TIMESTAMP _t1 "${_ts_format}")
+
+set(_wall "")
+set(_rss "")
+if(EXISTS "${_time_file}")
+    file(STRINGS "${_time_file}" _time_lines REGEX "^[0-9.]+ [0-9]+$")
+    if(_time_lines)
+        list(GET _time_lines -1 _time_line)
+        string(REPLACE " " ";" _time_fields "${_time_line}")
+        list(GET _time_fields 0 _wall)
+        list(GET _time_fields 1 _rss)
+    endif()
+    file(REMOVE "${_time_file}")
+endif()
+if(_wall STREQUAL "")
+    # Microsecond timestamps -> seconds with millisecond precision.
+    math(EXPR _ms "(${_t1} - ${_t0}) / 1000")
+    math(EXPR _sec "${_ms} / 1000")
+    math(EXPR _frac "${_ms} % 1000")
+    string(LENGTH "${_frac}" _frac_len)
+    while(_frac_len LESS 3)
+        string(PREPEND _frac "0")
+        string(LENGTH "${_frac}" _frac_len)
+    endwhile()
+    set(_wall "${_sec}.${_frac}")
+endif()
+
+if(_rc EQUAL 0)
+    set(_status "ok")
+else()
+    set(_status "fail")
+endif()
+
+# ---- Clang -ftime-trace totals ----
+set(_frontend "")
+set(_inst_ms "")
+set(_inst_count "")
+set(_constexpr "")
+if(_object)
+    string(REGEX REPLACE "\\.[^./\\\\]*$" ".json" _trace "${_object}")
+    if(EXISTS "${_trace}")
+        file(READ "${_trace}" _json)
+        # Clang writes totals as
+        #   {...,"dur":<us>,"name":"Total <Event>","args":{"count":<n>,...}}
+        string(REGEX MATCHALL
+            "\"dur\":[0-9]+,\"name\":\"Total [A-Za-z]+\",\"args\":{\"count\":[0-9]+"
+            _totals "${_json}")
+        set(_constexpr_us 0)
+        set(_have_constexpr OFF)
+        foreach(_t IN LISTS _totals)
+            string(REGEX REPLACE
+                "^\"dur\":([0-9]+),\"name\":\"Total ([A-Za-z]+)\",\"args\":{\"count\":([0-9]+)$"
+                "\\1;\\2;\\3" _parts "${_t}")
+            list(GET _parts 0 _dur)
+            list(GET _parts 1 _name)
+            list(GET _parts 2 _count)
+            math(EXPR _dur_ms "${_dur} / 1000")
+            if(_name STREQUAL "Frontend")
+                set(_frontend "${_dur_ms}")
+            elseif(_name STREQUAL "InstantiateFunction")
+                set(_inst_ms "${_dur_ms}")
+                set(_inst_count "${_count}")
+            elseif(_name MATCHES "^Evaluate")
+                math(EXPR _constexpr_us "${_constexpr_us} + ${_dur}")
+                set(_have_constexpr ON)
+            endif()
+        endforeach()
+        if(_have_constexpr)
+            math(EXPR _constexpr "${_constexpr_us} / 1000")
+        endif()
+    endif()
+endif()
+
+file(WRITE "${TL_BENCH_RESULT}"
+    "${TL_BENCH_ROW},${_status},${_wall},${_rss},"
+    "${_frontend},${_inst_ms},${_inst_count},${_constexpr}\n")
+
+if(NOT _rc EQUAL 0)
+    message(FATAL_ERROR "[TypeLayout bench] compile failed (${_rc}): ${TL_BENCH_ROW}")
+endif()
@@ -0,0 +1,286 @@
+// Runtime benchmark: CompatReporter scaling in types x platforms.
+//
+// Builds synthetic platform tables -- T distinct types exported on P
+// platforms (default P = 30, T up to 100000) -- and times the three
+// phases a CI job pays for:
+//
+//   index    -- add_platform() for every platform (builds the name index)
+//   compare  -- all_types_transfer_safe() (name union + per-type lookup,
+//               hash comparison and classification)
+//   report   -- print_diff_report() into a discarding stream
+//   par      -- compare and report again with set_threads(threads)
+//   warm     -- compare + report with a result cache saved by a previous
+//               run (set_cache_file); only changed types are re-diffed
+//
+// A final diff-heavy run (every type differs on one of 3 platforms, as when
+// a new target is added) times a cold vs a warm cache, where DIFFER
+// rendering dominates.
+//
+// Every platform lists the types in its own order, and one type in 1000
+// differs on one platform, so lookups are real and the report has DIFFER
+// sections.  Time per (type, platform) cell should stay flat as T grows.
+// The serial, parallel and cached diff reports must be byte-identical.
+//
+// Usage: bench_compat_scale [max_types] [platforms] [threads]
+//        (threads: 0 = one per hardware thread, the default)
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/tools/compat_check.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace tl = boost::typelayout;
+namespace tlc = boost::typelayout::compat;
+
+namespace {
+
+struct Rng {
+    std::uint64_t s;
+    std::uint32_t next() {
+        s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+        return static_cast<std::uint32_t>(s);
+    }
+    std::uint32_t below(std::uint32_t n) { return next() % n; }
+};
+
+const char* const scalars[] = {
+    "u8[s:1,a:1]", "u16[s:2,a:2]", "u32[s:4,a:4]", "u64[s:8,a:8]",
+    "i32[s:4,a:4]", "i64[s:8,a:8]", "f32[s:4,a:4]", "f64[s:8,a:8]",
+};
+const std::uint32_t scalar_size[] = {1, 2, 4, 8, 4, 8, 4, 8};
+
+std::string gen_signature(Rng& rng, bool variant, std::uint32_t min_fields) {
+    std::string body;
+    std::uint32_t off = 0;
+    std::uint32_t fields = min_fields + rng.below(12);
+    for (std::uint32_t i = 0; i < fields; ++i) {
+        std::uint32_t k = rng.below(8);
+        off = (off + scalar_size[k] - 1) / scalar_size[k] * scalar_size[k];
+        if (i) body += ',';
+        body += "@" + std::to_string(off) + ":" + scalars[k];
+        off += scalar_size[k];
+    }
+    if (variant) {                            // e.g. `long` on an LLP64 target
+        off = (off + 7) / 8 * 8;
+        body += ",@" + std::to_string(off) + ":i64[s:8,a:8]";
+        off += 8;
+    }
+    off = (off + 7) / 8 * 8;
+    return "[64-le]record[s:" + std::to_string(off) + ",a:8]{" + body + "}";
+}
+
+struct Dataset {
+    std::vector<std::string> names;
+    std::vector<std::string> sigs;       // per type
+    std::vector<std::string> variants;   // per type, used on one platform
+    std::vector<std::string> platform_names;
+    std::vector<std::vector<tl::TypeEntry>> tables;
+};
+
+// Type i differs on the last platform when i % differ_every == 7 % differ_every.
+Dataset make_dataset(std::size_t types, std::size_t platforms,
+                     std::size_t differ_every = 1000, std::uint32_t min_fields = 2) {
+    Rng rng{0x853c49e6748fea9bull ^ types};
+    Dataset d;
+    d.names.reserve(types);
+    d.sigs.reserve(types);
+    d.variants.reserve(types);
+    for (std::size_t i = 0; i < types; ++i) {
+        d.names.push_back("ns::Message" + std::to_string(i));
+        Rng copy = rng;
+        d.sigs.push_back(gen_signature(rng, false, min_fields));
+        d.variants.push_back(gen_signature(copy, true, min_fields));
+    }
+    d.tables.resize(platforms);
+    for (std::size_t p = 0; p < platforms; ++p) {
+        d.platform_names.push_back("platform_" + std::to_string(p));
+        auto& table = d.tables[p];
+        table.reserve(types);
+        for (std::size_t i = 0; i < types; ++i) {
+            bool variant = i % differ_every == 7 % differ_every && p == platforms - 1;
+            const std::string& sig = variant ? d.variants[i] : d.sigs[i];
+            table.push_back({d.names[i].c_str(), sig.c_str(), !variant,
+                             tl::layout_hash(sig)});
+        }
+        // Per-platform order, as independent exports would produce.
+        for (std::size_t i = table.size(); i > 1; --i)
+            std::swap(table[i - 1], table[rng.below(static_cast<std::uint32_t>(i))]);
+    }
+    return d;
+}
+
+struct NullBuf : std::streambuf {
+    int_type overflow(int_type c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+template <typename F>
+double time_ms(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// One CI-style run against the cache at `path`: diff report + verdict,
+// then save.  Returns the time of the report and verdict.
+double run_cached(const Dataset& d, const std::string& path, std::string& report,
+                  std::size_t& hits) {
+    tlc::CompatReporter reporter;
+    reporter.set_cache_file(path);
+    for (std::size_t p = 0; p < d.tables.size(); ++p)
+        reporter.add_platform(d.platform_names[p], d.tables[p].data(),
+                              d.tables[p].size());
+    std::ostringstream out;
+    double ms = time_ms([&] {
+        reporter.print_diff_report(out);
+        (void)reporter.all_types_transfer_safe();
+    });
+    hits = reporter.cache_hits();
+    reporter.save_cache();
+    report = std::move(out).str();
+    return ms;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t max_types = argc >= 2 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    std::size_t platforms = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 30;
+    unsigned threads = argc >= 4
+        ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : 0;
+    if (max_types == 0 || platforms < 2) {
+        std::fprintf(stderr, "bench_compat_scale: need max_types >= 1, platforms >= 2\n");
+        return 2;
+    }
+
+    std::vector<std::size_t> sizes;
+    for (std::size_t t : {1000u, 3000u, 10000u, 30000u, 100000u})
+        if (t < max_types) sizes.push_back(t);
+    sizes.push_back(max_types);
+
+    std::printf("bench_compat_scale: %zu platforms, %u thread(s) in par mode\n",
+                platforms, tlc::detail::resolve_threads(threads));
+    std::printf("  %8s %10s %10s %10s %12s %10s %10s %10s\n", "types", "index ms",
+                "compare ms", "report ms", "ns/cell", "par cmp", "par rep", "warm");
+    const std::string cache_path =
+        (std::filesystem::temp_directory_path() / "bench_compat_scale.cache").string();
+
+    NullBuf null_buf;
+    std::ostream null_os(&null_buf);
+    std::size_t failures = 0;
+    const int runs = 3;
+    for (std::size_t types : sizes) {
+        Dataset d = make_dataset(types, platforms);
+        double index_ms = 1e300, compare_ms = 1e300, report_ms = 1e300;
+        double par_compare_ms = 1e300, par_report_ms = 1e300, warm_ms = 1e300;
+        bool all_safe = true, par_all_safe = true, subset_safe = false;
+        for (int run = 0; run < runs; ++run) {
+            tlc::CompatReporter reporter;
+            index_ms = std::min(index_ms, time_ms([&] {
+                for (std::size_t p = 0; p < platforms; ++p)
+                    reporter.add_platform(d.platform_names[p], d.tables[p].data(),
+                                          d.tables[p].size());
+            }));
+            compare_ms = std::min(compare_ms, time_ms([&] {
+                all_safe = reporter.all_types_transfer_safe();
+            }));
+            report_ms = std::min(report_ms, time_ms([&] {
+                reporter.print_diff_report(null_os);
+            }));
+            subset_safe = reporter.are_transfer_safe(
+                {d.names[0]}, {d.platform_names[0], d.platform_names[platforms - 1]});
+
+            reporter.set_threads(threads);
+            par_compare_ms = std::min(par_compare_ms, time_ms([&] {
+                par_all_safe = reporter.all_types_transfer_safe();
+            }));
+            par_report_ms = std::min(par_report_ms, time_ms([&] {
+                reporter.print_diff_report(null_os);
+            }));
+        }
+
+        std::filesystem::remove(cache_path);
+        std::string cold_report, warm_report;
+        std::size_t hits = 0;
+        run_cached(d, cache_path, cold_report, hits);
+        for (int run = 0; run < runs; ++run)
+            warm_ms = std::min(warm_ms, run_cached(d, cache_path, warm_report, hits));
+        std::filesystem::remove(cache_path);
+
+        double cells = static_cast<double>(types) * static_cast<double>(platforms);
+        std::printf("  %8zu %10.2f %10.2f %10.2f %12.1f %10.2f %10.2f %10.2f\n", types,
+                    index_ms, compare_ms, report_ms,
+                    (index_ms + compare_ms) * 1e6 / cells,
+                    par_compare_ms, par_report_ms, warm_ms);
+
+        tlc::CompatReporter serial, parallel;
+        parallel.set_threads(threads);
+        for (std::size_t p = 0; p < platforms; ++p) {
+            serial.add_platform(d.platform_names[p], d.tables[p].data(), d.tables[p].size());
+            parallel.add_platform(d.platform_names[p], d.tables[p].data(), d.tables[p].size());
+        }
+        std::ostringstream serial_out, parallel_out;
+        serial.print_diff_report(serial_out);
+        parallel.print_diff_report(parallel_out);
+        if (serial_out.str() != parallel_out.str()) {
+            std::fprintf(stderr, "bench_compat_scale: parallel report differs at %zu types\n",
+                         types);
+            ++failures;
+        }
+        if (cold_report != serial_out.str() || warm_report != serial_out.str() ||
+            hits != types) {
+            std::fprintf(stderr, "bench_compat_scale: cached report differs at %zu types\n",
+                         types);
+            ++failures;
+        }
+
+        // Types 7, 1007, ... differ on the last platform.
+        bool expect_all = types <= 7;
+        if (all_safe != expect_all || par_all_safe != expect_all || !subset_safe) {
+            std::fprintf(stderr, "bench_compat_scale: wrong verdict at %zu types\n", types);
+            ++failures;
+        }
+    }
+
+    {
+        const std::size_t types = std::min<std::size_t>(max_types, 2000);
+        Dataset d = make_dataset(types, 3, 1, 48);
+        tlc::CompatReporter plain;
+        for (std::size_t p = 0; p < 3; ++p)
+            plain.add_platform(d.platform_names[p], d.tables[p].data(), d.tables[p].size());
+        std::ostringstream expected;
+        plain.print_diff_report(expected);
+
+        std::filesystem::remove(cache_path);
+        std::string cold_report, warm_report;
+        std::size_t cold_hits = 0, warm_hits = 0;
+        double cold_ms = run_cached(d, cache_path, cold_report, cold_hits);
+        double warm_ms = 1e300;
+        for (int run = 0; run < runs; ++run)
+            warm_ms = std::min(warm_ms, run_cached(d, cache_path, warm_report, warm_hits));
+        std::filesystem::remove(cache_path);
+
+        std::printf("diff-heavy, %zu types x 3 platforms, all DIFFER:\n", types);
+        std::printf("  cold cache %9.2f ms\n  warm cache %9.2f ms  (%zu of %zu replayed)\n",
+                    cold_ms, warm_ms, warm_hits, types);
+        if (cold_report != expected.str() || warm_report != expected.str() ||
+            cold_hits != 0 || warm_hits != types) {
+            std::fprintf(stderr, "bench_compat_scale: cached diff-heavy report differs\n");
+            ++failures;
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,212 @@
+// Runtime benchmark: spsc_ring / mpsc_ring between local processes.
+//
+// A forked producer process (two for mpsc) pushes M SensorRecord-sized
+// records through a ring in shared memory to the parent, which checks the
+// sequence of every record it pops:
+//
+//   throughput -- records/s and MB/s, one record per call and in batches
+//                 (try_push_n / try_pop_n of `batch` records)
+//   latency    -- ping-pong over two spsc rings; one-way latency is half
+//                 the round trip (median, p99)
+//
+// Both sides spin on an empty (full) ring and yield after a while, so the
+// numbers are meaningful only with a core per process.
+//
+// Usage: bench_ipc_ring [messages] [batch]
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/ipc/ring.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ipc = boost::typelayout::ipc;
+
+namespace {
+
+struct SensorRecord {
+    std::uint64_t timestamp_ns;   // sequence number within its producer
+    float         temperature;
+    float         humidity;
+    float         pressure;
+    std::uint32_t sensor_id;      // producer index
+};
+
+using clock_type = std::chrono::steady_clock;
+
+/// Spin, then yield: a blocked side must not starve its peer on a busy box.
+struct Backoff {
+    unsigned spins = 0;
+    void operator()() {
+        if (++spins >= 256) {
+            spins = 0;
+            std::this_thread::yield();
+        }
+    }
+};
+
+template <typename Ring>
+void produce(Ring& ring, std::uint32_t id, std::uint64_t count, std::size_t batch) {
+    std::vector<SensorRecord> buf(batch);
+    Backoff backoff;
+    for (std::uint64_t seq = 0; seq < count;) {
+        const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(batch, count - seq));
+        for (std::size_t i = 0; i < n; ++i)
+            buf[i] = {seq + i, 20.0f, 0.5f, 1013.0f, id};
+        std::size_t sent = 0;
+        while (sent < n) {
+            const std::size_t k = ring.try_push_n(buf.data() + sent, n - sent);
+            if (k == 0) backoff();
+            sent += k;
+        }
+        seq += n;
+    }
+}
+
+struct RunResult {
+    double seconds = 0;
+    bool   ok = true;
+};
+
+/// Fork `producers` processes pushing `count` records each into a fresh
+/// ring, pop everything in the parent.
+template <typename Ring>
+RunResult run_throughput(unsigned producers, std::uint64_t count, std::size_t batch) {
+    RunResult result;
+    Ring ring;
+    std::string error;
+    if (!ring.create_anonymous(1u << 14, &error)) {
+        std::fprintf(stderr, "bench_ipc_ring: %s\n", error.c_str());
+        result.ok = false;
+        return result;
+    }
+
+    const auto t0 = clock_type::now();
+    std::vector<pid_t> children;
+    for (unsigned p = 0; p < producers; ++p) {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            Ring peer;
+            if (!peer.attach_fd(ring.fd(), &error)) ::_exit(2);
+            produce(peer, p, count, batch);
+            ::_exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    std::vector<SensorRecord> buf(batch);
+    std::vector<std::uint64_t> next(producers, 0);
+    Backoff backoff;
+    for (std::uint64_t total = 0; total < count * producers;) {
+        const std::size_t k = ring.try_pop_n(buf.data(), batch);
+        if (k == 0) backoff();
+        for (std::size_t i = 0; i < k; ++i) {
+            const SensorRecord& r = buf[i];
+            if (r.sensor_id >= producers || r.timestamp_ns != next[r.sensor_id]++)
+                result.ok = false;
+        }
+        total += k;
+    }
+    result.seconds = std::chrono::duration<double>(clock_type::now() - t0).count();
+
+    for (pid_t pid : children) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) result.ok = false;
+    }
+    return result;
+}
+
+/// Round trips of one record through a pair of spsc rings, in ns.
+std::vector<double> run_latency(std::uint64_t rounds) {
+    ipc::spsc_ring<SensorRecord> ping, pong;
+    std::string error;
+    if (!ping.create_anonymous(64, &error) || !pong.create_anonymous(64, &error)) {
+        std::fprintf(stderr, "bench_ipc_ring: %s\n", error.c_str());
+        return {};
+    }
+    pid_t pid = ::fork();
+    if (pid == 0) {
+        ipc::spsc_ring<SensorRecord> in, out;
+        if (!in.attach_fd(ping.fd()) || !out.attach_fd(pong.fd())) ::_exit(2);
+        SensorRecord r;
+        Backoff backoff;
+        for (std::uint64_t i = 0; i < rounds; ++i) {
+            while (!in.try_pop(r)) backoff();
+            while (!out.try_push(r)) backoff();
+        }
+        ::_exit(0);
+    }
+
+    std::vector<double> rtt;
+    rtt.reserve(rounds);
+    SensorRecord r{};
+    Backoff backoff;
+    for (std::uint64_t i = 0; i < rounds; ++i) {
+        r.timestamp_ns = i;
+        const auto t0 = clock_type::now();
+        while (!ping.try_push(r)) backoff();
+        while (!pong.try_pop(r)) backoff();
+        rtt.push_back(std::chrono::duration<double, std::nano>(clock_type::now() - t0).count());
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    std::sort(rtt.begin(), rtt.end());
+    return rtt;
+}
+
+void print_row(const char* ring, unsigned producers, std::size_t batch,
+               std::uint64_t records, const RunResult& r) {
+    const double rate = static_cast<double>(records) / r.seconds;
+    std::printf("  %-5s %9u %7zu %12.2f %10.1f %10.1f%s\n", ring, producers, batch,
+                rate / 1e6, rate * sizeof(SensorRecord) / 1e6,
+                r.seconds * 1e9 / static_cast<double>(records), r.ok ? "" : "  WRONG");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::uint64_t messages = argc >= 2 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t batch = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 64;
+    if (messages == 0 || batch == 0) {
+        std::fprintf(stderr, "bench_ipc_ring: need messages >= 1, batch >= 1\n");
+        return 2;
+    }
+
+    std::printf("bench_ipc_ring: %llu records of %zu bytes, %u hardware thread(s)\n",
+                static_cast<unsigned long long>(messages), sizeof(SensorRecord),
+                std::thread::hardware_concurrency());
+    std::printf("  %-5s %9s %7s %12s %10s %10s\n", "ring", "producers", "batch",
+                "Mrecords/s", "MB/s", "ns/record");
+
+    int failures = 0;
+    for (std::size_t b : {std::size_t{1}, batch}) {
+        RunResult r = run_throughput<ipc::spsc_ring<SensorRecord>>(1, messages, b);
+        print_row("spsc", 1, b, messages, r);
+        failures += !r.ok;
+    }
+    for (std::size_t b : {std::size_t{1}, batch}) {
+        RunResult r = run_throughput<ipc::mpsc_ring<SensorRecord>>(2, messages / 2, b);
+        print_row("mpsc", 2, b, messages / 2 * 2, r);
+        failures += !r.ok;
+    }
+
+    const std::uint64_t rounds = std::min<std::uint64_t>(messages / 10 + 1, 1000000);
+    std::vector<double> rtt = run_latency(rounds);
+    if (rtt.empty()) return 1;
+    std::printf("latency, %llu round trips: one-way median %.0f ns, p99 %.0f ns\n",
+                static_cast<unsigned long long>(rounds), rtt[rtt.size() / 2] / 2,
+                rtt[rtt.size() * 99 / 100] / 2);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,157 @@
+// Runtime benchmark: reading a record log through mapped_record_file
+// against reading it record by record from a stream.
+//
+// Writes M SensorRecords with mapped_record_file::append (in batches),
+// then reads the log back three ways, each folding every record into a
+// checksum that must agree:
+//
+//   stream  -- std::ifstream::read() of one record at a time into a T,
+//              the per-record parse this header replaces
+//   open    -- mapped_record_file::open() alone: the O(1) layout check
+//   mapped  -- open() plus a walk over records(), in place
+//
+// The file is read while hot in the page cache, so the numbers compare
+// CPU cost, not the disk.
+//
+// Usage: bench_record_file [records]
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/ipc/mapped_record_file.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace ipc = boost::typelayout::ipc;
+
+namespace {
+
+struct SensorRecord {
+    std::uint64_t timestamp_ns;
+    float         temperature;
+    float         humidity;
+    float         pressure;
+    std::uint32_t sensor_id;
+};
+
+using clock_type = std::chrono::steady_clock;
+
+double seconds_since(clock_type::time_point t0) {
+    return std::chrono::duration<double>(clock_type::now() - t0).count();
+}
+
+std::uint64_t fold(std::uint64_t sum, const SensorRecord& r) {
+    return sum + r.timestamp_ns + r.sensor_id;
+}
+
+struct Result {
+    double        seconds = 1e300;
+    std::uint64_t checksum = 0;
+};
+
+Result read_stream(const std::string& path) {
+    Result r;
+    const auto t0 = clock_type::now();
+    std::ifstream in(path, std::ios::binary);
+    in.seekg(64);   // the segment header of a SensorRecord file
+    SensorRecord record;
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record)))
+        r.checksum = fold(r.checksum, record);
+    r.seconds = seconds_since(t0);
+    return r;
+}
+
+Result read_mapped(const std::string& path, bool walk) {
+    Result r;
+    const auto t0 = clock_type::now();
+    ipc::mapped_record_file<SensorRecord> log;
+    std::string error;
+    if (!log.open(path, &error)) {
+        std::fprintf(stderr, "bench_record_file: %s\n", error.c_str());
+        std::exit(1);
+    }
+    if (walk) {
+        log.advise(ipc::access_hint::sequential);
+        for (const SensorRecord& record : log.records()) r.checksum = fold(r.checksum, record);
+    } else {
+        r.checksum = log.size();
+    }
+    r.seconds = seconds_since(t0);
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t records = argc >= 2 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+    if (records == 0) {
+        std::fprintf(stderr, "bench_record_file: need records >= 1\n");
+        return 2;
+    }
+    const std::string path = "bench_record_file." + std::to_string(::getpid()) + ".tlr";
+
+    std::string error;
+    const auto t0 = clock_type::now();
+    {
+        ipc::mapped_record_file<SensorRecord> log;
+        if (!log.create(path, &error)) {
+            std::fprintf(stderr, "bench_record_file: %s\n", error.c_str());
+            return 1;
+        }
+        std::vector<SensorRecord> batch(4096);
+        for (std::size_t i = 0; i < records;) {
+            const std::size_t n = std::min(batch.size(), records - i);
+            for (std::size_t k = 0; k < n; ++k, ++i)
+                batch[k] = {i, 20.0f, 0.5f, 1013.0f, static_cast<std::uint32_t>(i % 16)};
+            if (!log.append(std::span<const SensorRecord>(batch.data(), n), &error)) {
+                std::fprintf(stderr, "bench_record_file: %s\n", error.c_str());
+                std::remove(path.c_str());
+                return 1;
+            }
+        }
+    }
+    const double write_s = seconds_since(t0);
+
+    constexpr int runs = 3;
+    Result stream, open, mapped;
+    for (int run = 0; run < runs; ++run) {
+        Result a = read_stream(path);
+        Result b = read_mapped(path, false);
+        Result c = read_mapped(path, true);
+        if (a.seconds < stream.seconds) stream = a;
+        if (b.seconds < open.seconds) open = b;
+        if (c.seconds < mapped.seconds) mapped = c;
+    }
+    std::remove(path.c_str());
+
+    const double n = static_cast<double>(records);
+    const double mb = n * sizeof(SensorRecord) / 1e6;
+    std::printf("bench_record_file: %zu records of %zu bytes (%.0f MB), best of %d\n",
+                records, sizeof(SensorRecord), mb, runs);
+    std::printf("  write (append, batches of 4096): %.1f MB/s\n", mb / write_s);
+    std::printf("  %-7s %12s %10s %10s\n", "read", "Mrecords/s", "MB/s", "ns/record");
+    auto row = [&](const char* name, const Result& r) {
+        std::printf("  %-7s %12.2f %10.1f %10.2f\n", name, n / r.seconds / 1e6,
+                    mb / r.seconds, r.seconds * 1e9 / n);
+    };
+    row("stream", stream);
+    row("mapped", mapped);
+    std::printf("  open alone: %.1f us; speedup %.1fx\n", open.seconds * 1e6,
+                stream.seconds / mapped.seconds);
+
+    if (stream.checksum != mapped.checksum || open.checksum != records) {
+        std::fprintf(stderr, "bench_record_file: readers disagree\n");
+        return 1;
+    }
+    return 0;
+}
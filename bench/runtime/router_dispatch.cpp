@@ -0,0 +1,259 @@
+// Runtime benchmark: message_router against string-keyed dispatch.
+//
+// Generates a stream of M frames over 7 message types (plus 1% frames of
+// an unknown type) and dispatches every frame twice:
+//
+//   string  -- the frame carries the type name; std::unordered_map<
+//              std::string, std::function> finds the handler, which
+//              copies the payload into a T
+//   router  -- the frame carries get_layout_hash<T>(); message_router
+//              finds the slot by perfect hash and calls handler(const T&)
+//              on the payload in place
+//
+// Both handlers fold the same field of every record into a checksum,
+// which must agree.  Reports messages per second for each and whether
+// the router sustains `target` messages per second (default 10M).
+//
+// Usage: bench_router_dispatch [messages] [target_msgs_per_s]
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/ipc/router.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tl = boost::typelayout;
+namespace ipc = boost::typelayout::ipc;
+
+namespace {
+
+struct PacketHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t type;
+    std::uint32_t payload_len;
+    std::uint32_t checksum;
+};
+
+struct SharedMemRegion {
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint32_t flags;
+    std::uint32_t owner_pid;
+};
+
+struct FileHeader {
+    char          magic[4];
+    std::uint32_t version;
+    std::uint64_t timestamp;
+    std::uint32_t entry_count;
+    std::uint32_t reserved;
+};
+
+struct SensorRecord {
+    std::uint64_t timestamp_ns;
+    float         temperature;
+    float         humidity;
+    float         pressure;
+    std::uint32_t sensor_id;
+};
+
+struct IpcCommand {
+    std::uint32_t cmd_id;
+    std::uint32_t flags;
+    std::int64_t  arg1;
+    std::int64_t  arg2;
+    char          payload[64];
+};
+
+struct Heartbeat {
+    std::uint64_t sent_ns;
+};
+
+struct Ack {
+    std::uint32_t id;
+    std::uint32_t status;
+};
+
+using Router = ipc::message_router<PacketHeader, SharedMemRegion, FileHeader,
+                                   SensorRecord, IpcCommand, Heartbeat, Ack>;
+
+// Frame: 8-byte tag (layout hash, or index of the name), 8-byte size,
+// payload padded to 8 bytes.  Both dispatchers read the same stream.
+struct FrameHead {
+    std::uint64_t tag;
+    std::uint64_t size;
+};
+
+const char* const names[] = {"PacketHeader", "SharedMemRegion", "FileHeader",
+                             "SensorRecord", "IpcCommand", "Heartbeat", "Ack",
+                             "Unknown"};
+
+struct Stream {
+    std::vector<std::uint64_t> words;   // 8-byte aligned frames
+    std::size_t                frames = 0;
+};
+
+template <typename T>
+void append(Stream& s, std::uint64_t tag, std::uint64_t value) {
+    T record{};
+    std::memcpy(&record, &value, sizeof(value) < sizeof(T) ? sizeof(value) : sizeof(T));
+    const std::size_t at = s.words.size();
+    s.words.resize(at + 2 + (sizeof(T) + 7) / 8);
+    FrameHead head{tag, sizeof(T)};
+    std::memcpy(s.words.data() + at, &head, sizeof(head));
+    std::memcpy(s.words.data() + at + 2, &record, sizeof(T));
+    ++s.frames;
+}
+
+/// The same random frame sequence, tagged by layout hash (`by_hash`) or by
+/// name index.
+Stream make_stream(std::size_t count, bool by_hash) {
+    Stream s;
+    s.words.reserve(count * 6);
+    std::uint64_t x = 0x2545f4914f6cdd1dull;
+    for (std::size_t i = 0; i < count; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        const std::uint64_t value = x >> 8;
+        const unsigned pick = static_cast<unsigned>(x % 100);
+        auto tag = [&](std::size_t type, std::uint64_t hash) {
+            return by_hash ? hash : type;
+        };
+        if (pick == 0)
+            append<Heartbeat>(s, tag(7, 0x0123456789abcdefull), value);   // unknown
+        else if (pick < 40)
+            append<SensorRecord>(s, tag(3, tl::get_layout_hash<SensorRecord>()), value);
+        else if (pick < 60)
+            append<PacketHeader>(s, tag(0, tl::get_layout_hash<PacketHeader>()), value);
+        else if (pick < 70)
+            append<SharedMemRegion>(s, tag(1, tl::get_layout_hash<SharedMemRegion>()), value);
+        else if (pick < 75)
+            append<FileHeader>(s, tag(2, tl::get_layout_hash<FileHeader>()), value);
+        else if (pick < 85)
+            append<IpcCommand>(s, tag(4, tl::get_layout_hash<IpcCommand>()), value);
+        else if (pick < 95)
+            append<Heartbeat>(s, tag(5, tl::get_layout_hash<Heartbeat>()), value);
+        else
+            append<Ack>(s, tag(6, tl::get_layout_hash<Ack>()), value);
+    }
+    return s;
+}
+
+// The field each handler folds into the checksum.
+std::uint64_t key(const PacketHeader& r)    { return r.magic; }
+std::uint64_t key(const SharedMemRegion& r) { return r.offset; }
+std::uint64_t key(const FileHeader& r)      { std::uint32_t m; std::memcpy(&m, r.magic, 4); return m; }
+std::uint64_t key(const SensorRecord& r)    { return r.timestamp_ns; }
+std::uint64_t key(const IpcCommand& r)      { return r.cmd_id; }
+std::uint64_t key(const Heartbeat& r)       { return r.sent_ns; }
+std::uint64_t key(const Ack& r)             { return r.id; }
+
+struct Result {
+    double        seconds;
+    std::uint64_t checksum;
+    std::uint64_t unknown;
+};
+
+template <typename Visit>
+double walk(const Stream& s, Visit&& visit) {
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::uint64_t* p = s.words.data();
+    for (std::size_t i = 0; i < s.frames; ++i) {
+        FrameHead head;
+        std::memcpy(&head, p, sizeof(head));
+        visit(head, p + 2);
+        p += 2 + (head.size + 7) / 8;
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+Result run_string(const Stream& s) {
+    Result r{0, 0, 0};
+    std::unordered_map<std::string, std::function<void(const void*, std::size_t)>> map;
+    auto add = [&]<typename T>(const char* name) {
+        map.emplace(name, [&r](const void* data, std::size_t size) {
+            if (size != sizeof(T)) return;
+            T record;
+            std::memcpy(&record, data, sizeof(T));
+            r.checksum += key(record);
+        });
+    };
+    add.operator()<PacketHeader>(names[0]);
+    add.operator()<SharedMemRegion>(names[1]);
+    add.operator()<FileHeader>(names[2]);
+    add.operator()<SensorRecord>(names[3]);
+    add.operator()<IpcCommand>(names[4]);
+    add.operator()<Heartbeat>(names[5]);
+    add.operator()<Ack>(names[6]);
+
+    r.seconds = walk(s, [&](const FrameHead& head, const void* payload) {
+        auto it = map.find(std::string(names[head.tag]));
+        if (it == map.end()) ++r.unknown;
+        else it->second(payload, head.size);
+    });
+    return r;
+}
+
+struct RouterHandler {
+    Result& r;
+    template <typename T>
+    void operator()(const T& record) const { r.checksum += key(record); }
+    void operator()(const ipc::unrouted_message&) const { ++r.unknown; }
+};
+
+Result run_router(const Stream& s) {
+    Result r{0, 0, 0};
+    RouterHandler handler{r};
+    r.seconds = walk(s, [&](const FrameHead& head, const void* payload) {
+        Router::dispatch(head.tag, payload, head.size, handler);
+    });
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t messages = argc >= 2 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    double target = argc >= 3 ? std::strtod(argv[2], nullptr) : 10e6;
+    if (messages == 0) {
+        std::fprintf(stderr, "bench_router_dispatch: need messages >= 1\n");
+        return 2;
+    }
+
+    const Stream by_name = make_stream(messages, false);
+    const Stream by_hash = make_stream(messages, true);
+
+    constexpr int runs = 3;
+    Result str{1e300, 0, 0}, rtr{1e300, 0, 0};
+    for (int run = 0; run < runs; ++run) {
+        Result a = run_string(by_name);
+        Result b = run_router(by_hash);
+        if (a.seconds < str.seconds) str = a;
+        if (b.seconds < rtr.seconds) rtr = b;
+    }
+
+    const double n = static_cast<double>(messages);
+    std::printf("bench_router_dispatch: %zu frames, 7 types + 1%% unknown, best of %d\n",
+                messages, runs);
+    std::printf("  %-8s %12s %10s\n", "dispatch", "Mmsgs/s", "ns/msg");
+    std::printf("  %-8s %12.2f %10.2f\n", "string", n / str.seconds / 1e6, str.seconds * 1e9 / n);
+    std::printf("  %-8s %12.2f %10.2f\n", "router", n / rtr.seconds / 1e6, rtr.seconds * 1e9 / n);
+    std::printf("  speedup %.1fx; router %s %.0fM msgs/s\n", str.seconds / rtr.seconds,
+                n / rtr.seconds >= target ? "sustains" : "misses", target / 1e6);
+
+    if (str.checksum != rtr.checksum || str.unknown != rtr.unknown) {
+        std::fprintf(stderr, "bench_router_dispatch: dispatchers disagree\n");
+        return 1;
+    }
+    return 0;
+}
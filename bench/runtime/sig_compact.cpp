@@ -0,0 +1,196 @@
+// Runtime benchmark: compact signature form vs the full form.
+//
+// Generates N repetitive, market-data-shaped layout signatures (default
+// 20000) from a fixed seed -- order books of flattened price levels,
+// long runs of identical counters, arrays of the same element record --
+// and measures:
+//
+//   size      -- bytes of full vs compact signatures (what a .sig.hpp holds)
+//   compact   -- compact_signature() over every full signature
+//   expand    -- expand_signature() over every compact signature
+//   compare   -- equality of each signature with an equal copy, full vs
+//                compact (the comparison layout_match performs)
+//
+// Every compact signature must expand back to its full form byte for
+// byte; a mismatch fails the run.
+//
+// Usage: bench_sig_compact [count]
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/detail/sig_compact.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tl = boost::typelayout;
+
+namespace {
+
+// ---- Signature generator ---------------------------------------------------
+
+struct Rng {
+    std::uint64_t s;
+    std::uint32_t next() {
+        s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+        return static_cast<std::uint32_t>(s);
+    }
+    std::uint32_t below(std::uint32_t n) { return next() % n; }
+};
+
+struct Builder {
+    std::string body;
+    std::uint64_t off = 0;
+
+    void field(std::uint64_t size, const char* sig) {
+        if (!body.empty()) body += ',';
+        body += "@" + std::to_string(off) + ":" + sig;
+        off += size;
+    }
+    void raw(std::uint64_t size, const std::string& sig) {
+        if (!body.empty()) body += ',';
+        body += "@" + std::to_string(off) + ":" + sig;
+        off += size;
+    }
+    std::string record() const {
+        return "record[s:" + std::to_string(off) + ",a:8]{" + body + "}";
+    }
+};
+
+// Flattened struct Level { double px; uint32_t qty; uint32_t orders; }.
+void add_level(Builder& b) {
+    b.field(8, "f64[s:8,a:8]");
+    b.field(4, "u32[s:4,a:4]");
+    b.field(4, "u32[s:4,a:4]");
+}
+
+const char* const vec3 =
+    "record[s:12,a:4]{@0:f32[s:4,a:4],@4:f32[s:4,a:4],@8:f32[s:4,a:4]}";
+
+std::string gen_signature(Rng& rng) {
+    Builder b;
+    b.field(8, "u64[s:8,a:8]");                          // sequence number
+    b.field(8, "i64[s:8,a:8]");                          // timestamp
+    switch (rng.below(3)) {
+        case 0: {                                        // order book
+            std::uint32_t depth = 5 + rng.below(46);
+            for (std::uint32_t side = 0; side < 2; ++side)
+                for (std::uint32_t i = 0; i < depth; ++i) add_level(b);
+            break;
+        }
+        case 1: {                                        // counter block
+            std::uint32_t n = 16 + rng.below(241);
+            for (std::uint32_t i = 0; i < n; ++i) b.field(4, "u32[s:4,a:4]");
+            break;
+        }
+        default: {                                       // sampled geometry
+            std::uint32_t arrays = 1 + rng.below(4);
+            for (std::uint32_t i = 0; i < arrays; ++i) {
+                std::uint32_t n = 1 + rng.below(64);
+                b.raw(12 * n, "array[s:" + std::to_string(12 * n) + ",a:4]<" +
+                                  vec3 + "," + std::to_string(n) + ">");
+            }
+            break;
+        }
+    }
+    std::uint32_t tail = rng.below(4);
+    for (std::uint32_t i = 0; i < tail; ++i) b.field(1, "u8[s:1,a:1]");
+    return "[64-le]" + b.record();
+}
+
+// ---- Timing ----------------------------------------------------------------
+
+template <typename F>
+double time_ms(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+void report(const char* name, double ms, std::size_t count) {
+    std::printf("  %-8s %9.2f ms  %8.1f ns/sig\n", name, ms,
+                ms * 1e6 / static_cast<double>(count));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc >= 2 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    Rng rng{0x2545f4914f6cdd1dull};
+    std::vector<std::string> full(count), compact(count), expanded(count);
+    for (auto& s : full) s = gen_signature(rng);
+    // Equal copies in separate allocations, as two headers would hold them.
+    std::vector<std::string> full_copy(full.begin(), full.end());
+
+    const int runs = 3;
+    double compact_ms = 1e300, expand_ms = 1e300;
+    double cmp_full_ms = 1e300, cmp_compact_ms = 1e300;
+    std::size_t equal = 0;
+    for (int run = 0; run < runs; ++run) {
+        compact_ms = std::min(compact_ms, time_ms([&] {
+            for (std::size_t i = 0; i < count; ++i)
+                compact[i] = tl::compact_signature(full[i]);
+        }));
+        expand_ms = std::min(expand_ms, time_ms([&] {
+            for (std::size_t i = 0; i < count; ++i)
+                expanded[i] = tl::expand_signature(compact[i]);
+        }));
+    }
+    std::vector<std::string> compact_copy(compact.begin(), compact.end());
+    for (int run = 0; run < runs; ++run) {
+        equal = 0;
+        cmp_full_ms = std::min(cmp_full_ms, time_ms([&] {
+            for (std::size_t i = 0; i < count; ++i)
+                equal += std::string_view(full[i]) == std::string_view(full_copy[i]);
+        }));
+        cmp_compact_ms = std::min(cmp_compact_ms, time_ms([&] {
+            for (std::size_t i = 0; i < count; ++i)
+                equal += std::string_view(compact[i]) == std::string_view(compact_copy[i]);
+        }));
+    }
+
+    std::size_t full_bytes = 0, compact_bytes = 0, max_full = 0, max_compact = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        full_bytes += full[i].size();
+        compact_bytes += compact[i].size();
+        max_full = std::max(max_full, full[i].size());
+        max_compact = std::max(max_compact, compact[i].size());
+    }
+
+    std::printf("bench_sig_compact: %zu signatures\n", count);
+    std::printf("size:\n");
+    std::printf("  full     %9.1f MB  mean %6.0f  max %6zu chars\n",
+                static_cast<double>(full_bytes) / 1e6,
+                static_cast<double>(full_bytes) / static_cast<double>(count), max_full);
+    std::printf("  compact  %9.1f MB  mean %6.0f  max %6zu chars  (%.1fx smaller)\n",
+                static_cast<double>(compact_bytes) / 1e6,
+                static_cast<double>(compact_bytes) / static_cast<double>(count), max_compact,
+                static_cast<double>(full_bytes) / static_cast<double>(compact_bytes));
+    std::printf("encode / decode:\n");
+    report("compact", compact_ms, count);
+    report("expand", expand_ms, count);
+    std::printf("equality of equal signatures:\n");
+    report("full", cmp_full_ms, count);
+    report("compact", cmp_compact_ms, count);
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (expanded[i] != full[i] || !tl::is_compact_signature(compact[i])) {
+            if (mismatches++ < 5)
+                std::fprintf(stderr, "round-trip mismatch #%zu: %s\n", i, full[i].c_str());
+        }
+    }
+    if (mismatches || equal != 2 * count) {
+        std::fprintf(stderr, "bench_sig_compact: %zu round-trip mismatch(es)\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
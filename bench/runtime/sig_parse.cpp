@@ -0,0 +1,223 @@
+// Runtime benchmark: single-pass signature parsing vs per-token scanning.
+//
+// Generates N layout signatures (default 100000) from a fixed seed --
+// flat records, nested records, bit-fields, arrays, enums and opaque
+// containers -- and times the work CompatReporter does per signature:
+//
+//   legacy  -- the token scans + brace splitting used before SigParser
+//              (classify: up to 12 sig_contains_token passes; fields:
+//              one depth-tracking split; header: one find)
+//   flags   -- classify_signature (SigParser::scan_flags, no nodes)
+//   ast     -- SigAst + classify_flags + parse_sig_fields + sig_header
+//
+// Results are cross-checked; a disagreement fails the run.
+//
+// Usage: bench_sig_parse [count]
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/tools/compat_check.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tl = boost::typelayout;
+namespace tld = boost::typelayout::detail;
+namespace tlc = boost::typelayout::compat::detail;
+
+namespace {
+
+// ---- Signature generator ---------------------------------------------------
+
+struct Rng {
+    std::uint64_t s;
+    std::uint32_t next() {
+        s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+        return static_cast<std::uint32_t>(s);
+    }
+    std::uint32_t below(std::uint32_t n) { return next() % n; }
+};
+
+const char* const scalars[] = {
+    "u8[s:1,a:1]", "u16[s:2,a:2]", "u32[s:4,a:4]", "u64[s:8,a:8]",
+    "i32[s:4,a:4]", "i64[s:8,a:8]", "f32[s:4,a:4]", "f64[s:8,a:8]",
+    "bool[s:1,a:1]", "char[s:1,a:1]",
+};
+const char* const rare[] = {
+    "ptr[s:8,a:8]", "wchar[s:4,a:4]", "fld80[s:16,a:16]", "fnptr[s:8,a:8]",
+};
+
+std::string gen_type(Rng& rng, int depth);
+
+std::string gen_record(Rng& rng, int depth, std::uint32_t fields) {
+    std::string body;
+    std::uint32_t off = 0;
+    for (std::uint32_t i = 0; i < fields; ++i) {
+        if (i) body += ',';
+        if (rng.below(16) == 0) {
+            body += "@" + std::to_string(off) + "." + std::to_string(rng.below(8)) +
+                    ":bits<" + std::to_string(1 + rng.below(7)) + ",u32[s:4,a:4]>";
+        } else {
+            body += "@" + std::to_string(off) + ":" + gen_type(rng, depth + 1);
+        }
+        off += 4 + 4 * rng.below(4);
+    }
+    return "record[s:" + std::to_string(off) + ",a:8]{" + body + "}";
+}
+
+std::string gen_type(Rng& rng, int depth) {
+    std::uint32_t pick = rng.below(64);
+    if (depth < 3 && pick < 3)
+        return gen_record(rng, depth, 2 + rng.below(6));
+    if (pick < 5)
+        return "array[s:64,a:4]<" + gen_type(rng, depth + 1) + "," +
+               std::to_string(1 + rng.below(64)) + ">";
+    if (pick < 6)
+        return "enum[s:4,a:4]<i32[s:4,a:4]>";
+    if (pick < 7)
+        return "bytes[s:" + std::to_string(1 + rng.below(256)) + ",a:1]";
+    if (pick < 8)
+        return "O(vec|24|8)<" + std::string(scalars[rng.below(10)]) + ">";
+    if (pick < 9)
+        return rare[rng.below(4)];
+    return scalars[rng.below(10)];
+}
+
+std::vector<std::string> gen_signatures(std::size_t n) {
+    Rng rng{0x9e3779b97f4a7c15ull};
+    std::vector<std::string> sigs;
+    sigs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint32_t width = (i % 100 == 0) ? 200 + rng.below(300) : 4 + rng.below(40);
+        sigs.push_back("[64-le]" + gen_record(rng, 0, width));
+    }
+    return sigs;
+}
+
+// ---- Legacy (pre-SigParser) scanning ---------------------------------------
+
+tlc::SafetyLevel legacy_classify(std::string_view sig) {
+    using tld::sig_contains_token;
+    if (sig_contains_token(sig, "O(")) return tlc::SafetyLevel::Opaque;
+    if (sig_contains_token(sig, "ptr[") || sig_contains_token(sig, "fnptr[") ||
+        sig_contains_token(sig, "memptr[") || sig_contains_token(sig, "ref[") ||
+        sig_contains_token(sig, "rref[") || sig_contains_token(sig, "vptr"))
+        return tlc::SafetyLevel::PointerRisk;
+    if (sig.find("bits<") != std::string_view::npos ||
+        sig.find("wchar[") != std::string_view::npos ||
+        sig_contains_token(sig, "fld64[") || sig_contains_token(sig, "fld80[") ||
+        sig_contains_token(sig, "fld106[") || sig_contains_token(sig, "fld128["))
+        return tlc::SafetyLevel::PlatformVariant;
+    return tlc::SafetyLevel::TrivialSafe;
+}
+
+std::size_t legacy_field_count(std::string_view sig) {
+    auto open = sig.find('{');
+    auto close = sig.rfind('}');
+    if (open == std::string_view::npos || close == std::string_view::npos ||
+        close <= open + 1)
+        return 0;
+    std::string_view content = sig.substr(open + 1, close - open - 1);
+    std::size_t n = 1;
+    int depth = 0;
+    for (char c : content) {
+        if (c == '[' || c == '{' || c == '<' || c == '(') ++depth;
+        else if (c == ']' || c == '}' || c == '>' || c == ')') { if (depth > 0) --depth; }
+        else if (c == ',' && depth == 0) ++n;
+    }
+    return n;
+}
+
+std::size_t legacy_header_len(std::string_view sig) {
+    auto brace = sig.find('{');
+    return brace == std::string_view::npos ? sig.size() : brace;
+}
+
+// ---- Timing ----------------------------------------------------------------
+
+template <typename F>
+double time_ms(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+void report(const char* name, double ms, std::size_t count, std::size_t bytes) {
+    std::printf("  %-8s %9.2f ms  %8.1f ns/sig  %8.1f MB/s\n", name, ms,
+                ms * 1e6 / static_cast<double>(count),
+                static_cast<double>(bytes) / (ms * 1e3));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc >= 2 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    auto sigs = gen_signatures(count);
+    std::size_t bytes = 0;
+    for (const auto& s : sigs) bytes += s.size();
+
+    std::printf("bench_sig_parse: %zu signatures, %.1f MB, mean %.0f chars\n",
+                count, static_cast<double>(bytes) / 1e6,
+                static_cast<double>(bytes) / static_cast<double>(count));
+
+    std::vector<int> legacy_level(count), ast_level(count), flags_level(count);
+    std::vector<std::size_t> legacy_fields(count), ast_fields(count);
+    std::vector<std::size_t> legacy_hdr(count), ast_hdr(count);
+
+    // Best of `runs` to damp scheduler noise.
+    const int runs = 3;
+    double classify_ms = 1e300, split_ms = 1e300, flags_ms = 1e300, ast_ms = 1e300;
+    for (int run = 0; run < runs; ++run) {
+        classify_ms = std::min(classify_ms, time_ms([&] {
+            for (std::size_t i = 0; i < count; ++i)
+                legacy_level[i] = static_cast<int>(legacy_classify(sigs[i]));
+        }));
+        split_ms = std::min(split_ms, time_ms([&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                legacy_fields[i] = legacy_field_count(sigs[i]);
+                legacy_hdr[i] = legacy_header_len(sigs[i]);
+            }
+        }));
+        flags_ms = std::min(flags_ms, time_ms([&] {
+            for (std::size_t i = 0; i < count; ++i)
+                flags_level[i] = static_cast<int>(tlc::classify_signature(sigs[i]));
+        }));
+        ast_ms = std::min(ast_ms, time_ms([&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                tld::SigAst ast(sigs[i]);
+                ast_level[i] = static_cast<int>(tlc::classify_flags(ast.flags()));
+                ast_fields[i] = tlc::parse_sig_fields(ast).size();
+                ast_hdr[i] = tlc::sig_header(ast).size();
+            }
+        }));
+    }
+
+    std::printf("classification:\n");
+    report("legacy", classify_ms, count, bytes);
+    report("flags", flags_ms, count, bytes);
+    std::printf("classification + fields + header:\n");
+    report("legacy", classify_ms + split_ms, count, bytes);
+    report("ast", ast_ms, count, bytes);
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (legacy_level[i] != ast_level[i] || legacy_level[i] != flags_level[i] ||
+            legacy_fields[i] != ast_fields[i] || legacy_hdr[i] != ast_hdr[i]) {
+            if (mismatches++ < 5)
+                std::fprintf(stderr, "mismatch #%zu: %s\n", i, sigs[i].c_str());
+        }
+    }
+    if (mismatches) {
+        std::fprintf(stderr, "bench_sig_parse: %zu mismatching signature(s)\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Runtime benchmark: socket_channel throughput over a Unix socketpair.
+//
+// A forked sender pushes M SensorRecords to the parent, which checks the
+// sequence of every record it receives in place:
+//
+//   per-record -- send() of one record at a time: one sendmsg() each
+//   batched    -- queue() of `batch`-record spans, flush() every 16 of
+//                 them: one gather write per 16 batches
+//
+// Reports records/s, MB/s and ns per record for each.  The receive side
+// is the same for both: receive() delivers every complete batch the
+// socket had.
+//
+// Usage: bench_socket_channel [records] [batch]
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/ipc/socket_channel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ipc = boost::typelayout::ipc;
+
+namespace {
+
+struct SensorRecord {
+    std::uint64_t timestamp_ns;   // sequence number
+    float         temperature;
+    float         humidity;
+    float         pressure;
+    std::uint32_t sensor_id;
+};
+
+using Link = ipc::socket_channel<SensorRecord>;
+using clock_type = std::chrono::steady_clock;
+
+void produce(Link& link, std::uint64_t count, std::size_t batch) {
+    std::vector<SensorRecord> records(static_cast<std::size_t>(count));
+    for (std::uint64_t i = 0; i < count; ++i) records[i] = {i, 20.0f, 0.5f, 1013.0f, 0};
+    const std::span<const SensorRecord> all(records);
+    if (batch == 1) {
+        for (const SensorRecord& r : all)
+            if (!link.send(std::span<const SensorRecord>(&r, 1))) ::_exit(1);
+        return;
+    }
+    std::size_t queued = 0;
+    for (std::size_t at = 0; at < all.size(); at += batch) {
+        link.queue(all.subspan(at, std::min(batch, all.size() - at)));
+        if (++queued == 16) {
+            if (!link.flush()) ::_exit(1);
+            queued = 0;
+        }
+    }
+    if (!link.flush()) ::_exit(1);
+}
+
+struct RunResult {
+    double seconds = 0;
+    bool   ok = true;
+};
+
+RunResult run(std::uint64_t count, std::size_t batch) {
+    RunResult result;
+    int pair[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+        result.ok = false;
+        return result;
+    }
+    const auto t0 = clock_type::now();
+    pid_t pid = ::fork();
+    if (pid == 0) {
+        ::close(pair[0]);
+        Link link;
+        if (!link.open_fd(pair[1])) ::_exit(2);
+        produce(link, count, batch);
+        ::_exit(0);
+    }
+    ::close(pair[1]);
+
+    Link link;
+    std::string error;
+    if (!link.open_fd(pair[0], &error)) {
+        std::fprintf(stderr, "bench_socket_channel: %s\n", error.c_str());
+        result.ok = false;
+    }
+    std::uint64_t next = 0;
+    while (result.ok && next < count) {
+        if (!link.receive([&](std::span<const SensorRecord> records) {
+                for (const SensorRecord& r : records)
+                    if (r.timestamp_ns != next++) result.ok = false;
+            }, &error)) {
+            std::fprintf(stderr, "bench_socket_channel: %s\n", error.c_str());
+            result.ok = false;
+        }
+    }
+    result.seconds = std::chrono::duration<double>(clock_type::now() - t0).count();
+
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) result.ok = false;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::uint64_t records = argc >= 2 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::size_t batch = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 256;
+    if (records == 0 || batch < 2) {
+        std::fprintf(stderr, "bench_socket_channel: need records >= 1, batch >= 2\n");
+        return 2;
+    }
+
+    std::printf("bench_socket_channel: %llu records of %zu bytes over a socketpair\n",
+                static_cast<unsigned long long>(records), sizeof(SensorRecord));
+    std::printf("  %-10s %7s %12s %10s %10s\n", "send", "batch", "Mrecords/s", "MB/s",
+                "ns/record");
+    int failures = 0;
+    // Per-record sends are slow; a tenth of the records is plenty.
+    const std::uint64_t single = std::max<std::uint64_t>(records / 10, 1);
+    for (std::size_t b : {std::size_t{1}, batch}) {
+        const std::uint64_t n = b == 1 ? single : records;
+        const RunResult r = run(n, b);
+        const double rate = static_cast<double>(n) / r.seconds;
+        std::printf("  %-10s %7zu %12.2f %10.1f %10.1f%s\n", b == 1 ? "per-record" : "batched",
+                    b, rate / 1e6, rate * sizeof(SensorRecord) / 1e6, 1e9 / rate,
+                    r.ok ? "" : "  WRONG");
+        failures += !r.ok;
+    }
+    return failures ? 1 : 0;
+}
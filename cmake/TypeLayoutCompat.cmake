@@ -4,6 +4,10 @@
 #   Phase 1: typelayout_add_sig_export()    — export signatures on each platform
 #   Phase 2: typelayout_add_compat_check()  — compare signatures at compile time
 #   Both:    typelayout_add_compat_pipeline() — one call creates Phase 1 + Phase 2
+#   Phase 2 without compiling: typelayout_add_sigdb_check() — runs the
+#            prebuilt typelayout_sigdb_check over .sigdb files (Phase 1 SIGDB)
+#   Phase 2 sources get typelayout_link_threads() for CompatReporter's
+#            parallel mode (serial when no thread library is found)
 #
 # All functions expect the user to have written their source files using
 # the declarative macros:
@@ -27,6 +31,26 @@ function(_typelayout_setup_target target)
     endif()
 endfunction()
 
+# ---------------------------------------------------------------------------
+# typelayout_link_threads
+# ---------------------------------------------------------------------------
+# Links Threads::Threads into a target that uses CompatReporter, for its
+# parallel mode (set_threads / --threads).  Without a thread library (no
+# Threads::Threads target) the target is built with
+# BOOST_TYPELAYOUT_NO_THREADS and always compares on one thread.
+#
+# Usage:
+#   find_package(Threads)
+#   typelayout_link_threads(my_compat_check)
+#
+function(typelayout_link_threads target)
+    if(TARGET Threads::Threads)
+        target_link_libraries(${target} PRIVATE Threads::Threads)
+    else()
+        target_compile_definitions(${target} PRIVATE BOOST_TYPELAYOUT_NO_THREADS)
+    endif()
+endfunction()
+
 # ---------------------------------------------------------------------------
 # typelayout_add_sig_export
 # ---------------------------------------------------------------------------
@@ -40,6 +64,10 @@ endfunction()
 #       SOURCE export_sigs.cpp          # must use TYPELAYOUT_EXPORT_TYPES(...)
 #       OUTPUT_DIR ${CMAKE_BINARY_DIR}/sigs
 #       INCLUDE_DIRS ${CMAKE_SOURCE_DIR}/include   # optional extra include dirs
+#       TIMESTAMP                       # optional: stamp the export time
+#       SIGDB                           # optional: also write <platform>.sigdb
+#       HASH_HEADER                     # optional: split out <platform>.sighash.hpp
+#       PREDICT x86_64_windows_msvc     # optional: also write predicted platforms
 #   )
 #
 # Arguments:
@@ -47,9 +75,24 @@ endfunction()
 #   SOURCE       - User .cpp file with TYPELAYOUT_EXPORT_TYPES(...)
 #   OUTPUT_DIR   - Where .sig.hpp will be written (default: ${CMAKE_BINARY_DIR}/sigs)
 #   INCLUDE_DIRS - Additional include directories for user types (optional)
+#   TIMESTAMP    - If present, the header records the export time.  Otherwise
+#                  the export is deterministic (--deterministic): unchanged
+#                  layouts reproduce the file byte for byte, the exporter
+#                  leaves it untouched, and Phase 2 targets that include it
+#                  are not recompiled.
+#   SIGDB        - If present, also write the binary signature database
+#                  <platform>.sigdb (tools/sigdb.hpp) next to the header.
+#   HASH_HEADER  - If present, metadata and layout hashes go to
+#                  <platform>.sighash.hpp, which <platform>.sig.hpp includes.
+#                  Check sources that only use TYPELAYOUT_ASSERT_COMPAT can
+#                  include the .sighash.hpp files and skip the signatures.
+#   PREDICT      - Platforms (AbiModel names, tools/abi_model.hpp, or "all")
+#                  whose signatures are predicted from this build and
+#                  exported next to the host's.  SOURCE must use
+#                  TYPELAYOUT_EXPORT_TYPES_PREDICTED(...).
 #
 function(typelayout_add_sig_export)
-    cmake_parse_arguments(ARG "" "TARGET;SOURCE;OUTPUT_DIR" "INCLUDE_DIRS" ${ARGN})
+    cmake_parse_arguments(ARG "TIMESTAMP;SIGDB;HASH_HEADER" "TARGET;SOURCE;OUTPUT_DIR" "INCLUDE_DIRS;PREDICT" ${ARGN})
 
     if(NOT ARG_TARGET)
         message(FATAL_ERROR "typelayout_add_sig_export: TARGET is required")
@@ -80,10 +123,25 @@ function(typelayout_add_sig_export)
     # Create output directory
     file(MAKE_DIRECTORY ${ARG_OUTPUT_DIR})
 
-    # Run the exporter after building to produce .sig.hpp
+    # Run the exporter after building to produce .sig.hpp; it rewrites the
+    # file only when the contents change.
+    set(_export_args)
+    if(NOT ARG_TIMESTAMP)
+        set(_export_args --deterministic)
+    endif()
+    if(ARG_SIGDB)
+        list(APPEND _export_args --sigdb)
+    endif()
+    if(ARG_HASH_HEADER)
+        list(APPEND _export_args --hash-header)
+    endif()
+    if(ARG_PREDICT)
+        list(JOIN ARG_PREDICT "," _predict)
+        list(APPEND _export_args --predict=${_predict})
+    endif()
     add_custom_command(
         TARGET ${ARG_TARGET} POST_BUILD
-        COMMAND ${ARG_TARGET} ${ARG_OUTPUT_DIR}
+        COMMAND ${ARG_TARGET} ${ARG_OUTPUT_DIR} ${_export_args}
         COMMENT "[TypeLayout] Exporting signatures to ${ARG_OUTPUT_DIR}"
         VERBATIM
     )
@@ -131,6 +189,73 @@ function(typelayout_add_compat_check)
     endif()
 
     _typelayout_setup_target(${ARG_TARGET} INCLUDE_DIRS ${_include_dirs})
+    typelayout_link_threads(${ARG_TARGET})
+endfunction()
+
+# ---------------------------------------------------------------------------
+# typelayout_add_sigdb_check
+# ---------------------------------------------------------------------------
+# Registers a CTest test that compares .sigdb files with the prebuilt
+# typelayout_sigdb_check (TYPELAYOUT_BUILD_TOOLS), so no Phase 2 source is
+# compiled per project.
+#
+# Usage:
+#   typelayout_add_sigdb_check(
+#       NAME   myproject_sigdb_check
+#       SIGDBS ${SIGS}/x86_64_linux_gcc.sigdb ${SIGS}/arm64_macos_clang.sigdb
+#       DIFF                                    # optional: field diffs
+#       VERIFY                                  # optional: check stored hashes
+#       NO_CACHE                                # optional: no result cache
+#   )
+#
+# Arguments:
+#   NAME     - Test name
+#   SIGDBS   - Signature databases to compare (at least two)
+#   DIFF     - If present, DIFFER rows carry field diffs (--diff)
+#   VERIFY   - If present, every stored hash is recomputed from its string
+#              before comparing (--verify); otherwise only the file
+#              structure is checked when a database is opened
+#   NO_CACHE - If present, the test does not keep a result cache.  Otherwise
+#              it runs with --cache=${CMAKE_CURRENT_BINARY_DIR}/${NAME}.compat-cache
+#
+function(typelayout_add_sigdb_check)
+    cmake_parse_arguments(ARG "DIFF;VERIFY;NO_CACHE" "NAME" "SIGDBS" ${ARGN})
+
+    if(NOT ARG_NAME)
+        message(FATAL_ERROR "typelayout_add_sigdb_check: NAME is required")
+    endif()
+    list(LENGTH ARG_SIGDBS _count)
+    if(_count LESS 2)
+        message(FATAL_ERROR "typelayout_add_sigdb_check: SIGDBS needs at least two files")
+    endif()
+    if(NOT TARGET typelayout_sigdb_check)
+        message(FATAL_ERROR
+            "typelayout_add_sigdb_check: typelayout_sigdb_check is not built "
+            "(TYPELAYOUT_BUILD_TOOLS is OFF)")
+    endif()
+
+    if(NOT CMAKE_TESTING_ENABLED)
+        enable_testing()
+    endif()
+
+    set(_check_args)
+    if(ARG_DIFF)
+        list(APPEND _check_args --diff)
+    endif()
+    if(ARG_VERIFY)
+        list(APPEND _check_args --verify)
+    endif()
+    if(NOT ARG_NO_CACHE)
+        list(APPEND _check_args
+            "--cache=${CMAKE_CURRENT_BINARY_DIR}/${ARG_NAME}.compat-cache")
+    endif()
+    add_test(
+        NAME ${ARG_NAME}
+        COMMAND typelayout_sigdb_check ${_check_args} ${ARG_SIGDBS}
+    )
+    set_tests_properties(${ARG_NAME} PROPERTIES
+        LABELS "typelayout;compat"
+    )
 endfunction()
 
 # ---------------------------------------------------------------------------
@@ -148,6 +273,7 @@ endfunction()
 #       SIGS_DIR      ${CMAKE_SOURCE_DIR}/sigs # where .sig.hpp live / get written
 #       INCLUDE_DIRS  ${CMAKE_SOURCE_DIR}/include  # optional
 #       ADD_TEST                                # optional: register CTest
+#       NO_CACHE                                # optional: no result cache
 #   )
 #
 # This creates:
@@ -164,9 +290,14 @@ endfunction()
 #                    (default: ${CMAKE_BINARY_DIR}/sigs)
 #   INCLUDE_DIRS   - Additional include directories (optional, multi-value)
 #   ADD_TEST       - If present, register Phase 2 as a CTest test
+#   NO_CACHE       - If present, the test does not keep a result cache.
+#                    Otherwise it runs with
+#                    --cache=${CMAKE_CURRENT_BINARY_DIR}/${NAME}_check.compat-cache
+#                    and re-diffs only types whose layout hashes changed
+#                    since the previous run.
 #
 function(typelayout_add_compat_pipeline)
-    cmake_parse_arguments(ARG "ADD_TEST" "NAME;EXPORT_SOURCE;CHECK_SOURCE;SIGS_DIR" "INCLUDE_DIRS" ${ARGN})
+    cmake_parse_arguments(ARG "ADD_TEST;NO_CACHE" "NAME;EXPORT_SOURCE;CHECK_SOURCE;SIGS_DIR" "INCLUDE_DIRS" ${ARGN})
 
     if(NOT ARG_NAME)
         message(FATAL_ERROR "typelayout_add_compat_pipeline: NAME is required")
@@ -213,9 +344,14 @@ function(typelayout_add_compat_pipeline)
         # A non-zero exit code (from TYPELAYOUT_CHECK_COMPAT) or
         # compilation failure (from TYPELAYOUT_ASSERT_COMPAT) signals
         # incompatibility.
+        set(_check_args)
+        if(NOT ARG_NO_CACHE)
+            set(_check_args
+                "--cache=${CMAKE_CURRENT_BINARY_DIR}/${_check_target}.compat-cache")
+        endif()
         add_test(
             NAME ${_check_target}
-            COMMAND ${_check_target}
+            COMMAND ${_check_target} ${_check_args}
         )
         set_tests_properties(${_check_target} PROPERTIES
             LABELS "typelayout;compat"
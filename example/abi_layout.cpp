@@ -0,0 +1,137 @@
+// ABI layout engine without reflection (tools/abi_layout.hpp).
+//
+// Describes the types of example/sigs by hand as an AbiTypeGraph, lays them
+// out under the model of each checked-in export, and checks every
+// signature and layout_hash against the exported one.  abi_predict runs the
+// same comparison from reflected types; this one separates engine
+// differences from describer differences.  Exits nonzero on any difference.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+// Before the .sig.hpp files (see abi_predict.cpp).
+#include <boost/typelayout/tools/abi_layout.hpp>
+#include <boost/typelayout/detail/layout_hash.hpp>
+
+#include "sigs/x86_64_linux_clang.sig.hpp"
+#include "sigs/arm64_macos_clang.sig.hpp"
+#include "sigs/x86_64_windows_msvc.sig.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace tl = boost::typelayout;
+
+namespace {
+
+struct Described {
+    const char*   name;
+    std::uint32_t type;
+};
+
+class Describer {
+public:
+    std::uint32_t scalar(tl::AbiScalar s, std::size_t host_size) {
+        tl::AbiType t;
+        t.scalar = s;
+        t.host_size = host_size;
+        t.host_align = host_size;
+        return graph.add(std::move(t));
+    }
+
+    std::uint32_t bytes(std::uint32_t element, std::uint64_t count) {
+        tl::AbiType t;
+        t.kind = tl::AbiTypeKind::Array;
+        t.element = element;
+        t.count = count;
+        t.byte_array = true;
+        t.host_size = static_cast<std::size_t>(count);
+        t.host_align = 1;
+        return graph.add(std::move(t));
+    }
+
+    // A standard-layout struct of the given fields, no bases.
+    std::uint32_t record(std::initializer_list<std::uint32_t> fields) {
+        tl::AbiType t;
+        t.kind = tl::AbiTypeKind::Record;
+        t.pod_for_layout = true;
+        for (std::uint32_t f : fields) {
+            tl::AbiMember m;
+            m.type = f;
+            t.members.push_back(m);
+        }
+        return graph.add(std::move(t));
+    }
+
+    tl::AbiTypeGraph graph;
+};
+
+} // namespace
+
+int main() {
+    using S = tl::AbiScalar;
+    Describer d;
+    const std::uint32_t u16 = d.scalar(S::U16, 2), u32 = d.scalar(S::U32, 4);
+    const std::uint32_t u64 = d.scalar(S::U64, 8), i32 = d.scalar(S::I32, 4);
+    const std::uint32_t i64 = d.scalar(S::I64, 8), f32 = d.scalar(S::F32, 4);
+    const std::uint32_t f64 = d.scalar(S::F64, 8), chr = d.scalar(S::Char, 1);
+    // Host sizes only matter to calibrate(); the engine sizes these per model.
+    const std::uint32_t lng = d.scalar(S::Long, 8), ptr = d.scalar(S::Ptr, 8);
+    const std::uint32_t wch = d.scalar(S::WChar, 4), ldb = d.scalar(S::LongDouble, 16);
+
+    const Described types[] = {
+        {"PacketHeader",      d.record({u32, u16, u16, u32, u32})},
+        {"SharedMemRegion",   d.record({u64, u64, u32, u32})},
+        {"FileHeader",        d.record({d.bytes(chr, 4), u32, u64, u32, u32})},
+        {"SensorRecord",      d.record({u64, f32, f32, f32, u32})},
+        {"IpcCommand",        d.record({u32, u32, i64, i64, d.bytes(chr, 64)})},
+        {"UnsafeStruct",      d.record({lng, ptr, wch, ldb})},
+        {"UnsafeWithPointer", d.record({u32, ptr, u64})},
+        {"MixedSafety",       d.record({u32, f64, i32})},
+    };
+
+    const tl::PlatformInfo exports[] = {
+        tl::platform::x86_64_linux_clang::get_platform_info(),
+        tl::platform::arm64_macos_clang::get_platform_info(),
+        tl::platform::x86_64_windows_msvc::get_platform_info(),
+    };
+
+    int failures = 0;
+    for (const tl::PlatformInfo& exported : exports) {
+        const tl::AbiModel* model = tl::find_abi_model(exported.platform_name);
+        if (!model) {
+            std::cerr << exported.platform_name << ": no ABI model\n";
+            ++failures;
+            continue;
+        }
+        tl::AbiLayoutEngine engine(d.graph, *model);
+        int differ = 0;
+        for (std::size_t i = 0; i < exported.type_count; ++i) {
+            const tl::TypeEntry& x = exported.types[i];
+            const Described* t = nullptr;
+            for (const Described& c : types)
+                if (std::string_view(c.name) == x.name) t = &c;
+            if (!t) {
+                std::cerr << exported.platform_name << " " << x.name << ": not described\n";
+                ++differ;
+                continue;
+            }
+            const std::string sig = engine.signature(t->type);
+            if (sig != x.layout_sig ||
+                (x.layout_hash != 0 && tl::layout_hash(sig) != x.layout_hash)) {
+                std::cerr << exported.platform_name << " " << x.name << ":\n"
+                          << "  engine   " << sig << "\n"
+                          << "  exported " << x.layout_sig << "\n";
+                ++differ;
+            }
+        }
+        std::cout << exported.platform_name << ": " << exported.type_count
+                  << " types laid out, " << differ << " differ\n";
+        failures += differ;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+// Predicted foreign-platform export (tools/abi_emulate.hpp).
+//
+// Predicts every preset of abi_models[] from this one build.  A preset
+// with a checked-in export in example/sigs must match it exactly: the same
+// platform metadata, the same types, and per type the same signature,
+// byte_copy_safe and layout_hash.
+// Every other preset must predict all of the types.  Exits nonzero on any
+// difference.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+// Before the .sig.hpp files: they then reopen the tool headers' platform
+// namespace instead of declaring a second one that makes
+// tl::platform::... ambiguous.
+#include <boost/typelayout/tools/abi_emulate.hpp>
+
+#include "compat_ci_types.hpp"
+
+#include "sigs/x86_64_linux_clang.sig.hpp"
+#include "sigs/arm64_macos_clang.sig.hpp"
+#include "sigs/x86_64_windows_msvc.sig.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+namespace tl = boost::typelayout;
+
+// The two pointer-bearing types of example/sigs.
+struct UnsafeStruct {
+    long        id;
+    void*       owner;
+    wchar_t     tag;
+    long double value;
+};
+
+struct UnsafeWithPointer {
+    std::uint32_t  id;
+    UnsafeStruct*  next;
+    std::uint64_t  stamp;
+};
+
+static const tl::PlatformInfo exports[] = {
+    tl::platform::x86_64_linux_clang::get_platform_info(),
+    tl::platform::arm64_macos_clang::get_platform_info(),
+    tl::platform::x86_64_windows_msvc::get_platform_info(),
+};
+
+static const tl::PlatformInfo* find_export(std::string_view platform_name) {
+    for (const tl::PlatformInfo& p : exports)
+        if (platform_name == p.platform_name) return &p;
+    return nullptr;
+}
+
+static const tl::detail::ExportEntry* find_entry(const tl::SigExporter& ex,
+                                                 std::string_view name) {
+    for (const auto& e : ex.entries())
+        if (e.name == name) return &e;
+    return nullptr;
+}
+
+// The metadata a predicted .sig.hpp would be written with, against the
+// checked-in export's.
+static int check_metadata(const tl::AbiModel& model, const tl::PlatformInfo& exported) {
+    int failures = 0;
+    auto field = [&](const char* what, auto predicted, auto actual) {
+        if (predicted == actual) return;
+        std::cerr << exported.platform_name << " " << what << ": predicted "
+                  << predicted << ", exported " << actual << "\n";
+        ++failures;
+    };
+    field("pointer_size", model.pointer_size, exported.pointer_size);
+    field("sizeof_long", model.sizeof_long, exported.sizeof_long);
+    field("sizeof_wchar_t", model.sizeof_wchar_t, exported.sizeof_wchar_t);
+    field("sizeof_long_double", model.sizeof_long_double, exported.sizeof_long_double);
+    field("max_align", model.max_align, exported.max_align);
+    field("data_model", std::string_view(model.data_model),
+          std::string_view(exported.data_model));
+    field("arch_prefix", model.arch_prefix(), std::string_view(exported.arch_prefix));
+    return failures;
+}
+
+static int check(const tl::AbiModel& model, const tl::SigExporter& predicted,
+                 const tl::PlatformInfo& exported) {
+    int failures = check_metadata(model, exported);
+    for (std::size_t i = 0; i < exported.type_count; ++i) {
+        const tl::TypeEntry& x = exported.types[i];
+        const tl::detail::ExportEntry* e = find_entry(predicted, x.name);
+        if (!e) {
+            std::cerr << exported.platform_name << " " << x.name << ": not predicted\n";
+            ++failures;
+        } else if (e->layout_sig != std::string_view(x.layout_sig) ||
+                   e->byte_copy_safe != x.byte_copy_safe ||
+                   (x.layout_hash != 0 && e->layout_hash != x.layout_hash)) {
+            std::cerr << exported.platform_name << " " << x.name << ":\n"
+                      << "  predicted " << e->layout_sig
+                      << (e->byte_copy_safe ? " (byte-copy safe)" : "")
+                      << " hash 0x" << std::hex << e->layout_hash << "\n"
+                      << "  exported  " << x.layout_sig
+                      << (x.byte_copy_safe ? " (byte-copy safe)" : "")
+                      << " hash 0x" << x.layout_hash << std::dec << "\n";
+            ++failures;
+        }
+    }
+    for (const auto& e : predicted.entries()) {
+        bool found = false;
+        for (std::size_t i = 0; i < exported.type_count; ++i)
+            found = found || e.name == exported.types[i].name;
+        if (!found) {
+            std::cerr << exported.platform_name << " " << e.name << ": not exported\n";
+            ++failures;
+        }
+    }
+    return failures;
+}
+
+int main() {
+    tl::AbiEmulator em;
+    em.add<PacketHeader>("PacketHeader");
+    em.add<SharedMemRegion>("SharedMemRegion");
+    em.add<FileHeader>("FileHeader");
+    em.add<SensorRecord>("SensorRecord");
+    em.add<IpcCommand>("IpcCommand");
+    em.add<UnsafeStruct>("UnsafeStruct");
+    em.add<UnsafeWithPointer>("UnsafeWithPointer");
+    em.add<MixedSafety>("MixedSafety");
+    constexpr std::size_t registered = 8;
+
+    int failures = static_cast<int>(em.unpredictable().size());
+    for (const tl::AbiModel& model : tl::abi_models) {
+        const tl::SigExporter predicted = em.predict(model);
+        int differ = 0;
+        if (const tl::PlatformInfo* exported = find_export(model.platform_name)) {
+            differ = check(model, predicted, *exported);
+        } else if (predicted.entries().size() != registered) {
+            std::cerr << model.platform_name << ": " << predicted.entries().size()
+                      << " of " << registered << " types predicted\n";
+            differ = 1;
+        }
+        std::cout << model.platform_name << ": " << predicted.entries().size()
+                  << " types predicted"
+                  << (find_export(model.platform_name) ? ", checked against example/sigs" : "")
+                  << ", " << differ << " differ\n";
+        failures += differ;
+    }
+    for (const tl::PlatformInfo& p : exports) {
+        if (!tl::find_abi_model(p.platform_name)) {
+            std::cerr << p.platform_name << ": no ABI model\n";
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// Namespace export (SigExporter::add_namespace).
+//
+// Registers the [[=export_layout]] classes of one namespace and every
+// trivially copyable class of another, and checks which types were taken,
+// in declaration order, with the signatures get_layout_signature gives
+// them.  A second namespace that reuses an exported name must be refused
+// without adding anything.  Exits nonzero on any failure.
+//
+// Built with TYPELAYOUT_EXAMPLE_ANNOTATE_NON_TRIVIAL, an annotated class
+// that is not trivially copyable is added; that build must fail (ctest
+// export_namespace_rejects_non_trivial).
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/tools/sig_export.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace tl = boost::typelayout;
+
+namespace wire {
+
+struct [[=tl::export_layout]] Header {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t kind;
+};
+
+// Trivially copyable but not annotated: skipped by the annotated filter.
+struct Scratch {
+    std::uint64_t bytes[4];
+};
+
+// Not trivially copyable and not annotated: skipped.
+struct Session {
+    std::string peer;
+};
+
+struct [[=tl::export_layout]] Trailer {
+    std::uint32_t checksum;
+    std::uint32_t length;
+};
+
+#ifdef TYPELAYOUT_EXAMPLE_ANNOTATE_NON_TRIVIAL
+struct [[=tl::export_layout]] Named {
+    std::uint32_t id;
+    std::string   name;
+};
+#endif
+
+// Nested namespaces are not entered.  Its Header clashes with wire::Header.
+namespace md {
+
+struct [[=tl::export_layout]] Header {
+    std::uint64_t sequence;
+};
+
+} // namespace md
+
+} // namespace wire
+
+namespace store {
+
+struct Record {
+    std::uint64_t key;
+    double        value;
+};
+
+// Not trivially copyable: skipped by the default filter.
+struct Index {
+    Index() = default;
+    Index(const Index&) {}
+    std::uint32_t slot;
+};
+
+struct Footer {
+    std::uint32_t count;
+};
+
+} // namespace store
+
+template <typename T>
+static bool has_entry(const tl::SigExporter& ex, std::size_t i, std::string_view name) {
+    constexpr auto sig = tl::get_layout_signature<T>();
+    const auto& entries = ex.entries();
+    if (i < entries.size() && entries[i].name == name &&
+        entries[i].layout_sig == std::string_view(sig.value, sig.size))
+        return true;
+    std::cerr << "FAILED: entry " << i << " is not " << name << "\n";
+    return false;
+}
+
+int main() {
+    int failures = 0;
+    tl::SigExporter ex;
+
+    if (!ex.add_namespace<^^wire, tl::namespace_filter::annotated>()) {
+        std::cerr << "FAILED: add_namespace<^^wire, annotated> refused\n";
+        ++failures;
+    }
+    if (!ex.add_namespace<^^store>()) {
+        std::cerr << "FAILED: add_namespace<^^store> refused\n";
+        ++failures;
+    }
+    if (ex.entries().size() != 4) {
+        std::cerr << "FAILED: " << ex.entries().size() << " types registered, want 4\n";
+        ++failures;
+    }
+    failures += !has_entry<wire::Header>(ex, 0, "Header");
+    failures += !has_entry<wire::Trailer>(ex, 1, "Trailer");
+    failures += !has_entry<store::Record>(ex, 2, "Record");
+    failures += !has_entry<store::Footer>(ex, 3, "Footer");
+
+    // wire::md::Header reuses the unqualified name Header: nothing from
+    // wire::md may be added.
+    if (ex.add_namespace<^^wire::md, tl::namespace_filter::annotated>()) {
+        std::cerr << "FAILED: duplicate name Header accepted\n";
+        ++failures;
+    }
+    if (ex.entries().size() != 4) {
+        std::cerr << "FAILED: refused namespace added "
+                  << ex.entries().size() - 4 << " types\n";
+        ++failures;
+    }
+
+    for (const auto& e : ex.entries())
+        std::cout << e.name << " " << e.layout_sig << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+// Layout-checked shared-memory rings (ipc/ring.hpp).
+//
+// A forked producer streams records through a small spsc_ring, which wraps
+// many times, and the parent checks that every record arrives once and in
+// order.  Four forked producers share an mpsc_ring; the parent checks that
+// each producer's records arrive in its order and none is lost or
+// duplicated.  Attaching with a different record layout, or as the other
+// ring flavour, must be refused, and the refused ring must then push and
+// pop nothing.  Exits nonzero on any failure.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/ipc/ring.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ipc = boost::typelayout::ipc;
+
+struct Tick {
+    std::uint32_t producer;
+    std::uint32_t flags;
+    std::uint64_t seq;
+};
+
+// The same fields in another order: a different layout stamp.
+struct TickV2 {
+    std::uint64_t seq;
+    std::uint32_t producer;
+    std::uint32_t flags;
+};
+
+constexpr std::uint64_t per_producer = 200000;
+constexpr std::uint32_t producers = 4;
+constexpr std::size_t   capacity = 64;
+constexpr std::size_t   batch = 16;
+
+// Child: attaches to `name` and pushes per_producer ticks, alternating
+// single pushes and batches.
+template <typename Ring>
+[[noreturn]] void produce(const std::string& name, std::uint32_t id) {
+    Ring ring;
+    std::string error;
+    if (!ring.attach(name, &error)) {
+        std::cerr << "producer " << id << " attach: " << error << "\n";
+        ::_exit(1);
+    }
+    Tick run[batch];
+    std::uint64_t seq = 0;
+    while (seq < per_producer) {
+        std::size_t n = (seq / batch) % 2 ? batch : 1;
+        if (n > per_producer - seq) n = static_cast<std::size_t>(per_producer - seq);
+        for (std::size_t i = 0; i < n; ++i) run[i] = Tick{id, 0, seq + i};
+        std::size_t sent = 0;
+        while (sent < n) {
+            const std::size_t k = ring.try_push_n(run + sent, n - sent);
+            if (k == 0) ::sched_yield();
+            sent += k;
+        }
+        seq += n;
+    }
+    ::_exit(0);
+}
+
+template <typename Ring>
+pid_t spawn(const std::string& name, std::uint32_t id) {
+    const pid_t pid = ::fork();
+    if (pid == 0) produce<Ring>(name, id);
+    return pid;
+}
+
+// Pops until every child has exited and the ring is drained; `check`
+// sees each record.  False if a child failed or the record count is not
+// `total`.
+template <typename Ring, typename Check>
+bool consume(Ring& ring, std::vector<pid_t> children, std::uint64_t total, Check check) {
+    Tick got[batch];
+    std::uint64_t received = 0;
+    bool ok = true;
+    for (;;) {
+        const std::size_t k = ring.try_pop_n(got, batch);
+        for (std::size_t i = 0; i < k; ++i) ok = check(got[i]) && ok;
+        received += k;
+        if (k != 0) continue;
+        for (std::size_t i = 0; i < children.size(); ++i) {
+            int status = 0;
+            if (::waitpid(children[i], &status, WNOHANG) != children[i]) continue;
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = false;
+            children.erase(children.begin() + static_cast<std::ptrdiff_t>(i--));
+        }
+        if (children.empty() && ring.size_approx() == 0) break;
+        ::sched_yield();
+    }
+    if (received != total) {
+        std::cerr << "received " << received << " of " << total << " records\n";
+        ok = false;
+    }
+    return ok;
+}
+
+static int spsc(const std::string& name) {
+    std::string error;
+    ipc::spsc_ring<Tick> ring;
+    if (!ring.create(name, capacity, &error)) {
+        std::cerr << "spsc create: " << error << "\n";
+        return 1;
+    }
+    std::uint64_t next = 0;
+    const bool ok = consume(ring, {spawn<ipc::spsc_ring<Tick>>(name, 0)}, per_producer,
+                            [&](const Tick& t) {
+                                if (t.producer != 0 || t.seq != next) {
+                                    std::cerr << "spsc: got " << t.seq << ", want "
+                                              << next << "\n";
+                                    next = t.seq + 1;
+                                    return false;
+                                }
+                                ++next;
+                                return true;
+                            });
+    if (!ok) return 1;
+    std::cout << "spsc_ring: " << per_producer << " records in order through "
+              << ring.capacity() << " slots\n";
+
+    ipc::spsc_ring<TickV2> wrong;
+    if (wrong.attach(name, &error)) {
+        std::cerr << "spsc_ring attached with a different layout\n";
+        return 1;
+    }
+    std::cout << "rejected TickV2 view: " << error << "\n";
+    TickV2 probe{};
+    if (wrong.capacity() != 0 || wrong.size_approx() != 0 ||
+        wrong.try_push(probe) || wrong.try_pop(probe)) {
+        std::cerr << "spsc_ring usable after a failed attach\n";
+        return 1;
+    }
+    ipc::mpsc_ring<Tick> flavour;
+    if (flavour.attach(name, &error)) {
+        std::cerr << "mpsc_ring attached to an spsc_ring\n";
+        return 1;
+    }
+    std::cout << "rejected mpsc view: " << error << "\n";
+    Tick tick{};
+    if (flavour.try_push(tick) || flavour.try_pop(tick)) {
+        std::cerr << "mpsc_ring usable after a failed attach\n";
+        return 1;
+    }
+    return 0;
+}
+
+static int mpsc(const std::string& name) {
+    std::string error;
+    ipc::mpsc_ring<Tick> ring;
+    if (!ring.create(name, capacity, &error)) {
+        std::cerr << "mpsc create: " << error << "\n";
+        return 1;
+    }
+    std::vector<pid_t> children;
+    for (std::uint32_t id = 0; id < producers; ++id)
+        children.push_back(spawn<ipc::mpsc_ring<Tick>>(name, id));
+    std::vector<std::uint64_t> next(producers, 0);
+    const bool ok = consume(ring, children, per_producer * producers, [&](const Tick& t) {
+        if (t.producer >= producers || t.seq != next[t.producer]) {
+            std::cerr << "mpsc: producer " << t.producer << " sent " << t.seq
+                      << " out of order\n";
+            return false;
+        }
+        ++next[t.producer];
+        return true;
+    });
+    for (std::uint32_t id = 0; id < producers; ++id) {
+        if (next[id] != per_producer) {
+            std::cerr << "mpsc: producer " << id << " delivered " << next[id] << " of "
+                      << per_producer << "\n";
+            return 1;
+        }
+    }
+    if (!ok) return 1;
+    std::cout << "mpsc_ring: " << producers << " x " << per_producer
+              << " records, each producer in order\n";
+
+    ipc::mpsc_ring<TickV2> wrong;
+    if (wrong.attach(name, &error)) {
+        std::cerr << "mpsc_ring attached with a different layout\n";
+        return 1;
+    }
+    std::cout << "rejected TickV2 view: " << error << "\n";
+    TickV2 probe{};
+    if (wrong.capacity() != 0 || wrong.size_approx() != 0 ||
+        wrong.try_push(probe) || wrong.try_pop(probe)) {
+        std::cerr << "spsc_ring usable after a failed attach\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    const std::string base = "/typelayout_ring." + std::to_string(::getpid());
+    int failures = 0;
+    failures += spsc(base + ".spsc");
+    failures += mpsc(base + ".mpsc");
+    ipc::spsc_ring<Tick>::remove(base + ".spsc");
+    ipc::mpsc_ring<Tick>::remove(base + ".mpsc");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+// Memory-mapped record files (ipc/mapped_record_file.hpp).
+//
+// Writes a log of SensorRecords one by one and in batches, reopens it
+// read-only and walks the mapped records in place, appends to it again
+// (growing the file past its first mapping, under an open reader that
+// must keep seeing the records it opened with) and checks that opening the
+// log as a different record type fails at open time.  Exits nonzero on
+// any failure.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "compat_ci_types.hpp"
+
+#include <boost/typelayout/ipc/mapped_record_file.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ipc = boost::typelayout::ipc;
+
+namespace {
+
+SensorRecord make_record(std::uint64_t i) {
+    return {i, 20.0f + static_cast<float>(i % 10), 0.5f, 1013.0f,
+            static_cast<std::uint32_t>(i % 4)};
+}
+
+/// True if `log` holds records 0 .. count-1 in order.
+bool holds_sequence(const ipc::mapped_record_file<SensorRecord>& log, std::size_t count) {
+    if (log.size() != count) return false;
+    std::uint64_t expected = 0;
+    for (const SensorRecord& r : log.records())
+        if (r.timestamp_ns != expected++ || r.sensor_id != r.timestamp_ns % 4) return false;
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const std::string path = "typelayout_records." + std::to_string(::getpid()) + ".tlr";
+    std::string error;
+    int failures = 0;
+    auto check = [&](bool ok, const char* what) {
+        if (!ok) {
+            std::cerr << "FAILED: " << what << (error.empty() ? "" : ": ") << error << "\n";
+            ++failures;
+        }
+    };
+
+    {
+        ipc::mapped_record_file<SensorRecord> log;
+        check(log.create(path, &error), "create");
+        for (std::uint64_t i = 0; i < 10; ++i) check(log.append(make_record(i), &error), "append one");
+        std::vector<SensorRecord> batch;
+        for (std::uint64_t i = 10; i < 1000; ++i) batch.push_back(make_record(i));
+        check(log.append(std::span<const SensorRecord>(batch), &error), "append batch");
+        check(holds_sequence(log, 1000), "writer view");
+        check(log.flush(&error), "flush");
+    }
+
+    struct stat st{};
+    check(::stat(path.c_str(), &st) == 0 &&
+              static_cast<std::size_t>(st.st_size) == 64 + 1000 * sizeof(SensorRecord),
+          "close trims the spare capacity");
+
+    {
+        ipc::mapped_record_file<SensorRecord> log;
+        check(log.open(path, &error), "open");
+        check(!log.writable(), "open is read-only");
+        check(log.advise(ipc::access_hint::sequential, &error), "sequential hint");
+        check(holds_sequence(log, 1000), "reader view");
+        if (!log.advise(ipc::access_hint::hugepage, &error))
+            std::cout << "huge-page hint not applied: " << error << "\n";
+        error.clear();
+    }
+
+    {
+        ipc::mapped_record_file<SensorRecord> reader;
+        check(reader.open(path, &error), "open beside the writer");
+        ipc::mapped_record_file<SensorRecord> log;
+        check(log.open_append(path, &error), "open_append");
+        const std::size_t before = log.capacity();
+        std::vector<SensorRecord> batch;
+        for (std::uint64_t i = 1000; i < 100000; ++i) batch.push_back(make_record(i));
+        check(log.append(std::span<const SensorRecord>(batch), &error), "append after reopen");
+        check(log.capacity() > before, "append grows the file");
+        check(holds_sequence(log, 100000), "grown view");
+        check(holds_sequence(reader, 1000), "a reader keeps the records it opened with");
+    }
+
+    {
+        ipc::mapped_record_file<SensorRecord> log;
+        check(log.open(path, &error), "reopen");
+        check(holds_sequence(log, 100000), "reopened view");
+        std::cout << "read " << log.size() << " records of "
+                  << ipc::describe(log.stamp) << " in place\n";
+    }
+
+    ipc::mapped_record_file<IpcCommand> wrong;
+    if (wrong.open(path, &error)) {
+        std::cerr << "opened with a different layout\n";
+        ++failures;
+    } else {
+        std::cout << "rejected IpcCommand view: " << error << "\n";
+    }
+
+    std::remove(path.c_str());
+    return failures ? 1 : 0;
+}
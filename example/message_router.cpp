@@ -0,0 +1,135 @@
+// Layout-hash dispatch (ipc/router.hpp).
+//
+// Routes frames of three example types and checks that each reaches its
+// own handler overload on the received bytes in place, and that an unknown
+// hash, a wrong payload size and a misaligned payload land on the slow
+// path with the matching route_status.  A second router of 24 types covers
+// the slots past dispatch()'s switch.  Exits nonzero on any failure.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "compat_ci_types.hpp"
+
+#include <boost/typelayout/ipc/router.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+namespace tl = boost::typelayout;
+namespace ipc = boost::typelayout::ipc;
+
+using Bus = ipc::message_router<PacketHeader, SensorRecord, IpcCommand>;
+
+// Distinct layouts by size: Filler<K> is K words.
+template <std::size_t K>
+struct Filler {
+    std::uint32_t words[K];
+};
+
+template <std::size_t... K>
+ipc::message_router<Filler<K + 1>...> make_wide(std::index_sequence<K...>);
+using Wide = decltype(make_wide(std::make_index_sequence<24>{}));
+
+struct Seen {
+    const void*      at = nullptr;
+    int              type = -1;   // 0 PacketHeader, 1 SensorRecord, 2 IpcCommand
+    ipc::route_status unrouted = ipc::route_status::dispatched;
+};
+
+struct BusHandler {
+    Seen& seen;
+    void operator()(const PacketHeader& r) const { seen.at = &r; seen.type = 0; }
+    void operator()(const SensorRecord& r) const { seen.at = &r; seen.type = 1; }
+    void operator()(const IpcCommand& r)   const { seen.at = &r; seen.type = 2; }
+    void operator()(const ipc::unrouted_message& m) const { seen.unrouted = m.status; }
+};
+
+// No unrouted_message overload: the status is the only report.
+struct QuietHandler {
+    void operator()(const PacketHeader&) const {}
+    void operator()(const SensorRecord&) const {}
+    void operator()(const IpcCommand&) const {}
+};
+
+struct WideHandler {
+    std::size_t& words;
+    template <std::size_t K>
+    void operator()(const Filler<K>&) const { words = K; }
+};
+
+template <typename T>
+static int route(const T& record, int type) {
+    Seen seen;
+    const ipc::route_status status =
+        Bus::dispatch(tl::get_layout_hash<T>(), &record, sizeof(T), BusHandler{seen});
+    if (status != ipc::route_status::dispatched || seen.type != type || seen.at != &record) {
+        std::cerr << "FAILED: type " << type << " not dispatched in place\n";
+        return 1;
+    }
+    if (Bus::index_of(tl::get_layout_hash<T>()) != static_cast<std::size_t>(type)) {
+        std::cerr << "FAILED: index_of type " << type << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+static int refuse(std::uint64_t hash, const void* data, std::size_t size,
+                  ipc::route_status want, const char* what) {
+    Seen seen;
+    const ipc::route_status status = Bus::dispatch(hash, data, size, BusHandler{seen});
+    if (status != want || seen.unrouted != want || seen.type != -1) {
+        std::cerr << "FAILED: " << what << " not refused\n";
+        return 1;
+    }
+    return 0;
+}
+
+template <std::size_t... K>
+static int route_wide(std::index_sequence<K...>) {
+    int failures = 0;
+    auto one = [&]<std::size_t N>(const Filler<N>& record) {
+        std::size_t words = 0;
+        if (Wide::dispatch(tl::get_layout_hash<Filler<N>>(), &record, sizeof(record),
+                           WideHandler{words}) != ipc::route_status::dispatched ||
+            words != N) {
+            std::cerr << "FAILED: Filler<" << N << "> not dispatched\n";
+            ++failures;
+        }
+    };
+    (one(Filler<K + 1>{}), ...);
+    return failures;
+}
+
+int main() {
+    int failures = 0;
+
+    failures += route(PacketHeader{0x544c5031u, 1, 2, 0, 0}, 0);
+    failures += route(SensorRecord{1, 20.5f, 0.4f, 1013.0f, 7}, 1);
+    failures += route(IpcCommand{3, 0, -1, 1, {}}, 2);
+
+    alignas(8) unsigned char bytes[sizeof(SensorRecord) + 8] = {};
+    const std::uint64_t sensor = tl::get_layout_hash<SensorRecord>();
+    failures += refuse(0x0123456789abcdefull, bytes, sizeof(SensorRecord),
+                       ipc::route_status::unknown_type, "unknown hash");
+    failures += refuse(sensor, bytes, sizeof(SensorRecord) - 4,
+                       ipc::route_status::size_mismatch, "short payload");
+    failures += refuse(sensor, bytes + 1, sizeof(SensorRecord),
+                       ipc::route_status::misaligned, "misaligned payload");
+    if (Bus::index_of(0x0123456789abcdefull) != Bus::npos) {
+        std::cerr << "FAILED: index_of unknown hash\n";
+        ++failures;
+    }
+
+    if (Bus::dispatch(0x0123456789abcdefull, bytes, 8, QuietHandler{}) !=
+        ipc::route_status::unknown_type) {
+        std::cerr << "FAILED: unknown hash without a slow path\n";
+        ++failures;
+    }
+
+    failures += route_wide(std::make_index_sequence<Wide::type_count>{});
+
+    std::cout << (failures == 0 ? "all frames routed as expected\n" : "");
+    return failures == 0 ? 0 : 1;
+}
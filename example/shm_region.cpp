@@ -0,0 +1,60 @@
+// Layout-checked shared memory (ipc/shm_region.hpp).
+//
+// The parent creates a SharedMemRegion segment, a forked child attaches to
+// it by name and writes through the attached reference, and the parent
+// sees the write in place.  Attaching with the wrong type must fail at
+// attach time.  Exits nonzero on any failure.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "compat_ci_types.hpp"
+
+#include <boost/typelayout/ipc/shm_region.hpp>
+
+#include <iostream>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ipc = boost::typelayout::ipc;
+
+int main() {
+    const std::string name = "/typelayout_example." + std::to_string(::getpid());
+    std::string error;
+
+    ipc::shm_region<SharedMemRegion> region;
+    if (!region.create(name, &error)) {
+        std::cerr << "create: " << error << "\n";
+        return 1;
+    }
+    region->size = 4096;
+
+    pid_t child = ::fork();
+    if (child == 0) {
+        ipc::shm_region<SharedMemRegion> view;
+        if (!view.attach(name, &error)) {
+            std::cerr << "child attach: " << error << "\n";
+            ::_exit(1);
+        }
+        view->owner_pid = static_cast<std::uint32_t>(::getpid());
+        ::_exit(view->size == 4096 ? 0 : 1);
+    }
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 ||
+        region->owner_pid != static_cast<std::uint32_t>(child)) {
+        std::cerr << "child did not share the region\n";
+        return 1;
+    }
+
+    ipc::shm_region<IpcCommand> wrong;
+    if (wrong.attach(name, &error)) {
+        std::cerr << "attached with a different layout\n";
+        return 1;
+    }
+    std::cout << "rejected IpcCommand view: " << error << "\n";
+    std::cout << "shared " << ipc::describe(region.stamp) << "\n";
+    return 0;
+}
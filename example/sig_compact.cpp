@@ -0,0 +1,75 @@
+// Compact signature form (detail/sig_compact.hpp).
+//
+// Compacts a few repetitive signatures, checks that each expands back to
+// its full form byte for byte, and feeds the expander malformed compact
+// strings -- including repeat counts and numbers chosen to overflow its
+// bounds, nested repeat groups that multiply, and types nested too
+// deeply -- that must all be rejected promptly, with an empty result
+// rather than a long-running expansion.  Exits nonzero on any failure.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/detail/sig_compact.hpp>
+
+#include <iostream>
+#include <string>
+
+namespace tl = boost::typelayout;
+
+int main() {
+    int failures = 0;
+
+    const char* const full[] = {
+        "[64-le]record[s:16,a:4]{@0:u32[s:4,a:4],@4:u32[s:4,a:4],@8:u32[s:4,a:4],"
+        "@12:u32[s:4,a:4]}",
+        "[64-le]record[s:32,a:8]{@0:f64[s:8,a:8],@8:u32[s:4,a:4],@12:u32[s:4,a:4],"
+        "@16:f64[s:8,a:8],@24:u32[s:4,a:4],@28:u32[s:4,a:4]}",
+        "[64-le]record[s:24,a:4]{@0:record[s:12,a:4]{@0:f32[s:4,a:4],@4:f32[s:4,a:4],"
+        "@8:f32[s:4,a:4]},@12:record[s:12,a:4]{@0:f32[s:4,a:4],@4:f32[s:4,a:4],"
+        "@8:f32[s:4,a:4]}}",
+    };
+    for (const char* sig : full) {
+        const std::string compact = tl::compact_signature(sig);
+        if (!tl::is_compact_signature(compact) || tl::expand_signature(compact) != sig) {
+            std::cerr << "FAILED round trip: " << sig << "\n";
+            ++failures;
+        } else {
+            std::cout << compact << "\n";
+        }
+    }
+
+    // Types nested one level deeper than the expander accepts.
+    std::string too_deep = "[64-le]~";
+    for (std::size_t i = 0; i <= tl::detail::compact_max_depth; ++i)
+        too_deep += "array[s:1,a:1]<";
+    too_deep += "u8[s:1,a:1]";
+    for (std::size_t i = 0; i <= tl::detail::compact_max_depth; ++i)
+        too_deep += ",1>";
+
+    const std::string malformed[] = {
+        // count * group size wraps to a small number
+        "[64-le]~record[s:2,a:1]{@0*9223372036854775808+0{@0:u8[s:1,a:1],@1:u8[s:1,a:1]}}",
+        // empty group repeated 2^64 - 1 times
+        "[64-le]~record[s:2,a:1]{@0*18446744073709551615+0{}}",
+        // repeat count past uint64
+        "[64-le]~record[s:2,a:1]{@0*18446744073709551616+1:u8[s:1,a:1]}",
+        "[64-le]~record[s:2,a:1]{@0*99999999999999999999999+1:u8[s:1,a:1]}",
+        // more members than compact_max_members
+        "[64-le]~record[s:2,a:1]{@0*16777217+0:u8[s:1,a:1]}",
+        // truncated and unknown back-references
+        "[64-le]~record[s:2,a:1]{@0*2+1:u8[s:1,a:1]",
+        "[64-le]~record[s:2,a:1]{@0:^7}",
+        // nested repeat groups multiplying past compact_max_expanded
+        "[64-le]~record[s:1,a:1]{@0*4000+0:record[s:1,a:1]{@0*4000+0:u8[s:1,a:1]}}",
+        too_deep,
+    };
+    for (const std::string& sig : malformed) {
+        if (!tl::expand_signature(sig).empty()) {
+            std::cerr << "FAILED: expanded malformed " << sig << "\n";
+            ++failures;
+        }
+    }
+    if (!failures) std::cout << "rejected " << std::size(malformed) << " malformed signatures\n";
+    return failures ? 1 : 0;
+}
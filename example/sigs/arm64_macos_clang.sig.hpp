@@ -9,7 +9,7 @@
 //   - wchar_t: 4 bytes (same as Linux)
 //   - long double: 8 bytes (== double, unlike x86_64 Linux where it's 16)
 //   - pointer: 8 bytes
-//   - max_align_t: 16 bytes
+//   - max_align_t: 8 bytes (max_align_t is long double == double)
 
 #ifndef BOOST_TYPELAYOUT_SIG_ARM64_MACOS_CLANG_HPP
 #define BOOST_TYPELAYOUT_SIG_ARM64_MACOS_CLANG_HPP
@@ -27,7 +27,7 @@ inline constexpr std::size_t pointer_size      = 8;
 inline constexpr std::size_t sizeof_long        = 8;   // LP64: same as Linux
 inline constexpr std::size_t sizeof_wchar_t     = 4;   // same as Linux
 inline constexpr std::size_t sizeof_long_double = 8;   // ARM64: long double == double
-inline constexpr std::size_t max_align          = 16;
+inline constexpr std::size_t max_align          = 8;
 inline constexpr const char data_model[]        = "LP64";
 
 // ---- Type Signatures ----
@@ -36,26 +36,31 @@ inline constexpr const char data_model[]        = "LP64";
 inline constexpr const char PacketHeader_layout[] =
     "[64-le]record[s:16,a:4]{@0:u32[s:4,a:4],@4:u16[s:2,a:2],@6:u16[s:2,a:2],@8:u32[s:4,a:4],@12:u32[s:4,a:4]}";
 inline constexpr bool PacketHeader_byte_copy_safe = true;
+inline constexpr std::uint64_t PacketHeader_layout_hash = 0xd4c266213cbf208aull;
 
 // --- SharedMemRegion --- (SAME: all fixed-width types)
 inline constexpr const char SharedMemRegion_layout[] =
     "[64-le]record[s:24,a:8]{@0:u64[s:8,a:8],@8:u64[s:8,a:8],@16:u32[s:4,a:4],@20:u32[s:4,a:4]}";
 inline constexpr bool SharedMemRegion_byte_copy_safe = true;
+inline constexpr std::uint64_t SharedMemRegion_layout_hash = 0x8fa08825bc6a171dull;
 
 // --- FileHeader --- (SAME: char[], uint32_t, uint64_t)
 inline constexpr const char FileHeader_layout[] =
     "[64-le]record[s:24,a:8]{@0:bytes[s:4,a:1],@4:u32[s:4,a:4],@8:u64[s:8,a:8],@16:u32[s:4,a:4],@20:u32[s:4,a:4]}";
 inline constexpr bool FileHeader_byte_copy_safe = true;
+inline constexpr std::uint64_t FileHeader_layout_hash = 0xefb1e86ba97009a4ull;
 
 // --- SensorRecord --- (SAME: uint64_t, float, uint32_t)
 inline constexpr const char SensorRecord_layout[] =
     "[64-le]record[s:24,a:8]{@0:u64[s:8,a:8],@8:f32[s:4,a:4],@12:f32[s:4,a:4],@16:f32[s:4,a:4],@20:u32[s:4,a:4]}";
 inline constexpr bool SensorRecord_byte_copy_safe = true;
+inline constexpr std::uint64_t SensorRecord_layout_hash = 0x2b3f8ce6d27943e0ull;
 
 // --- IpcCommand --- (SAME: all fixed-width types + char[])
 inline constexpr const char IpcCommand_layout[] =
     "[64-le]record[s:88,a:8]{@0:u32[s:4,a:4],@4:u32[s:4,a:4],@8:i64[s:8,a:8],@16:i64[s:8,a:8],@24:bytes[s:64,a:1]}";
 inline constexpr bool IpcCommand_byte_copy_safe = true;
+inline constexpr std::uint64_t IpcCommand_layout_hash = 0x14a60dda7a6714a3ull;
 
 // --- UnsafeStruct --- (DIFFER: long double = 8B on ARM64 macOS vs 16B on x86_64 Linux)
 //
@@ -73,29 +78,32 @@ inline constexpr bool IpcCommand_byte_copy_safe = true;
 inline constexpr const char UnsafeStruct_layout[] =
     "[64-le]record[s:32,a:8]{@0:i64[s:8,a:8],@8:ptr[s:8,a:8],@16:wchar[s:4,a:4],@24:fld64[s:8,a:8]}";
 inline constexpr bool UnsafeStruct_byte_copy_safe = false;
+inline constexpr std::uint64_t UnsafeStruct_layout_hash = 0x16c6352707a7c3caull;
 
 // --- UnsafeWithPointer --- (SAME: uint32_t, ptr, uint64_t — pointer is 8B on both)
 inline constexpr const char UnsafeWithPointer_layout[] =
     "[64-le]record[s:24,a:8]{@0:u32[s:4,a:4],@8:ptr[s:8,a:8],@16:u64[s:8,a:8]}";
 inline constexpr bool UnsafeWithPointer_byte_copy_safe = false;
+inline constexpr std::uint64_t UnsafeWithPointer_layout_hash = 0x38cd7e10858a40d4ull;
 
 // --- MixedSafety --- (SAME: uint32_t, double, int — all identical on LP64)
 inline constexpr const char MixedSafety_layout[] =
     "[64-le]record[s:24,a:8]{@0:u32[s:4,a:4],@8:f64[s:8,a:8],@16:i32[s:4,a:4]}";
 inline constexpr bool MixedSafety_byte_copy_safe = true;
+inline constexpr std::uint64_t MixedSafety_layout_hash = 0x8920756a88338229ull;
 
 // ---- Type Registry ----
 
 
 inline constexpr ::boost::typelayout::TypeEntry types[] = {
-    {"PacketHeader", PacketHeader_layout, PacketHeader_byte_copy_safe},
-    {"SharedMemRegion", SharedMemRegion_layout, SharedMemRegion_byte_copy_safe},
-    {"FileHeader", FileHeader_layout, FileHeader_byte_copy_safe},
-    {"SensorRecord", SensorRecord_layout, SensorRecord_byte_copy_safe},
-    {"IpcCommand", IpcCommand_layout, IpcCommand_byte_copy_safe},
-    {"UnsafeStruct", UnsafeStruct_layout, UnsafeStruct_byte_copy_safe},
-    {"UnsafeWithPointer", UnsafeWithPointer_layout, UnsafeWithPointer_byte_copy_safe},
-    {"MixedSafety", MixedSafety_layout, MixedSafety_byte_copy_safe},
+    {"PacketHeader", PacketHeader_layout, PacketHeader_byte_copy_safe, PacketHeader_layout_hash},
+    {"SharedMemRegion", SharedMemRegion_layout, SharedMemRegion_byte_copy_safe, SharedMemRegion_layout_hash},
+    {"FileHeader", FileHeader_layout, FileHeader_byte_copy_safe, FileHeader_layout_hash},
+    {"SensorRecord", SensorRecord_layout, SensorRecord_byte_copy_safe, SensorRecord_layout_hash},
+    {"IpcCommand", IpcCommand_layout, IpcCommand_byte_copy_safe, IpcCommand_layout_hash},
+    {"UnsafeStruct", UnsafeStruct_layout, UnsafeStruct_byte_copy_safe, UnsafeStruct_layout_hash},
+    {"UnsafeWithPointer", UnsafeWithPointer_layout, UnsafeWithPointer_byte_copy_safe, UnsafeWithPointer_layout_hash},
+    {"MixedSafety", MixedSafety_layout, MixedSafety_byte_copy_safe, MixedSafety_layout_hash},
 };
 
 inline constexpr std::size_t type_count = 8;
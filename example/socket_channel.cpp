@@ -0,0 +1,190 @@
+// Layout-checked socket transport (ipc/socket_channel.hpp).
+//
+// Over a socketpair, a forked child registers the same types in another
+// order, receives batches of SensorRecords and a closing IpcCommand in
+// place, checks every record and its alignment, and answers with an
+// IpcCommand carrying the count it saw.  A second pair of channels whose
+// types differ must fail the handshake on both ends.  A third pair
+// registers 256 types (8 KB of stamps each way) over sockets whose
+// buffers are shrunk below that, and must still complete the handshake.
+// Exits nonzero on any failure.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "compat_ci_types.hpp"
+
+#include <boost/typelayout/ipc/socket_channel.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ipc = boost::typelayout::ipc;
+
+namespace {
+
+// Distinct layouts by size, for a type list larger than a socket buffer.
+template <std::size_t K>
+struct Filler {
+    std::uint32_t words[K];
+};
+
+template <std::size_t... K>
+ipc::socket_channel<Filler<K + 1>...> make_wide(std::index_sequence<K...>);
+using WideLink = decltype(make_wide(std::make_index_sequence<256>{}));
+
+constexpr std::uint32_t cmd_done = 1;
+constexpr std::uint32_t cmd_ack = 2;
+
+/// Child side: receives until the closing command, then acknowledges.
+int serve(int fd) {
+    ipc::socket_channel<IpcCommand, SensorRecord> link;   // other order
+    std::string error;
+    if (!link.open_fd(fd, &error)) {
+        std::cerr << "child: " << error << "\n";
+        return 1;
+    }
+    std::uint64_t next = 0;
+    bool ok = true, done = false;
+    struct Handler {
+        std::uint64_t& next;
+        bool& ok;
+        bool& done;
+        void operator()(std::span<const SensorRecord> records) const {
+            if (reinterpret_cast<std::uintptr_t>(records.data()) % alignof(SensorRecord))
+                ok = false;
+            for (const SensorRecord& r : records)
+                if (r.timestamp_ns != next++ || r.sensor_id != r.timestamp_ns % 8) ok = false;
+        }
+        void operator()(std::span<const IpcCommand> commands) const {
+            for (const IpcCommand& c : commands)
+                if (c.cmd_id == cmd_done) done = true;
+        }
+    };
+    while (!done) {
+        if (!link.receive(Handler{next, ok, done}, &error)) {
+            std::cerr << "child: " << error << "\n";
+            return 1;
+        }
+    }
+    IpcCommand ack{cmd_ack, ok ? 0u : 1u, static_cast<std::int64_t>(next), 0, {}};
+    return link.send(std::span<const IpcCommand>(&ack, 1), &error) ? 0 : 1;
+}
+
+bool wait_child(pid_t pid) {
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+} // namespace
+
+int main() {
+    std::string error;
+    int pair[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+        std::cerr << "socketpair failed\n";
+        return 1;
+    }
+    pid_t child = ::fork();
+    if (child == 0) {
+        ::close(pair[0]);
+        ::_exit(serve(pair[1]));
+    }
+    ::close(pair[1]);
+
+    ipc::socket_channel<SensorRecord, IpcCommand> link;
+    if (!link.open_fd(pair[0], &error)) {
+        std::cerr << "parent: " << error << "\n";
+        return 1;
+    }
+
+    // 100 batches of 1000 records, queued 10 at a time and sent with one
+    // gather write each.
+    constexpr std::uint64_t total = 100000;
+    std::vector<SensorRecord> records(total);
+    for (std::uint64_t i = 0; i < total; ++i)
+        records[i] = {i, 20.0f, 0.5f, 1013.0f, static_cast<std::uint32_t>(i % 8)};
+    const std::span<const SensorRecord> all(records);
+    for (std::size_t at = 0; at < total; at += 1000) {
+        link.queue(all.subspan(at, 1000));
+        if ((at / 1000) % 10 == 9 && !link.flush(&error)) {
+            std::cerr << "parent: " << error << "\n";
+            return 1;
+        }
+    }
+    const IpcCommand done{cmd_done, 0, 0, 0, {}};
+    if (!link.send(std::span<const IpcCommand>(&done, 1), &error)) {
+        std::cerr << "parent: " << error << "\n";
+        return 1;
+    }
+
+    std::int64_t seen = -1;
+    std::uint32_t flags = 1;
+    auto on_ack = [&](auto batch) {
+        if constexpr (std::is_same_v<typename decltype(batch)::value_type, IpcCommand>)
+            for (const IpcCommand& c : batch)
+                if (c.cmd_id == cmd_ack) seen = c.arg1, flags = c.flags;
+    };
+    while (seen < 0) {
+        if (!link.receive(on_ack, &error)) {
+            std::cerr << "parent: " << error << "\n";
+            return 1;
+        }
+    }
+    if (!wait_child(child) || flags != 0 || seen != static_cast<std::int64_t>(total)) {
+        std::cerr << "child saw " << seen << " of " << total << " records"
+                  << (flags ? ", some out of order or misaligned" : "") << "\n";
+        return 1;
+    }
+    std::cout << "sent " << total << " SensorRecords in place, acknowledged\n";
+
+    // Mismatched type sets: both handshakes fail.
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) return 1;
+    child = ::fork();
+    if (child == 0) {
+        ::close(pair[0]);
+        ipc::socket_channel<PacketHeader> other;
+        ::_exit(other.open_fd(pair[1]) ? 1 : 0);
+    }
+    ::close(pair[1]);
+    ipc::socket_channel<SensorRecord> mine;
+    if (mine.open_fd(pair[0], &error) || !wait_child(child)) {
+        std::cerr << "handshake accepted a different layout\n";
+        return 1;
+    }
+    std::cout << "rejected PacketHeader peer: " << error << "\n";
+
+    // Both ends send 8 KB of stamps into buffers of about 4 KB: each has
+    // to read while it writes.
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) return 1;
+    for (int fd : pair) {
+        int bytes = 4096;
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &bytes, sizeof(bytes));
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes));
+    }
+    child = ::fork();
+    if (child == 0) {
+        ::close(pair[0]);
+        WideLink other;
+        ::_exit(other.open_fd(pair[1]) ? 0 : 1);
+    }
+    ::close(pair[1]);
+    WideLink wide;
+    if (!wide.open_fd(pair[0], &error) || !wait_child(child)) {
+        std::cerr << "handshake of " << WideLink::type_count << " types failed: " << error
+                  << "\n";
+        return 1;
+    }
+    std::cout << "handshake of " << WideLink::type_count << " types over small buffers\n";
+    return 0;
+}
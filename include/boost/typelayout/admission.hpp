@@ -3,9 +3,10 @@
 // is_byte_copy_safe_v<T> determines whether type T is safe for byte-level
 // transport (memcpy to a buffer, send over network, write to shared memory).
 //
-// Safety is determined by scanning the Layout Signature for pointer tokens
-// (ptr, fnptr, memptr, ref, rref, vptr) plus recursive member checking.
-// Polymorphic types are caught via the vptr token in their signature.
+// Safety is determined by the structural pointer_free flag carried by every
+// TypeSignature (no ptr, fnptr, memptr, ref, rref or vptr anywhere in the
+// layout) plus recursive member checking.  Polymorphic types are caught
+// because their vptr clears pointer_free.
 //
 //
 // Copyright (c) 2024-2026 TypeLayout Development Team
@@ -16,6 +17,7 @@
 
 #include <boost/typelayout/layout_traits.hpp>
 #include <type_traits>
+#include <utility>
 
 namespace boost {
 namespace typelayout {
@@ -27,38 +29,26 @@ namespace detail {
 template <typename T>
 consteval bool is_byte_copy_safe_impl() noexcept;
 
+// One step of the member and base walks below.  std::conjunction only
+// instantiates a step's value once every earlier step was true, so a walk
+// stops at the first unsafe member or base.
+template <typename T>
+struct byte_copy_safe_step : std::bool_constant<is_byte_copy_safe_impl<T>()> {};
+
 // Check whether all non-static data members of T are byte-copy safe.
-template <typename T, std::size_t I, std::size_t N>
-consteval bool all_members_byte_copy_safe() noexcept {
-    if constexpr (I >= N) {
-        return true;
-    } else {
-        using namespace std::meta;
-        constexpr auto member = nonstatic_data_members_of(^^T, access_context::unchecked())[I];
-        using FieldType = [:type_of(member):];
-        if constexpr (!is_byte_copy_safe_impl<FieldType>()) {
-            return false;
-        } else {
-            return all_members_byte_copy_safe<T, I + 1, N>();
-        }
-    }
+// One pack expansion over the cached member array: a single instantiation
+// per class, plus one is_byte_copy_safe_impl per distinct member type.
+template <typename T, std::size_t... Is>
+consteval bool all_members_byte_copy_safe(std::index_sequence<Is...>) noexcept {
+    return std::conjunction_v<byte_copy_safe_step<
+        typename [:std::meta::type_of(reflected_members_v<T>[Is]):]>...>;
 }
 
 // Check whether all base classes of T are byte-copy safe.
-template <typename T, std::size_t I, std::size_t N>
-consteval bool all_bases_byte_copy_safe() noexcept {
-    if constexpr (I >= N) {
-        return true;
-    } else {
-        using namespace std::meta;
-        constexpr auto base_info = bases_of(^^T, access_context::unchecked())[I];
-        using BaseType = [:type_of(base_info):];
-        if constexpr (!is_byte_copy_safe_impl<BaseType>()) {
-            return false;
-        } else {
-            return all_bases_byte_copy_safe<T, I + 1, N>();
-        }
-    }
+template <typename T, std::size_t... Is>
+consteval bool all_bases_byte_copy_safe(std::index_sequence<Is...>) noexcept {
+    return std::conjunction_v<byte_copy_safe_step<
+        typename [:std::meta::type_of(reflected_bases_v<T>[Is]):]>...>;
 }
 
 // Core decision tree for byte-copy safety.
@@ -82,13 +72,15 @@ consteval bool is_byte_copy_safe_impl() noexcept {
         return true;
     }
     // Branch 3: Class or union -- recurse members (and bases for classes)
-    // Polymorphic types: vptr is encoded in the signature as a pointer token,
-    //   so Branch 2 already rejects them (has_pointer = true).
+    // Polymorphic types: the vptr clears pointer_free, so Branch 2 already
+    //   rejects them (has_pointer = true).
     else if constexpr (std::is_class_v<Bare> || std::is_union_v<Bare>) {
         constexpr std::size_t bc = std::is_union_v<Bare> ? 0 : get_base_count<Bare>();
         constexpr std::size_t fc = get_member_count<Bare>();
-        return all_bases_byte_copy_safe<Bare, 0, bc>() &&
-               all_members_byte_copy_safe<Bare, 0, fc>();
+        if constexpr (!all_bases_byte_copy_safe<Bare>(std::make_index_sequence<bc>{}))
+            return false;
+        else
+            return all_members_byte_copy_safe<Bare>(std::make_index_sequence<fc>{});
     }
     // Branch 4: Otherwise not safe (e.g. bare function types)
     else {
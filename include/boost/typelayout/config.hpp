@@ -20,9 +20,17 @@
 // Core headers (signature generation, layout_traits, classify, admission)
 // require P2996.  Tools-layer headers marked "C++17, no P2996" do not.
 
-#if defined(__cpp_reflection) || defined(__cpp_impl_reflection) || \
-    (defined(__clang__) && __has_feature(cxx_reflection))
+// __has_feature is tested in its own #if: compilers without it (GCC before
+// 14, MSVC) reject the call even behind a false defined(__clang__).
+
+#if defined(__cpp_reflection) || defined(__cpp_impl_reflection)
     #define BOOST_TYPELAYOUT_HAS_REFLECTION 1
+#elif defined(__clang__) && defined(__has_feature)
+    #if __has_feature(cxx_reflection)
+        #define BOOST_TYPELAYOUT_HAS_REFLECTION 1
+    #else
+        #define BOOST_TYPELAYOUT_HAS_REFLECTION 0
+    #endif
 #else
     #define BOOST_TYPELAYOUT_HAS_REFLECTION 0
 #endif
@@ -0,0 +1,98 @@
+// layout_hash.hpp -- Fixed-size hashes of layout signature strings.
+//
+// The layout hash is FNV-1a (64-bit or 128-bit) over the bytes of the
+// full canonical signature, arch prefix included, without a terminator:
+//
+//   h = offset_basis
+//   for each byte b:  h = (h ^ b) * prime        (mod 2^64 / 2^128)
+//
+//   64-bit:  offset_basis = 0xcbf29ce484222325
+//            prime        = 0x00000100000001b3
+//   128-bit: offset_basis = 0x6c62272e07bb014262b821756295c58d
+//            prime        = 0x0000000001000000000000000000013b
+//
+// The algorithm is part of the exported data format: it must never change
+// for a given signature grammar, since hashes from different builds and
+// toolchains are compared against each other.  Equal signatures always
+// hash equal; unequal hashes prove a mismatch.  Equal hashes are accepted
+// as a match -- compare the strings when a diagnostic is needed.
+//
+// Reflection-free; usable by the tools layer.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_DETAIL_LAYOUT_HASH_HPP
+#define BOOST_TYPELAYOUT_DETAIL_LAYOUT_HASH_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+
+/// 128-bit layout hash, most significant half first.
+struct layout_hash128 {
+    std::uint64_t hi;
+    std::uint64_t lo;
+
+    friend constexpr bool operator==(const layout_hash128&,
+                                     const layout_hash128&) noexcept = default;
+};
+
+namespace detail {
+
+inline constexpr std::uint64_t fnv1a_64_offset_basis = 0xcbf29ce484222325ull;
+inline constexpr std::uint64_t fnv1a_64_prime        = 0x00000100000001b3ull;
+
+constexpr std::uint64_t fnv1a_64(std::string_view bytes) noexcept {
+    std::uint64_t h = fnv1a_64_offset_basis;
+    for (char c : bytes) {
+        h ^= static_cast<unsigned char>(c);
+        h *= fnv1a_64_prime;
+    }
+    return h;
+}
+
+// FNV-1a 128.  The prime is 2^88 + 0x13b, so h * prime reduces to
+// (h << 88) + h * 0x13b; no 128-bit integer type is required.
+constexpr layout_hash128 fnv1a_128(std::string_view bytes) noexcept {
+    std::uint64_t hi = 0x6c62272e07bb0142ull;
+    std::uint64_t lo = 0x62b821756295c58dull;
+    for (char c : bytes) {
+        lo ^= static_cast<unsigned char>(c);
+
+        // (hi:lo) * 0x13b, split into 32-bit limbs to keep the carry.
+        constexpr std::uint64_t k = 0x13b;
+        std::uint64_t lo_lo = (lo & 0xffffffffull) * k;
+        std::uint64_t lo_hi = (lo >> 32) * k + (lo_lo >> 32);
+        std::uint64_t new_lo = (lo_hi << 32) | (lo_lo & 0xffffffffull);
+        std::uint64_t new_hi = hi * k + (lo_hi >> 32);
+
+        // + (hi:lo) << 88 -- only the low half of the input survives.
+        new_hi += lo << 24;
+
+        hi = new_hi;
+        lo = new_lo;
+    }
+    return {hi, lo};
+}
+
+} // namespace detail
+
+/// Layout hash of a signature string (see the header comment for the
+/// algorithm).  get_layout_hash<T>() == layout_hash(get_layout_signature<T>()).
+constexpr std::uint64_t layout_hash(std::string_view signature) noexcept {
+    return detail::fnv1a_64(signature);
+}
+
+constexpr layout_hash128 layout_hash_128(std::string_view signature) noexcept {
+    return detail::fnv1a_128(signature);
+}
+
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_DETAIL_LAYOUT_HASH_HPP
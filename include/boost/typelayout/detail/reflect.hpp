@@ -14,43 +14,87 @@
     #include <experimental/meta>
 #endif
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace boost {
 namespace typelayout {
 inline namespace v1 {
 namespace detail {
 
+    // Non-static data members / direct bases of T, reflected once per type.
+    // Index into these instead of re-running the queries per member: every
+    // call to nonstatic_data_members_of rebuilds the whole vector, so
+    // indexing the query result inside a per-member template is quadratic.
+    template <typename T>
+    inline constexpr auto reflected_members_v = std::define_static_array(
+        std::meta::nonstatic_data_members_of(^^T, std::meta::access_context::unchecked()));
+
+    template <typename T>
+    inline constexpr auto reflected_bases_v = std::define_static_array(
+        std::meta::bases_of(^^T, std::meta::access_context::unchecked()));
+
     template <typename T>
     consteval std::size_t get_member_count() noexcept {
-        return std::meta::nonstatic_data_members_of(^^T, std::meta::access_context::unchecked()).size();
+        return reflected_members_v<T>.size();
     }
 
     template <typename T>
     consteval std::size_t get_base_count() noexcept {
-        return std::meta::bases_of(^^T, std::meta::access_context::unchecked()).size();
+        return reflected_bases_v<T>.size();
+    }
+
+    // Named, complete class types declared directly in namespace `ns`
+    // (nested namespaces are not entered), in declaration order.  With
+    // `annotated_only`, classes annotated [[=export_layout]]; otherwise
+    // every trivially copyable one.
+    consteval std::vector<std::meta::info> namespace_classes(std::meta::info ns,
+                                                             bool annotated_only) {
+        std::vector<std::meta::info> classes;
+        for (std::meta::info m :
+             std::meta::members_of(ns, std::meta::access_context::unchecked())) {
+            if (!std::meta::is_type(m) || std::meta::is_type_alias(m) ||
+                !std::meta::has_identifier(m) || !std::meta::is_class_type(m) ||
+                !std::meta::is_complete_type(m))
+                continue;
+            bool selected = annotated_only
+                ? !std::meta::annotations_of_with_type(m, ^^export_layout_t).empty()
+                : std::meta::is_trivially_copyable_type(m);
+            if (selected) classes.push_back(m);
+        }
+        return classes;
     }
 
+    // namespace_classes(NS, AnnotatedOnly), reflected once per namespace.
+    template <std::meta::info NS, bool AnnotatedOnly>
+    inline constexpr auto namespace_classes_v =
+        std::define_static_array(namespace_classes(NS, AnnotatedOnly));
+
     // Recursively check for virtual inheritance in T's base hierarchy.
     template <typename T>
     consteval bool has_virtual_base() noexcept;
 
-    template <typename T, std::size_t I, std::size_t N>
-    consteval bool any_base_is_virtual() noexcept {
-        if constexpr (I >= N) return false;
-        else {
-            constexpr auto base_info =
-                std::meta::bases_of(^^T, std::meta::access_context::unchecked())[I];
-            using BaseType = [:std::meta::type_of(base_info):];
-            if constexpr (std::meta::is_virtual(base_info)) return true;
-            else if constexpr (has_virtual_base<BaseType>()) return true;
-            else return any_base_is_virtual<T, I + 1, N>();
-        }
+    template <typename T, std::size_t I>
+    consteval bool base_is_or_has_virtual() noexcept {
+        constexpr auto base = reflected_bases_v<T>[I];
+        if constexpr (std::meta::is_virtual(base)) return true;
+        else return has_virtual_base<typename [:std::meta::type_of(base):]>();
+    }
+
+    // std::disjunction instantiates steps only up to the first true one,
+    // so the search stops at the first virtual base it finds.
+    template <typename T, std::size_t I>
+    struct virtual_base_step : std::bool_constant<base_is_or_has_virtual<T, I>()> {};
+
+    template <typename T, std::size_t... Is>
+    consteval bool any_base_is_virtual(std::index_sequence<Is...>) noexcept {
+        return std::disjunction_v<virtual_base_step<T, Is>...>;
     }
 
     template <typename T>
     consteval bool has_virtual_base() noexcept {
         if constexpr (!std::is_class_v<T>) return false;
-        else return any_base_is_virtual<T, 0, get_base_count<T>()>();
+        else return any_base_is_virtual<T>(std::make_index_sequence<get_base_count<T>()>{});
     }
 
 } // namespace detail
@@ -0,0 +1,468 @@
+// sig_compact.hpp -- Compact (run-length / back-reference) signature form.
+//
+// Flattening inlines every nested record, so repetitive layouts -- long
+// runs of identical scalars, a book of identical price levels, the same
+// element record in several arrays -- produce long, highly redundant
+// signatures.  The compact form is an optional re-encoding of the same
+// string:
+//
+//   compact-signature ::= arch-prefix '~' ctype
+//   ctype             ::= type-signature, with every member-list replaced
+//                         by a cmember-list and every nested type by a ctype
+//                       | '^' index
+//   cmember-list      ::= '' | cmember (',' cmember)*
+//   cmember           ::= member
+//                       | '@' offset '*' count '+' stride ':' ctype
+//                       | '@' offset '*' count '+' stride '{' cmember-list '}'
+//
+//   - "@o*k+d:T"  is k members "@o:T", "@o+d:T", ..., "@o+(k-1)d:T".
+//   - "@o*k+d{M}" repeats the member group M, whose offsets are relative
+//     to the group, k times at o, o+d, ..., o+(k-1)d.
+//   - "^i" is the i-th record/union written out in full, numbered from 0
+//     in order of appearance in the compact string.
+//
+// compact_signature() is canonical -- a function of the full signature
+// with fixed rules -- so two compact signatures are equal iff their
+// expansions are.  expand_signature() restores the full signature byte
+// for byte.  Layout hashes are always computed over the full form.
+//
+// Compaction rules:
+//   - At each member the run covering the most members is taken (period
+//     1..compact_max_period members, at least 2 repetitions, constant
+//     stride, no group member before the group start); ties go to the
+//     shorter period.  Period-1 runs of plain fields use the ':' form.
+//   - A record/union whose full text equals an earlier one is "^i".
+//
+// Reflection-free; usable by the tools layer.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_DETAIL_SIG_COMPACT_HPP
+#define BOOST_TYPELAYOUT_DETAIL_SIG_COMPACT_HPP
+
+#include <boost/typelayout/detail/sig_parser.hpp>
+#include <boost/typelayout/detail/layout_hash.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace detail {
+
+inline constexpr std::size_t compact_max_period = 64;
+
+// Bounds that keep the expander safe on hostile input.  One cmember-list
+// may expand to at most compact_max_members members; types may nest at
+// most compact_max_depth deep; and the expander produces at most
+// compact_max_expanded bytes in total, so nested repeat groups cannot
+// multiply past it.  Text of a nested record counts once for each
+// enclosing level it is copied into, which also bounds the work done.
+inline constexpr std::uint64_t compact_max_members  = std::uint64_t(1) << 24;
+inline constexpr std::size_t   compact_max_depth    = 256;
+inline constexpr std::uint64_t compact_max_expanded = std::uint64_t(1) << 26;
+
+constexpr void append_decimal(std::string& out, std::uint64_t v) {
+    char digits[20] = {};
+    std::size_t n = 0;
+    do { digits[n++] = char('0' + v % 10); v /= 10; } while (v > 0);
+    while (n > 0) out += digits[--n];
+}
+
+/// Length of the arch prefix ("[64-le]") at the start of `sig`, or 0.
+constexpr std::size_t arch_prefix_length(std::string_view sig) noexcept {
+    if (sig.empty() || sig[0] != '[') return 0;
+    std::size_t close = sig.find(']');
+    return close == std::string_view::npos ? 0 : close + 1;
+}
+
+/// Full signature -> compact form, walking a parsed SigAst.
+class SigCompactor {
+public:
+    constexpr explicit SigCompactor(const SigAst& ast) : ast_(ast) {}
+
+    constexpr std::string compact() {
+        std::string out;
+        out.reserve(ast_.signature().size());
+        out += ast_.signature().substr(0, ast_.result().type_begin);
+        out += '~';
+        emit_type(ast_.result().root, out);
+        return out;
+    }
+
+private:
+    struct Member {
+        std::uint32_t    node;
+        std::uint32_t    rest_begin;   // first char after the byte offset
+        std::uint64_t    offset;
+        std::string_view rest;         // ":type" or ".bit:bits<...>"
+        std::uint64_t    hash;
+    };
+
+    const SigAst&                 ast_;
+    std::vector<std::string_view> records_;   // back-reference table
+
+    // Copy [from, n.end) replacing every child node by its compact form.
+    constexpr void emit_span(const SigNode& n, std::uint32_t from, std::string& out) {
+        std::string_view sig = ast_.signature();
+        std::uint32_t pos = from;
+        for (std::uint32_t c = n.first_child; c != sig_no_node;
+             c = ast_.node(c).next_sibling) {
+            const SigNode& child = ast_.node(c);
+            out += sig.substr(pos, child.begin - pos);
+            emit_type(c, out);
+            pos = child.end;
+        }
+        out += sig.substr(pos, n.end - pos);
+    }
+
+    constexpr void emit_type(std::uint32_t idx, std::string& out) {
+        const SigNode& n = ast_.node(idx);
+        if (n.kind != SigNodeKind::Record && n.kind != SigNodeKind::Union) {
+            emit_span(n, n.begin, out);
+            return;
+        }
+        std::string_view text = ast_.text(n);
+        for (std::size_t k = 0; k < records_.size(); ++k) {
+            if (records_[k] == text) {
+                out += '^';
+                append_decimal(out, k);
+                return;
+            }
+        }
+        records_.push_back(text);
+        out += ast_.head(n);
+        out += '{';
+        emit_members(n, out);
+        out += '}';
+    }
+
+    constexpr void emit_member(const Member& m, std::uint64_t offset, std::string& out) {
+        out += '@';
+        append_decimal(out, offset);
+        emit_span(ast_.node(m.node), m.rest_begin, out);
+    }
+
+    // Same member text at the same offset relative to its block start.
+    static constexpr bool repeats(const Member& a, const Member& b,
+                                  std::uint64_t shift) noexcept {
+        return a.hash == b.hash && b.offset == a.offset + shift && a.rest == b.rest;
+    }
+
+    // Best run starting at members[i]: {period, repetitions}; {1, 1} if none.
+    static constexpr std::pair<std::size_t, std::size_t>
+    best_run(const std::vector<Member>& ms, std::size_t i) noexcept {
+        std::size_t best_m = 1, best_k = 1;
+        const std::size_t n = ms.size();
+        for (std::size_t m = 1; m <= compact_max_period && i + 2 * m <= n; ++m) {
+            if (ms[i + m - 1].offset < ms[i].offset) break;   // member before group start
+            if (ms[i + m].offset < ms[i].offset) continue;
+            const std::uint64_t stride = ms[i + m].offset - ms[i].offset;
+            std::size_t k = 1;
+            while (i + (k + 1) * m <= n) {
+                bool same = true;
+                for (std::size_t j = 0; j < m && same; ++j)
+                    same = repeats(ms[i + j], ms[i + k * m + j], k * stride);
+                if (!same) break;
+                ++k;
+            }
+            if (k >= 2 && k * m > best_k * best_m) {
+                best_m = m;
+                best_k = k;
+                if (i + k * m == n) break;
+            }
+        }
+        return {best_m, best_k};
+    }
+
+    constexpr void emit_members(const SigNode& owner, std::string& out) {
+        std::string_view sig = ast_.signature();
+        std::vector<Member> ms;
+        ms.reserve(owner.child_count);
+        for (std::uint32_t c = owner.first_child; c != sig_no_node;
+             c = ast_.node(c).next_sibling) {
+            const SigNode& f = ast_.node(c);
+            std::uint32_t rest = f.name_begin;
+            while (rest < f.end && sig[rest] >= '0' && sig[rest] <= '9') ++rest;
+            std::string_view text = sig.substr(rest, f.end - rest);
+            ms.push_back({c, rest, f.offset, text, fnv1a_64(text)});
+        }
+
+        for (std::size_t i = 0; i < ms.size(); ) {
+            if (i > 0) out += ',';
+            auto [m, k] = best_run(ms, i);
+            if (k < 2) {
+                emit_member(ms[i], ms[i].offset, out);
+                ++i;
+                continue;
+            }
+            out += '@';
+            append_decimal(out, ms[i].offset);
+            out += '*';
+            append_decimal(out, k);
+            out += '+';
+            append_decimal(out, ms[i + m].offset - ms[i].offset);
+            if (m == 1 && ast_.node(ms[i].node).kind == SigNodeKind::Field) {
+                emit_span(ast_.node(ms[i].node), ms[i].rest_begin, out);
+            } else {
+                out += '{';
+                for (std::size_t j = 0; j < m; ++j) {
+                    if (j > 0) out += ',';
+                    emit_member(ms[i + j], ms[i + j].offset - ms[i].offset, out);
+                }
+                out += '}';
+            }
+            i += m * k;
+        }
+    }
+};
+
+/// Compact form -> full signature.
+class SigExpander {
+public:
+    constexpr explicit SigExpander(std::string_view sig) noexcept : s_(sig) {}
+
+    /// Appends the full signature to `out`; false if `sig` is malformed.
+    constexpr bool expand(std::string& out) {
+        std::size_t prefix = arch_prefix_length(s_);
+        out += s_.substr(0, prefix);
+        pos_ = prefix;
+        expect('~');
+        if (ok_) parse_type(out);
+        return ok_ && pos_ == s_.size();
+    }
+
+private:
+    struct Member {
+        std::uint64_t offset;
+        std::string   rest;
+    };
+
+    std::string_view         s_;
+    std::size_t              pos_ = 0;
+    bool                     ok_  = true;
+    std::vector<std::string> records_;   // full text; empty while open
+    std::size_t              depth_ = 0;
+    std::uint64_t            expanded_ = 0;   // bytes produced so far
+
+    static constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+    static constexpr bool is_alnum(char c) noexcept {
+        return is_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    constexpr char peek() const noexcept { return pos_ < s_.size() ? s_[pos_] : '\0'; }
+
+    constexpr bool accept(char c) noexcept {
+        if (peek() != c) return false;
+        ++pos_;
+        return true;
+    }
+
+    constexpr void expect(char c) noexcept {
+        if (ok_ && !accept(c)) ok_ = false;
+    }
+
+    constexpr std::uint64_t number() noexcept {
+        std::size_t start = pos_;
+        std::uint64_t v = 0;
+        while (pos_ < s_.size() && is_digit(s_[pos_])) {
+            std::uint64_t d = std::uint64_t(s_[pos_++] - '0');
+            if (v > (std::numeric_limits<std::uint64_t>::max() - d) / 10) {
+                ok_ = false;   // overflows uint64
+                return 0;
+            }
+            v = v * 10 + d;
+        }
+        if (pos_ == start) ok_ = false;
+        return v;
+    }
+
+    // Counts `bytes` more output against compact_max_expanded.
+    constexpr bool produce(std::uint64_t bytes) noexcept {
+        if (bytes > compact_max_expanded - expanded_) {
+            ok_ = false;
+            return false;
+        }
+        expanded_ += bytes;
+        return true;
+    }
+
+    // Copy characters up to and including `stop`.
+    constexpr void copy_through(char stop, std::string& out) {
+        std::size_t end = s_.find(stop, pos_);
+        if (end == std::string_view::npos) { ok_ = false; return; }
+        out += s_.substr(pos_, end + 1 - pos_);
+        pos_ = end + 1;
+    }
+
+    constexpr void parse_type(std::string& out) {
+        if (depth_ == compact_max_depth) {
+            ok_ = false;
+            return;
+        }
+        ++depth_;
+        parse_type_at_depth(out);
+        --depth_;
+    }
+
+    constexpr void parse_type_at_depth(std::string& out) {
+        if (accept('^')) {
+            std::uint64_t k = number();
+            if (!ok_ || k >= records_.size() || records_[k].empty()) { ok_ = false; return; }
+            if (produce(records_[k].size())) out += records_[k];
+            return;
+        }
+        std::size_t start = out.size();
+        std::size_t name_begin = pos_;
+        if (s_.substr(pos_, 2) == "O(") {
+            copy_through(')', out);
+        } else {
+            while (pos_ < s_.size() && is_alnum(s_[pos_])) ++pos_;
+            if (pos_ == name_begin) { ok_ = false; return; }
+            out += s_.substr(name_begin, pos_ - name_begin);
+            if (peek() == '[') copy_through(']', out);
+        }
+        if (!ok_) return;
+
+        std::string_view name = s_.substr(name_begin, pos_ - name_begin);
+        if (peek() == '{' && (name.starts_with("record[") || name.starts_with("union["))) {
+            std::size_t index = records_.size();
+            records_.emplace_back();
+            ++pos_;
+            std::vector<Member> ms;
+            if (peek() != '}') {
+                do { parse_member(ms); } while (ok_ && accept(','));
+            }
+            expect('}');
+            if (!ok_) return;
+            out += '{';
+            for (std::size_t i = 0; i < ms.size(); ++i) {
+                if (i > 0) out += ',';
+                out += '@';
+                append_decimal(out, ms[i].offset);
+                out += ms[i].rest;
+            }
+            out += '}';
+            if (!produce(out.size() - start)) return;
+            records_[index] = out.substr(start);
+        } else if (accept('<')) {                  // enum, array, opaque args
+            out += '<';
+            while (ok_) {
+                if (is_digit(peek())) append_decimal(out, number());
+                else parse_type(out);
+                if (!accept(',')) break;
+                out += ',';
+            }
+            expect('>');
+            out += '>';
+        }
+    }
+
+    // ":type" or ".bit:bits<width,leaf>"
+    constexpr std::string parse_rest() {
+        std::string rest;
+        if (accept('.')) {
+            rest += '.';
+            append_decimal(rest, number());
+            expect(':');
+            if (ok_ && s_.substr(pos_, 5) == "bits<") pos_ += 5;
+            else ok_ = false;
+            rest += ":bits<";
+            append_decimal(rest, number());
+            expect(',');
+            rest += ',';
+            if (ok_) parse_type(rest);
+            expect('>');
+            rest += '>';
+        } else {
+            expect(':');
+            rest += ':';
+            if (ok_) parse_type(rest);
+        }
+        return rest;
+    }
+
+    constexpr void parse_member(std::vector<Member>& ms) {
+        expect('@');
+        std::uint64_t offset = number();
+        if (!ok_) return;
+        if (!accept('*')) {
+            ms.push_back({offset, parse_rest()});
+            return;
+        }
+        std::uint64_t count = number();
+        expect('+');
+        std::uint64_t stride = number();
+        if (!ok_) return;
+
+        std::vector<Member> group;
+        if (peek() == '{') {
+            ++pos_;
+            if (peek() != '}') {
+                do { parse_member(group); } while (ok_ && accept(','));
+            }
+            expect('}');
+        } else {
+            group.push_back({0, parse_rest()});
+        }
+        // An empty group expands to nothing but still costs `count` loop
+        // trips; the bounds are divisions so a huge count cannot wrap them.
+        if (!ok_ || group.empty() ||
+            count > (compact_max_members - ms.size()) / group.size()) {
+            ok_ = false;
+            return;
+        }
+        std::uint64_t group_bytes = 0;
+        for (const Member& g : group) group_bytes += g.rest.size() + 1;
+        if (count > (compact_max_expanded - expanded_) / group_bytes) {
+            ok_ = false;
+            return;
+        }
+        expanded_ += count * group_bytes;
+        for (std::uint64_t r = 0; r < count; ++r)
+            for (const Member& g : group)
+                ms.push_back({offset + r * stride + g.offset, g.rest});
+    }
+};
+
+} // namespace detail
+
+/// True when `signature` is in compact form ('~' after the arch prefix).
+constexpr bool is_compact_signature(std::string_view signature) noexcept {
+    std::size_t prefix = detail::arch_prefix_length(signature);
+    return prefix < signature.size() && signature[prefix] == '~';
+}
+
+/// Canonical compact form of a full signature (see the header comment).
+/// Compact or unparsable input is returned unchanged.
+constexpr std::string compact_signature(std::string_view signature) {
+    if (is_compact_signature(signature)) return std::string(signature);
+    detail::SigAst ast(signature);
+    if (!ast.ok()) return std::string(signature);
+    return detail::SigCompactor(ast).compact();
+}
+
+/// Full signature of a compact one; full signatures are returned
+/// unchanged.  Returns an empty string for malformed compact input, and
+/// for input past the expander's bounds (compact_max_depth,
+/// compact_max_expanded).
+constexpr std::string expand_signature(std::string_view signature) {
+    if (!is_compact_signature(signature)) return std::string(signature);
+    std::string out;
+    out.reserve(signature.size() * 4);
+    if (!detail::SigExpander(signature).expand(out)) return std::string();
+    return out;
+}
+
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_DETAIL_SIG_COMPACT_HPP
@@ -1,5 +1,15 @@
 // sig_parser.hpp -- Signature string parsing utilities.
 //
+// SigParser is a single-pass recursive-descent parser for the signature
+// grammar documented in detail/signature_impl.hpp.  It produces a flat,
+// index-linked SigNode array (kind, offset, size, align, children, bit
+// info) together with the structural SigFlags of the whole signature, and
+// works identically in consteval and runtime code.  Consumers that need
+// fields -- CompatReporter field diffs and headers -- use parse();
+// consumers that only need the flags (classify_signature, admission's
+// signature-scan fallback) use scan_flags(), a node-free pass over the
+// same keyword table.
+//
 // Copyright (c) 2024-2026 TypeLayout Development Team
 // Distributed under the Boost Software License, Version 1.0.
 
@@ -7,7 +17,9 @@
 #define BOOST_TYPELAYOUT_DETAIL_SIG_PARSER_HPP
 
 #include <string_view>
+#include <vector>
 #include <cstddef>
+#include <cstdint>
 
 namespace boost {
 namespace typelayout {
@@ -32,16 +44,489 @@ constexpr bool sig_contains_token(std::string_view haystack,
     return false;
 }
 
+/// Structural properties of a layout signature.  Every TypeSignature
+/// carries them (pointer_free, has_bitfield, has_platform_variant,
+/// has_opaque), combined bottom-up while the signature is built, so
+/// consumers can test them in O(1) instead of scanning the string.
+struct SigFlags {
+    bool pointer_free         = true;   // no ptr/fnptr/memptr/ref/rref/vptr
+    bool has_bitfield         = false;  // bits<...> anywhere
+    bool has_platform_variant = false;  // wchar or fld* (long double)
+    bool has_opaque           = false;  // O(...) anywhere
+
+    /// Flags of a signature embedding both signatures.
+    friend constexpr SigFlags operator|(SigFlags a, SigFlags b) noexcept {
+        return {a.pointer_free && b.pointer_free,
+                a.has_bitfield || b.has_bitfield,
+                a.has_platform_variant || b.has_platform_variant,
+                a.has_opaque || b.has_opaque};
+    }
+
+    friend constexpr bool operator==(SigFlags, SigFlags) noexcept = default;
+};
+
+inline constexpr SigFlags plain_sig_flags{};
+inline constexpr SigFlags pointer_sig_flags{false, false, false, false};
+inline constexpr SigFlags bitfield_sig_flags{true, true, false, false};
+inline constexpr SigFlags platform_variant_sig_flags{true, false, true, false};
+inline constexpr SigFlags opaque_sig_flags{true, false, false, true};
+inline constexpr SigFlags all_sig_flags{false, true, true, true};
+
+// =========================================================================
+// Flat signature AST
+// =========================================================================
+
+enum class SigNodeKind : std::uint8_t {
+    Scalar,     // leaf-signature: u32[s:4,a:4], ptr[s:8,a:8], ...
+    Record,     // record[...]{member-list}
+    Union,      // union[...]{member-list}
+    Enum,       // enum[...]<type>
+    Array,      // array[...]<type,count>
+    Bytes,      // bytes[s:N,a:1]
+    Opaque,     // O(TAG|size|align), optionally <type,...> for containers
+    Field,      // @offset:type
+    BitField,   // @offset.bit:bits<width,leaf>
+};
+
+inline constexpr std::uint32_t sig_no_node = 0xffffffffu;
+
+/// One node of a parsed signature.  Positions index the parsed string.
+struct SigNode {
+    SigNodeKind   kind         = SigNodeKind::Scalar;
+    bool          vptr         = false;        // record params carry ",vptr"
+    std::uint32_t parent       = sig_no_node;
+    std::uint32_t first_child  = sig_no_node;
+    std::uint32_t last_child   = sig_no_node;
+    std::uint32_t next_sibling = sig_no_node;
+    std::uint32_t child_count  = 0;
+    std::uint32_t begin        = 0;            // [begin, end) full text
+    std::uint32_t end          = 0;
+    std::uint32_t name_begin   = 0;            // kind token, opaque TAG, or
+    std::uint32_t name_end     = 0;            //   field offset text ("8", "8.3")
+    std::uint32_t head_end     = 0;            // end of "kind[params]" / "O(...)"
+    std::uint64_t offset       = 0;            // Field, BitField: byte offset
+    std::uint64_t size         = 0;
+    std::uint64_t align        = 0;
+    std::uint64_t count        = 0;            // Array: element count
+    std::uint32_t bit_offset   = 0;            // BitField
+    std::uint32_t bit_width    = 0;            // BitField
+};
+
+struct SigParseResult {
+    bool          ok         = false;
+    std::size_t   error_pos  = 0;              // first rejected char when !ok
+    std::size_t   type_begin = 0;              // after the arch prefix, if any
+    std::uint32_t root       = sig_no_node;
+    SigFlags      flags;
+};
+
+/// Single-pass parser.  With `nodes == nullptr` only the flags and
+/// validity are computed (no allocation).
+class SigParser {
+public:
+    constexpr SigParser(std::string_view sig, std::vector<SigNode>* nodes) noexcept
+        : s_(sig.data()), n_(sig.size()), nodes_(nodes) {}
+
+    constexpr SigParseResult parse() {
+        SigParseResult r;
+        if (accept('[')) {                                   // arch-prefix
+            while (pos_ < n_ && s_[pos_] != ']') ++pos_;
+            expect(']');
+        }
+        r.type_begin = pos_;
+        if (ok_) r.root = parse_type(sig_no_node);
+        if (ok_ && pos_ != n_) ok_ = false;
+        r.ok = ok_;
+        r.error_pos = ok_ ? 0 : pos_;
+        r.flags = flags_;
+        return r;
+    }
+
+    /// The flags alone, in one forward pass that builds no nodes and checks
+    /// no grammar, so hand-written and truncated strings get flags too.
+    /// Every flag-bearing token contains one of scan_anchors; the pass hops
+    /// from one anchor to the next (memchr per anchor, visited in string
+    /// order), classifies the identifier there with classify_word -- the
+    /// table parse() uses -- and skips opaque tags as parse() does.
+    ///
+    /// Stops early once every flag `enough` sets (differs from
+    /// plain_sig_flags) is set: the default waits for all four, a caller
+    /// that only asks "any pointer?" passes pointer_sig_flags.
+    constexpr SigFlags scan_flags(SigFlags enough = all_sig_flags) noexcept {
+        const std::string_view sig(s_, n_);
+        constexpr std::size_t npos = std::string_view::npos;
+        if (accept('[')) {                                   // arch-prefix
+            while (pos_ < n_ && s_[pos_] != ']') ++pos_;
+        }
+        std::size_t next[scan_anchor_count] = {};
+        for (std::size_t k = 0; k < scan_anchor_count; ++k)
+            next[k] = sig.find(scan_anchors[k], pos_);
+        for (;;) {
+            std::size_t k = 0;
+            for (std::size_t j = 1; j < scan_anchor_count; ++j)
+                if (next[j] < next[k]) k = j;
+            std::size_t at = next[k];
+            if (at == npos) break;
+
+            // '.' only separates a bit-field's offsets: "@8.3:bits<...>".
+            if (s_[at] == '.') {
+                while (++at < n_ && (is_digit(s_[at]) || s_[at] == ':')) {}
+            }
+            std::size_t b = at, e = at;
+            while (b > 0 && is_alnum(s_[b - 1])) --b;
+            while (e < n_ && is_alnum(s_[e])) ++e;
+            const char after = e < n_ ? s_[e] : '\0';
+            std::size_t resume = e > next[k] ? e : next[k] + 1;
+            switch (b == e ? Word::Other : classify_word(b, e - b)) {
+                case Word::Pointer:
+                    flags_.pointer_free = false;
+                    break;
+                case Word::Variant:
+                    flags_.has_platform_variant = true;
+                    break;
+                case Word::Bits:
+                    if (after == '<') flags_.has_bitfield = true;
+                    break;
+                case Word::Opaque:
+                    if (after != '(') break;
+                    // O(TAG|size|align): the tag is free text.
+                    flags_.has_opaque = true;
+                    resume = sig.find(')', e);
+                    if (resume == npos) return flags_;
+                    break;
+                default:
+                    break;
+            }
+            if ((flags_.has_opaque || !enough.has_opaque) &&
+                (!flags_.pointer_free || enough.pointer_free) &&
+                (flags_.has_bitfield || !enough.has_bitfield) &&
+                (flags_.has_platform_variant || !enough.has_platform_variant))
+                break;
+            if (resume > e) {
+                for (std::size_t j = 0; j < scan_anchor_count; ++j)
+                    if (next[j] < resume) next[j] = sig.find(scan_anchors[j], resume);
+            } else {
+                next[k] = sig.find(scan_anchors[k], resume);
+            }
+        }
+        return flags_;
+    }
+
+private:
+    enum class Word : std::uint8_t {
+        Other, Opaque, Record, Union, Enum, Array, Bytes, Pointer, Variant, Bits
+    };
+
+    // One character of every token that sets a flag: p (ptr, fnptr,
+    // memptr, vptr), e (ref, rref), w (wchar), d (fld*), O (opaque) and
+    // '.' (a bit-field member's "@byte.bit").
+    static constexpr char        scan_anchors[] = {'p', 'e', 'w', 'd', 'O', '.'};
+    static constexpr std::size_t scan_anchor_count = sizeof(scan_anchors);
+
+    const char*           s_;
+    std::size_t           n_;
+    std::vector<SigNode>* nodes_;
+    std::size_t           pos_   = 0;
+    std::uint32_t         count_ = 0;
+    bool                  ok_    = true;
+    SigFlags              flags_;
+    SigNode               scratch_;
+
+    static constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+    static constexpr bool is_alnum(char c) noexcept {
+        return is_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    constexpr char peek() const noexcept { return pos_ < n_ ? s_[pos_] : '\0'; }
+
+    constexpr bool accept(char c) noexcept {
+        if (peek() != c) return false;
+        ++pos_;
+        return true;
+    }
+
+    constexpr void expect(char c) noexcept {
+        if (ok_ && !accept(c)) ok_ = false;
+    }
+
+    constexpr bool word_eq(std::size_t at, const char* w, std::size_t len) const noexcept {
+        if (n_ - at < len) return false;
+        for (std::size_t i = 0; i < len; ++i)
+            if (s_[at + i] != w[i]) return false;
+        return true;
+    }
+
+    // Keyword of the identifier [b, b+len): one switch on length and first
+    // character, so each identifier costs at most one short comparison.
+    constexpr Word classify_word(std::size_t b, std::size_t len) const noexcept {
+        char c = s_[b];
+        switch (len) {
+            case 1:
+                return c == 'O' ? Word::Opaque : Word::Other;
+            case 3:
+                if (c == 'p' && word_eq(b, "ptr", 3)) return Word::Pointer;
+                if (c == 'r' && word_eq(b, "ref", 3)) return Word::Pointer;
+                return Word::Other;
+            case 4:
+                switch (c) {
+                    case 'e': return word_eq(b, "enum", 4) ? Word::Enum : Word::Other;
+                    case 'r': return word_eq(b, "rref", 4) ? Word::Pointer : Word::Other;
+                    case 'v': return word_eq(b, "vptr", 4) ? Word::Pointer : Word::Other;
+                    case 'b': return word_eq(b, "bits", 4) ? Word::Bits : Word::Other;
+                    default:  return Word::Other;
+                }
+            case 5:
+                switch (c) {
+                    case 'u': return word_eq(b, "union", 5) ? Word::Union : Word::Other;
+                    case 'a': return word_eq(b, "array", 5) ? Word::Array : Word::Other;
+                    case 'b': return word_eq(b, "bytes", 5) ? Word::Bytes : Word::Other;
+                    case 'w': return word_eq(b, "wchar", 5) ? Word::Variant : Word::Other;
+                    case 'f':
+                        if (word_eq(b, "fnptr", 5)) return Word::Pointer;
+                        return word_eq(b, "fld", 3) ? Word::Variant : Word::Other;
+                    default:  return Word::Other;
+                }
+            case 6:
+                switch (c) {
+                    case 'r': return word_eq(b, "record", 6) ? Word::Record : Word::Other;
+                    case 'm': return word_eq(b, "memptr", 6) ? Word::Pointer : Word::Other;
+                    case 'f': return word_eq(b, "fld", 3) ? Word::Variant : Word::Other;
+                    default:  return Word::Other;
+                }
+            default:
+                return Word::Other;
+        }
+    }
+
+    constexpr std::uint64_t number() noexcept {
+        std::size_t p = pos_;
+        std::uint64_t v = 0;
+        while (p < n_ && is_digit(s_[p])) v = v * 10 + std::uint64_t(s_[p++] - '0');
+        if (p == pos_) ok_ = false;
+        pos_ = p;
+        return v;
+    }
+
+    constexpr SigNode& at(std::uint32_t i) noexcept {
+        return nodes_ ? (*nodes_)[i] : scratch_;
+    }
+
+    constexpr std::uint32_t open(SigNodeKind kind, std::uint32_t parent) {
+        std::uint32_t self = count_++;
+        if (nodes_) {
+            SigNode n;
+            n.kind = kind;
+            n.parent = parent;
+            n.begin = static_cast<std::uint32_t>(pos_);
+            nodes_->push_back(n);
+            if (parent != sig_no_node) {
+                SigNode& p = (*nodes_)[parent];
+                if (p.first_child == sig_no_node) p.first_child = self;
+                else (*nodes_)[p.last_child].next_sibling = self;
+                p.last_child = self;
+                ++p.child_count;
+            }
+        }
+        return self;
+    }
+
+    constexpr void close(std::uint32_t self) noexcept {
+        at(self).end = static_cast<std::uint32_t>(pos_);
+    }
+
+    // params ::= '[' key ':' value (',' key ':' value)* (',' 'vptr')? ']'
+    constexpr void parse_params(std::uint32_t self) noexcept {
+        expect('[');
+        while (ok_) {
+            char key = peek();
+            if (key == 'v' && word_eq(pos_, "vptr", 4)) {
+                pos_ += 4;
+                at(self).vptr = true;
+                flags_.pointer_free = false;
+            } else if (is_alnum(key)) {
+                ++pos_;
+                expect(':');
+                std::uint64_t v = ok_ ? number() : 0;
+                if (key == 's') at(self).size = v;
+                else if (key == 'a') at(self).align = v;
+            } else {
+                ok_ = false;
+            }
+            if (!accept(',')) break;
+        }
+        expect(']');
+    }
+
+    constexpr std::uint32_t parse_type(std::uint32_t parent) {
+        std::size_t name_begin = pos_;
+        std::size_t name_end = pos_;
+        while (name_end < n_ && is_alnum(s_[name_end])) ++name_end;
+        if (name_end == name_begin) { ok_ = false; return sig_no_node; }
+
+        Word word = classify_word(name_begin, name_end - name_begin);
+        if (word == Word::Opaque && name_end < n_ && s_[name_end] == '(')
+            return parse_opaque(parent);
+
+        SigNodeKind kind = word == Word::Record ? SigNodeKind::Record
+                         : word == Word::Union  ? SigNodeKind::Union
+                         : word == Word::Enum   ? SigNodeKind::Enum
+                         : word == Word::Array  ? SigNodeKind::Array
+                         : word == Word::Bytes  ? SigNodeKind::Bytes
+                         :                        SigNodeKind::Scalar;
+        std::uint32_t self = open(kind, parent);
+        pos_ = name_end;
+        at(self).name_begin = static_cast<std::uint32_t>(name_begin);
+        at(self).name_end   = static_cast<std::uint32_t>(name_end);
+        parse_params(self);
+        at(self).head_end = static_cast<std::uint32_t>(pos_);
+
+        switch (kind) {
+            case SigNodeKind::Record:
+            case SigNodeKind::Union:
+                expect('{');
+                if (ok_ && peek() != '}') {
+                    do { parse_member(self); } while (ok_ && accept(','));
+                }
+                expect('}');
+                break;
+            case SigNodeKind::Enum:
+                expect('<');
+                if (ok_) parse_type(self);
+                expect('>');
+                break;
+            case SigNodeKind::Array:
+                expect('<');
+                if (ok_) parse_type(self);
+                expect(',');
+                if (ok_) at(self).count = number();
+                expect('>');
+                break;
+            case SigNodeKind::Scalar:
+                if (word == Word::Pointer) flags_.pointer_free = false;
+                else if (word == Word::Variant) flags_.has_platform_variant = true;
+                break;
+            default:
+                break;
+        }
+        close(self);
+        return self;
+    }
+
+    // member ::= '@' offset ':' type
+    //          | '@' offset '.' bit-offset ':' 'bits<' width ',' leaf '>'
+    constexpr void parse_member(std::uint32_t parent) {
+        std::uint32_t self = open(SigNodeKind::Field, parent);
+        expect('@');
+        at(self).name_begin = static_cast<std::uint32_t>(pos_);
+        if (ok_) at(self).offset = number();
+        bool bitfield = accept('.');
+        if (bitfield) {
+            at(self).kind = SigNodeKind::BitField;
+            if (ok_) at(self).bit_offset = static_cast<std::uint32_t>(number());
+        }
+        at(self).name_end = static_cast<std::uint32_t>(pos_);
+        expect(':');
+        if (bitfield) {
+            if (ok_ && word_eq(pos_, "bits<", 5)) pos_ += 5;
+            else ok_ = false;
+            if (ok_) at(self).bit_width = static_cast<std::uint32_t>(number());
+            expect(',');
+            if (ok_) parse_type(self);
+            expect('>');
+            flags_.has_bitfield = true;
+        } else if (ok_) {
+            parse_type(self);
+        }
+        close(self);
+    }
+
+    // opaque ::= 'O(' TAG '|' size '|' align ')' ('<' type (',' type)* '>')?
+    constexpr std::uint32_t parse_opaque(std::uint32_t parent) {
+        std::uint32_t self = open(SigNodeKind::Opaque, parent);
+        pos_ += 2;
+        at(self).name_begin = static_cast<std::uint32_t>(pos_);
+        while (pos_ < n_ && s_[pos_] != '|' && s_[pos_] != ')') ++pos_;
+        at(self).name_end = static_cast<std::uint32_t>(pos_);
+        expect('|');
+        if (ok_) at(self).size = number();
+        expect('|');
+        if (ok_) at(self).align = number();
+        expect(')');
+        at(self).head_end = static_cast<std::uint32_t>(pos_);
+        if (ok_ && accept('<')) {
+            do { parse_type(self); } while (ok_ && accept(','));
+            expect('>');
+        }
+        flags_.has_opaque = true;
+        close(self);
+        return self;
+    }
+};
+
+/// Parsed signature: owns the node array, views the string.
+class SigAst {
+public:
+    constexpr explicit SigAst(std::string_view sig) : sig_(sig) {
+        nodes_.reserve(sig.size() / 6 + 1);
+        result_ = SigParser(sig, &nodes_).parse();
+    }
+
+    constexpr bool ok() const noexcept { return result_.ok; }
+    constexpr const SigParseResult& result() const noexcept { return result_; }
+    constexpr SigFlags flags() const noexcept { return result_.flags; }
+    constexpr std::string_view signature() const noexcept { return sig_; }
+    constexpr const std::vector<SigNode>& nodes() const noexcept { return nodes_; }
+    constexpr const SigNode& node(std::uint32_t i) const noexcept { return nodes_[i]; }
+
+    /// Root type node; nullptr when the signature did not parse.
+    constexpr const SigNode* root() const noexcept {
+        return ok() ? &nodes_[result_.root] : nullptr;
+    }
+
+    constexpr std::string_view text(const SigNode& n) const noexcept {
+        return sig_.substr(n.begin, n.end - n.begin);
+    }
+    constexpr std::string_view name(const SigNode& n) const noexcept {
+        return sig_.substr(n.name_begin, n.name_end - n.name_begin);
+    }
+    /// "kind[params]" / "O(TAG|size|align)" without the body.
+    constexpr std::string_view head(const SigNode& n) const noexcept {
+        return sig_.substr(n.begin, n.head_end - n.begin);
+    }
+    /// Field / BitField: the text after "@offset:".
+    constexpr std::string_view field_type(const SigNode& n) const noexcept {
+        return sig_.substr(n.name_end + 1, n.end - n.name_end - 1);
+    }
+
+private:
+    std::string_view     sig_;
+    std::vector<SigNode> nodes_;
+    SigParseResult       result_;
+};
+
+/// Structural flags of a signature string, for signatures without
+/// compile-time flags (exported strings, user TypeSignatures).  With
+/// `enough`, flags it does not ask for may be left unset (see scan_flags).
+constexpr SigFlags sig_scan_flags(std::string_view sig,
+                                  SigFlags enough = all_sig_flags) noexcept {
+    return SigParser(sig, nullptr).scan_flags(enough);
+}
+
 /// Check whether a signature contains pointer-like tokens.
 constexpr bool sig_has_pointer(std::string_view sig) noexcept {
-    return sig_contains_token(sig, "ptr[") ||
-           sig_contains_token(sig, "fnptr[") ||
-           sig_contains_token(sig, "memptr[") ||
-           sig_contains_token(sig, "ref[") ||
-           sig_contains_token(sig, "rref[") ||
-           sig_contains_token(sig, "vptr");
+    return !sig_scan_flags(sig, pointer_sig_flags).pointer_free;
 }
 
+/// Static flag members for a TypeSignature with fixed flags.
+template <SigFlags F>
+struct fixed_sig_flags {
+    static constexpr SigFlags flags = F;
+    static constexpr bool pointer_free         = F.pointer_free;
+    static constexpr bool has_bitfield         = F.has_bitfield;
+    static constexpr bool has_platform_variant = F.has_platform_variant;
+    static constexpr bool has_opaque           = F.has_opaque;
+};
+
 } // namespace detail
 } // inline namespace v1
 } // namespace typelayout
@@ -54,6 +54,9 @@
 //   - Empty classes embedded as base (EBO) or [[no_unique_address]] member
 //     use s:0 in the host signature.  Standalone signatures use s:1.
 //   - DIGIT ::= [0-9]
+//   - This is the full (canonical) form.  detail/sig_compact.hpp defines an
+//     optional compact form ('~' after the arch prefix) that expands back
+//     to it losslessly.
 //
 // =========================================================================
 
@@ -73,37 +76,80 @@ namespace detail {
         { TypeSignature<std::remove_cv_t<T>>::is_opaque } -> std::convertible_to<bool>;
     } && TypeSignature<std::remove_cv_t<T>>::is_opaque;
 
+    // Structural flags of T's signature (see SigFlags), memoized per type.
+    // Built-in and macro-registered TypeSignatures carry all four flags;
+    // hand-written specializations without them fall back to scanning
+    // their signature string (an explicit pointer_free still wins).
+    template <typename T>
+    consteval SigFlags compute_signature_flags() noexcept {
+        using S = TypeSignature<T>;
+        if constexpr (requires {
+                          S::pointer_free; S::has_bitfield;
+                          S::has_platform_variant; S::has_opaque; }) {
+            return {S::pointer_free, S::has_bitfield,
+                    S::has_platform_variant, S::has_opaque};
+        } else {
+            constexpr auto& sig = signature_v<T>;
+            SigFlags f = sig_scan_flags(std::string_view(sig.value, sig.size));
+            if constexpr (requires { S::pointer_free; })
+                f.pointer_free = S::pointer_free;
+            return f;
+        }
+    }
+
+    template <typename T>
+    inline constexpr SigFlags signature_flags_v = compute_signature_flags<T>();
+
+    // Static flag members for a signature embedding the layouts of Ts...
+    // (plus Extra).  Evaluated on first use, like calculate().
+    template <SigFlags Extra, typename... Ts>
+    struct embedded_sig_flags {
+        static constexpr SigFlags flags = (Extra | ... | signature_flags_v<Ts>);
+        static constexpr bool pointer_free         = flags.pointer_free;
+        static constexpr bool has_bitfield         = flags.has_bitfield;
+        static constexpr bool has_platform_variant = flags.has_platform_variant;
+        static constexpr bool has_opaque           = flags.has_opaque;
+    };
+
     // Patch an empty type's signature from s:1 to s:0 for EBO /
     // [[no_unique_address]] contexts where it occupies 0 bytes.
     //
-    // Implementation note: this uses string surgery on the "[s:N" portion
-    // of the signature.  The format-specific static_asserts below verify
-    // that the expected structure ("TYPE[s:N,a:M]...") holds.  If the
-    // signature format is ever changed (e.g., new parameter inserted
-    // before "s:"), these asserts will fire at compile time.
+    // Implementation note: the parser locates the record's params; the
+    // static_asserts below verify that they start with "[s:1," so only the
+    // size digit is replaced.  If the signature format is ever changed
+    // (e.g., new parameter inserted before "s:"), they fire at compile time.
+    consteval SigNode parse_root_node(std::string_view sig) {
+        SigAst ast(sig);
+        return ast.ok() ? *ast.root() : SigNode{};
+    }
+
     template <typename T>
     consteval auto embedded_empty_signature() noexcept {
-        static constexpr auto full = TypeSignature<T>::calculate();
+        constexpr auto& full = signature_v<T>;
         constexpr auto str = std::string_view(full);
-        constexpr auto s_pos = str.find("[s:");
-        static_assert(s_pos != std::string_view::npos,
-            "embedded_empty_signature: signature must contain '[s:' "
-            "(format: TYPE[s:SIZE,a:ALIGN]{...})");
-        constexpr auto comma_pos = str.find(',', s_pos + 3);
-        static_assert(comma_pos != std::string_view::npos,
-            "embedded_empty_signature: expected ',a:' after size "
-            "(format: TYPE[s:SIZE,a:ALIGN]{...})");
+        constexpr SigNode root = parse_root_node(str);
+        static_assert(root.kind == SigNodeKind::Record,
+            "embedded_empty_signature: expected a record signature "
+            "(format: record[s:SIZE,a:ALIGN]{...})");
         // Verify the size being replaced is "1" (empty types have sizeof == 1).
-        static_assert(str[s_pos + 3] == '1' && str[s_pos + 4] == ',',
+        static_assert(root.size == 1,
             "embedded_empty_signature: expected s:1 for empty type; "
             "got unexpected size value -- check if sizeof(T) != 1");
-        return FixedString<s_pos>(str.substr(0, s_pos)) +
-               FixedString{"[s:0"} +
-               FixedString<str.size() - comma_pos>(str.substr(comma_pos));
+        constexpr std::size_t s_pos = root.name_end;
+        static_assert(str.substr(s_pos, 5) == "[s:1,",
+            "embedded_empty_signature: size must be the first parameter "
+            "(format: record[s:SIZE,a:ALIGN]{...})");
+        constexpr std::size_t comma_pos = s_pos + 4;
+        return concat(FixedString<s_pos>(str.substr(0, s_pos)),
+                      "[s:0",
+                      FixedString<str.size() - comma_pos>(str.substr(comma_pos)));
     }
 
-    template <typename T, std::size_t OffsetAdj>
-    consteval auto layout_all_prefixed() noexcept;
+    template <typename T>
+    inline constexpr auto embedded_empty_signature_v = embedded_empty_signature<T>();
+
+    template <typename T, std::size_t Offset>
+    consteval auto rebased_fields() noexcept;
 
     template <bool WithLeadingComma>
     consteval auto field_prefix() noexcept {
@@ -115,24 +161,24 @@ namespace detail {
 
     template <bool WithLeadingComma, std::size_t Offset, typename Sig>
     consteval auto emit_field_signature(const Sig& sig) noexcept {
-        return field_prefix<WithLeadingComma>() +
-               to_fixed_string<Offset>() +
-               FixedString{":"} +
-               sig;
+        return concat(field_prefix<WithLeadingComma>(),
+                      to_fixed_string<Offset>(),
+                      ":",
+                      sig);
     }
 
     template <bool WithLeadingComma, std::size_t BytePos,
               std::size_t BitPos, std::size_t BitWidth, typename FieldType>
     consteval auto emit_bitfield_signature() noexcept {
-        return field_prefix<WithLeadingComma>() +
-               to_fixed_string<BytePos>() +
-               FixedString{"."} +
-               to_fixed_string<BitPos>() +
-               FixedString{":bits<"} +
-               to_fixed_string<BitWidth>() +
-               FixedString{","} +
-               TypeSignature<FieldType>::calculate() +
-               FixedString{">"};
+        return concat(field_prefix<WithLeadingComma>(),
+                      to_fixed_string<BytePos>(),
+                      ".",
+                      to_fixed_string<BitPos>(),
+                      ":bits<",
+                      to_fixed_string<BitWidth>(),
+                      ",",
+                      signature_v<FieldType>,
+                      ">");
     }
 
     template <bool WithLeadingComma, typename FieldType, std::size_t Offset>
@@ -140,68 +186,69 @@ namespace detail {
         if constexpr (std::is_class_v<FieldType> && !std::is_union_v<FieldType>
                       && !has_opaque_signature<FieldType>
                       && !std::is_empty_v<FieldType>) {
-            return layout_all_prefixed<FieldType, Offset>();
+            return rebased_fields<FieldType, Offset>();
         } else if constexpr (std::is_empty_v<FieldType>
                              && std::is_class_v<FieldType>
                              && !has_opaque_signature<FieldType>) {
             return emit_field_signature<WithLeadingComma, Offset>(
-                embedded_empty_signature<FieldType>());
+                embedded_empty_signature_v<FieldType>);
         } else {
             return emit_field_signature<WithLeadingComma, Offset>(
-                TypeSignature<FieldType>::calculate());
+                signature_v<FieldType>);
         }
     }
 
     template <bool AddComma, typename Entry>
     consteval auto maybe_prepend_comma(const Entry& entry) noexcept {
         if constexpr (AddComma)
-            return FixedString{","} + entry;
+            return concat(",", entry);
         else
             return entry;
     }
 
-    template<typename T, std::size_t Index, std::size_t OffsetAdj>
+    template<typename T, std::size_t Index>
     consteval auto layout_field_with_comma() noexcept {
         using namespace std::meta;
-        constexpr auto member = nonstatic_data_members_of(^^T, access_context::unchecked())[Index];
+        constexpr auto member = reflected_members_v<T>[Index];
         using FieldType = [:type_of(member):];
 
         // Bit-field: emit byte.bit offset + width + storage type signature
         if constexpr (is_bit_field(member)) {
             constexpr auto bit_off = offset_of(member);
-            constexpr std::size_t byte_pos = bit_off.bytes + OffsetAdj;
+            constexpr std::size_t byte_pos = bit_off.bytes;
             constexpr std::size_t bit_pos  = bit_off.bits;
             constexpr std::size_t bwidth   = bit_size_of(member);
             return emit_bitfield_signature<true, byte_pos, bit_pos,
                                            bwidth, FieldType>();
         } else {
-            constexpr std::size_t field_offset = offset_of(member).bytes + OffsetAdj;
+            constexpr std::size_t field_offset = offset_of(member).bytes;
             return emit_flattened_field<true, FieldType, field_offset>();
         }
     }
 
-    template <typename T, std::size_t OffsetAdj, std::size_t... Is>
+    template <typename T, std::size_t... Is>
     consteval auto layout_direct_fields_prefixed(std::index_sequence<Is...>) noexcept {
         if constexpr (sizeof...(Is) == 0) return FixedString{""};
-        else return (layout_field_with_comma<T, Is, OffsetAdj>() + ...);
+        else return concat(layout_field_with_comma<T, Is>()...);
     }
 
-    template <typename T, std::size_t BaseIndex, std::size_t OffsetAdj>
+    template <typename T, std::size_t BaseIndex>
     consteval auto layout_one_base_prefixed() noexcept {
         using namespace std::meta;
-        constexpr auto base_info = bases_of(^^T, access_context::unchecked())[BaseIndex];
+        constexpr auto base_info = reflected_bases_v<T>[BaseIndex];
         using BaseType = [:type_of(base_info):];
-        constexpr std::size_t base_offset = offset_of(base_info).bytes + OffsetAdj;
+        constexpr std::size_t base_offset = offset_of(base_info).bytes;
         return emit_flattened_field<true, BaseType, base_offset>();
     }
 
-    template <typename T, std::size_t OffsetAdj, std::size_t... Is>
+    template <typename T, std::size_t... Is>
     consteval auto layout_bases_prefixed(std::index_sequence<Is...>) noexcept {
         if constexpr (sizeof...(Is) == 0) return FixedString{""};
-        else return (layout_one_base_prefixed<T, Is, OffsetAdj>() + ...);
+        else return concat(layout_one_base_prefixed<T, Is>()...);
     }
 
-    template <typename T, std::size_t OffsetAdj>
+    // Flattened ",@OFF:SIG..." member list of T with offsets relative to T.
+    template <typename T>
     consteval auto layout_all_prefixed() noexcept {
         static_assert(!has_virtual_base<T>(),
             "TypeLayout: virtual inheritance is not supported (hidden "
@@ -209,15 +256,76 @@ namespace detail {
         constexpr std::size_t bc = get_base_count<T>();
         constexpr std::size_t fc = get_member_count<T>();
         if constexpr (bc == 0 && fc == 0) return FixedString{""};
-        else if constexpr (bc == 0) return layout_direct_fields_prefixed<T, OffsetAdj>(std::make_index_sequence<fc>{});
-        else if constexpr (fc == 0) return layout_bases_prefixed<T, OffsetAdj>(std::make_index_sequence<bc>{});
-        else return layout_bases_prefixed<T, OffsetAdj>(std::make_index_sequence<bc>{}) +
-                    layout_direct_fields_prefixed<T, OffsetAdj>(std::make_index_sequence<fc>{});
+        else if constexpr (bc == 0) return layout_direct_fields_prefixed<T>(std::make_index_sequence<fc>{});
+        else if constexpr (fc == 0) return layout_bases_prefixed<T>(std::make_index_sequence<bc>{});
+        else return concat(layout_bases_prefixed<T>(std::make_index_sequence<bc>{}),
+                           layout_direct_fields_prefixed<T>(std::make_index_sequence<fc>{}));
+    }
+
+    // Memoized flattened member list: reflected once per T, no matter how
+    // many times T is embedded (as a member, base or array element).
+    template <typename T>
+    inline constexpr auto flattened_fields_v = layout_all_prefixed<T>();
+
+    // Add `adj` to every top-level member offset ("@N" at nesting depth 0)
+    // of a flattened member list.  Offsets inside nested union/array/enum
+    // bodies are relative to that body and are copied verbatim, as is the
+    // opaque "(TAG|size|align)" group, whose TAG may contain any bracket.
+    // Returns the rebased length; writes the result only when `out` is
+    // non-null, so the same routine serves both builder passes.
+    consteval std::size_t rebase_offsets(std::string_view fields, std::size_t adj,
+                                         char* out) noexcept {
+        std::size_t len = 0;
+        int depth = 0;
+        auto put = [&](char c) {
+            if (out) out[len] = c;
+            ++len;
+        };
+        for (std::size_t i = 0; i < fields.size(); ) {
+            char c = fields[i];
+            if (c == '@' && depth == 0) {
+                std::size_t j = i + 1;
+                std::size_t v = 0;
+                while (j < fields.size() && fields[j] >= '0' && fields[j] <= '9')
+                    v = v * 10 + std::size_t(fields[j++] - '0');
+                v += adj;
+                char digits[20] = {};
+                std::size_t nd = 0;
+                do { digits[nd++] = char('0' + v % 10); v /= 10; } while (v > 0);
+                put('@');
+                while (nd > 0) put(digits[--nd]);
+                i = j;
+                continue;
+            }
+            if (c == '(') {
+                while (i < fields.size() && fields[i] != ')') put(fields[i++]);
+                continue;
+            }
+            if (c == '[' || c == '{' || c == '<') ++depth;
+            else if (c == ']' || c == '}' || c == '>') --depth;
+            put(c);
+            ++i;
+        }
+        return len;
+    }
+
+    template <typename T, std::size_t Offset>
+    consteval auto rebased_fields() noexcept {
+        constexpr auto& fields = flattened_fields_v<T>;
+        if constexpr (Offset == 0) {
+            return fields;
+        } else {
+            constexpr std::string_view view{fields.value, fields.size};
+            constexpr std::size_t len = rebase_offsets(view, Offset, nullptr);
+            FixedString<len> result;
+            rebase_offsets(view, Offset, result.value);
+            return result;
+        }
     }
 
     template <typename T>
     consteval auto get_layout_content() noexcept {
-        return layout_all_prefixed<T, 0>().skip_first();
+        return flattened_fields_v<T>.skip_first();
     }
 
     // Union layout helpers (no flattening).
@@ -225,7 +333,7 @@ namespace detail {
     template<typename T, std::size_t Index>
     consteval auto layout_union_field() noexcept {
         using namespace std::meta;
-        constexpr auto member = nonstatic_data_members_of(^^T, access_context::unchecked())[Index];
+        constexpr auto member = reflected_members_v<T>[Index];
         using FieldType = [:type_of(member):];
 
         if constexpr (is_bit_field(member)) {
@@ -238,7 +346,7 @@ namespace detail {
         } else {
             constexpr std::size_t uf_off = offset_of(member).bytes;
             return emit_field_signature<false, uf_off>(
-                TypeSignature<FieldType>::calculate());
+                signature_v<FieldType>);
         }
     }
 
@@ -249,7 +357,7 @@ namespace detail {
 
     template<typename T, std::size_t... Is>
     consteval auto concatenate_layout_union_fields(std::index_sequence<Is...>) noexcept {
-        return (layout_union_field_with_comma<T, Is, (Is == 0)>() + ...);
+        return concat(layout_union_field_with_comma<T, Is, (Is == 0)>()...);
     }
 
     template <typename T>
@@ -261,6 +369,52 @@ namespace detail {
             return concatenate_layout_union_fields<T>(std::make_index_sequence<count>{});
     }
 
+    // Structural flags of records and unions, folded over the same cached
+    // member/base arrays the signature is built from.
+
+    consteval SigFlags member_extra_flags(std::meta::info member) noexcept {
+        return std::meta::is_bit_field(member) ? bitfield_sig_flags : SigFlags{};
+    }
+
+    template <typename T, std::size_t... Is>
+    consteval SigFlags members_sig_flags(std::index_sequence<Is...>) noexcept {
+        return (SigFlags{} | ... |
+                (signature_flags_v<typename [:std::meta::type_of(reflected_members_v<T>[Is]):]> |
+                 member_extra_flags(reflected_members_v<T>[Is])));
+    }
+
+    template <typename T, std::size_t... Is>
+    consteval SigFlags bases_sig_flags(std::index_sequence<Is...>) noexcept {
+        return (SigFlags{} | ... |
+                signature_flags_v<typename [:std::meta::type_of(reflected_bases_v<T>[Is]):]>);
+    }
+
+    template <typename T>
+    consteval SigFlags compute_structural_flags() noexcept {
+        if constexpr (std::is_enum_v<T>) {
+            return signature_flags_v<std::underlying_type_t<T>>;
+        } else if constexpr (std::is_union_v<T>) {
+            return members_sig_flags<T>(std::make_index_sequence<get_member_count<T>()>{});
+        } else if constexpr (std::is_class_v<T>) {
+            constexpr SigFlags self = std::is_polymorphic_v<T> ? pointer_sig_flags : SigFlags{};
+            return self |
+                   bases_sig_flags<T>(std::make_index_sequence<get_base_count<T>()>{}) |
+                   members_sig_flags<T>(std::make_index_sequence<get_member_count<T>()>{});
+        } else {
+            return SigFlags{};   // distinct fundamental integers
+        }
+    }
+
+    // Static flag members of the primary TypeSignature template.
+    template <typename T>
+    struct structural_sig_flags {
+        static constexpr SigFlags flags = compute_structural_flags<T>();
+        static constexpr bool pointer_free         = flags.pointer_free;
+        static constexpr bool has_bitfield         = flags.has_bitfield;
+        static constexpr bool has_platform_variant = flags.has_platform_variant;
+        static constexpr bool has_opaque           = flags.has_opaque;
+    };
+
 } // namespace detail
 } // inline namespace v1
 } // namespace typelayout
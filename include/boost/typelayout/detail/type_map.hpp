@@ -22,11 +22,11 @@ namespace detail {
 
     template<size_t Size, size_t Align, size_t N>
     consteval auto format_size_align(const char (&name)[N]) noexcept {
-        return FixedString{name} + FixedString{"[s:"} +
-               to_fixed_string<Size>() +
-               FixedString{",a:"} +
-               to_fixed_string<Align>() +
-               FixedString{"]"};
+        return concat(name, "[s:",
+                      to_fixed_string<Size>(),
+                      ",a:",
+                      to_fixed_string<Align>(),
+                      "]");
     }
 
     // =========================================================================
@@ -85,9 +85,9 @@ namespace detail {
     }
 
     template <typename T>
-    struct forward_signature {
+    struct forward_signature : embedded_sig_flags<plain_sig_flags, T> {
         static consteval auto calculate() noexcept {
-            return TypeSignature<T>::calculate();
+            return signature_v<T>;
         }
     };
 
@@ -98,18 +98,26 @@ namespace detail {
 
 } // namespace detail
 
-#define BOOST_TYPELAYOUT_LITERAL_SIGNATURE(Type, Sig)                           \
-    template <> struct TypeSignature<Type> {                                    \
+// The two-argument forms give the type plain flags (pointer-free, no
+// bit-field, no platform variant); the _WITH_FLAGS forms take them.
+#define BOOST_TYPELAYOUT_LITERAL_SIGNATURE_WITH_FLAGS(Type, Sig, Flags)         \
+    template <> struct TypeSignature<Type> : detail::fixed_sig_flags<Flags> {   \
         static consteval auto calculate() noexcept { return FixedString{Sig}; } \
     };
 
-#define BOOST_TYPELAYOUT_FORMATTED_SIGNATURE(Type, Name)                                \
-    template <> struct TypeSignature<Type> {                                             \
+#define BOOST_TYPELAYOUT_FORMATTED_SIGNATURE_WITH_FLAGS(Type, Name, Flags)              \
+    template <> struct TypeSignature<Type> : detail::fixed_sig_flags<Flags> {            \
         static consteval auto calculate() noexcept {                                     \
             return detail::format_size_align<sizeof(Type), alignof(Type)>(Name);         \
         }                                                                                \
     };
 
+#define BOOST_TYPELAYOUT_LITERAL_SIGNATURE(Type, Sig) \
+    BOOST_TYPELAYOUT_LITERAL_SIGNATURE_WITH_FLAGS(Type, Sig, detail::plain_sig_flags)
+
+#define BOOST_TYPELAYOUT_FORMATTED_SIGNATURE(Type, Name) \
+    BOOST_TYPELAYOUT_FORMATTED_SIGNATURE_WITH_FLAGS(Type, Name, detail::plain_sig_flags)
+
     // =========================================================================
     // Fixed-width integers
     // =========================================================================
@@ -129,14 +137,15 @@ namespace detail {
 
     BOOST_TYPELAYOUT_LITERAL_SIGNATURE(float, "f32[s:4,a:4]")
     BOOST_TYPELAYOUT_LITERAL_SIGNATURE(double, "f64[s:8,a:8]")
-    BOOST_TYPELAYOUT_FORMATTED_SIGNATURE(long double, BOOST_TYPELAYOUT_LONG_DOUBLE_TAG)
+    BOOST_TYPELAYOUT_FORMATTED_SIGNATURE_WITH_FLAGS(long double, BOOST_TYPELAYOUT_LONG_DOUBLE_TAG,
+                                                    detail::platform_variant_sig_flags)
 
     // =========================================================================
     // Character types
     // =========================================================================
 
     BOOST_TYPELAYOUT_LITERAL_SIGNATURE(char, "char[s:1,a:1]")
-    BOOST_TYPELAYOUT_FORMATTED_SIGNATURE(wchar_t, "wchar")
+    BOOST_TYPELAYOUT_FORMATTED_SIGNATURE_WITH_FLAGS(wchar_t, "wchar", detail::platform_variant_sig_flags)
     BOOST_TYPELAYOUT_LITERAL_SIGNATURE(char8_t, "char8[s:1,a:1]")
     BOOST_TYPELAYOUT_LITERAL_SIGNATURE(char16_t, "char16[s:2,a:2]")
     BOOST_TYPELAYOUT_LITERAL_SIGNATURE(char32_t, "char32[s:4,a:4]")
@@ -154,28 +163,28 @@ namespace detail {
     // =========================================================================
 
     template <typename R, typename... Args>
-    struct TypeSignature<R(*)(Args...)> {
+    struct TypeSignature<R(*)(Args...)> : detail::fixed_sig_flags<detail::pointer_sig_flags> {
         static consteval auto calculate() noexcept {
             return detail::fnptr_signature<R(*)(Args...)>();
         }
     };
 
     template <typename R, typename... Args>
-    struct TypeSignature<R(*)(Args...) noexcept> {
+    struct TypeSignature<R(*)(Args...) noexcept> : detail::fixed_sig_flags<detail::pointer_sig_flags> {
         static consteval auto calculate() noexcept {
             return detail::fnptr_signature<R(*)(Args...) noexcept>();
         }
     };
 
     template <typename R, typename... Args>
-    struct TypeSignature<R(*)(Args..., ...)> {
+    struct TypeSignature<R(*)(Args..., ...)> : detail::fixed_sig_flags<detail::pointer_sig_flags> {
         static consteval auto calculate() noexcept {
             return detail::fnptr_signature<R(*)(Args..., ...)>();
         }
     };
 
     template <typename R, typename... Args>
-    struct TypeSignature<R(*)(Args..., ...) noexcept> {
+    struct TypeSignature<R(*)(Args..., ...) noexcept> : detail::fixed_sig_flags<detail::pointer_sig_flags> {
         static consteval auto calculate() noexcept {
             return detail::fnptr_signature<R(*)(Args..., ...) noexcept>();
         }
@@ -197,32 +206,34 @@ namespace detail {
     // =========================================================================
 
     template <typename T>
-    struct TypeSignature<T*> {
+    struct TypeSignature<T*> : detail::fixed_sig_flags<detail::pointer_sig_flags> {
         static consteval auto calculate() noexcept { return detail::format_size_align<sizeof(T*), alignof(T*)>("ptr"); }
     };
     template <typename T>
-    struct TypeSignature<T&> {
+    struct TypeSignature<T&> : detail::fixed_sig_flags<detail::pointer_sig_flags> {
         // References are stored as pointers; use sizeof(T*) for layout identity.
         static consteval auto calculate() noexcept { return detail::format_size_align<sizeof(T*), alignof(T*)>("ref"); }
     };
     template <typename T>
-    struct TypeSignature<T&&> {
+    struct TypeSignature<T&&> : detail::fixed_sig_flags<detail::pointer_sig_flags> {
         static consteval auto calculate() noexcept { return detail::format_size_align<sizeof(T*), alignof(T*)>("rref"); }
     };
     template <typename T, typename C>
-    struct TypeSignature<T C::*> {
+    struct TypeSignature<T C::*> : detail::fixed_sig_flags<detail::pointer_sig_flags> {
         static consteval auto calculate() noexcept { return detail::format_size_align<sizeof(T C::*), alignof(T C::*)>("memptr"); }
     };
 
 #undef BOOST_TYPELAYOUT_FORMATTED_SIGNATURE
 #undef BOOST_TYPELAYOUT_LITERAL_SIGNATURE
+#undef BOOST_TYPELAYOUT_FORMATTED_SIGNATURE_WITH_FLAGS
+#undef BOOST_TYPELAYOUT_LITERAL_SIGNATURE_WITH_FLAGS
 
     // =========================================================================
     // Arrays
     // =========================================================================
 
     template <typename T>
-    struct TypeSignature<T[]> {
+    struct TypeSignature<T[]> : detail::fixed_sig_flags<detail::plain_sig_flags> {
         static consteval auto calculate() noexcept {
             static_assert(detail::always_false<T>::value, "Unbounded array T[] has no defined size");
             return FixedString{""};
@@ -230,15 +241,15 @@ namespace detail {
     };
 
     template <typename T, size_t N>
-    struct TypeSignature<T[N]> {
+    struct TypeSignature<T[N]> : detail::embedded_sig_flags<detail::plain_sig_flags, T> {
         static consteval auto calculate() noexcept {
             if constexpr (detail::is_byte_element<T>()) {
-                return FixedString{"bytes[s:"} + to_fixed_string<N>() + FixedString{",a:1]"};
+                return detail::concat("bytes[s:", to_fixed_string<N>(), ",a:1]");
             } else {
-                return FixedString{"array[s:"} + to_fixed_string<sizeof(T[N])>() +
-                       FixedString{",a:"} + to_fixed_string<alignof(T[N])>() +
-                       FixedString{"]<"} + TypeSignature<T>::calculate() +
-                       FixedString{","} + to_fixed_string<N>() + FixedString{">"};
+                return detail::concat("array[s:", to_fixed_string<sizeof(T[N])>(),
+                                      ",a:", to_fixed_string<alignof(T[N])>(),
+                                      "]<", detail::signature_v<T>,
+                                      ",", to_fixed_string<N>(), ">");
             }
         }
     };
@@ -248,44 +259,44 @@ namespace detail {
     // =========================================================================
 
     template <typename T>
-    struct TypeSignature {
+    struct TypeSignature : detail::structural_sig_flags<T> {
         static consteval auto calculate() noexcept {
             if constexpr (detail::is_distinct_fundamental_int_v<T>) {
                 return detail::fundamental_int_signature<T>();
             }
             else if constexpr (std::is_enum_v<T>) {
                 using U = std::underlying_type_t<T>;
-                return FixedString{"enum[s:"} +
-                       to_fixed_string<sizeof(T)>() +
-                       FixedString{",a:"} +
-                       to_fixed_string<alignof(T)>() +
-                       FixedString{"]<"} + TypeSignature<U>::calculate() + FixedString{">"};
+                return detail::concat("enum[s:",
+                                      to_fixed_string<sizeof(T)>(),
+                                      ",a:",
+                                      to_fixed_string<alignof(T)>(),
+                                      "]<", detail::signature_v<U>, ">");
             }
             else if constexpr (std::is_union_v<T>) {
-                return FixedString{"union[s:"} + to_fixed_string<sizeof(T)>() +
-                       FixedString{",a:"} + to_fixed_string<alignof(T)>() +
-                       FixedString{"]{"} + detail::get_layout_union_content<T>() + FixedString{"}"};
+                return detail::concat("union[s:", to_fixed_string<sizeof(T)>(),
+                                      ",a:", to_fixed_string<alignof(T)>(),
+                                      "]{", detail::get_layout_union_content<T>(), "}");
             }
             else if constexpr (std::is_class_v<T>) {
                 if constexpr (std::is_polymorphic_v<T>) {
                     // Polymorphic types have a hidden vptr.  Mark it as a flag
                     // in the record params (not as a field, since P2996 does not
-                    // expose its offset).  sig_has_pointer scans for "vptr" token.
-                    return FixedString{"record[s:"} +
-                           to_fixed_string<sizeof(T)>() +
-                           FixedString{",a:"} +
-                           to_fixed_string<alignof(T)>() +
-                           FixedString{",vptr]{"} +
-                           detail::get_layout_content<T>() +
-                           FixedString{"}"};
+                    // expose its offset); structural_sig_flags clears pointer_free.
+                    return detail::concat("record[s:",
+                                          to_fixed_string<sizeof(T)>(),
+                                          ",a:",
+                                          to_fixed_string<alignof(T)>(),
+                                          ",vptr]{",
+                                          detail::get_layout_content<T>(),
+                                          "}");
                 } else {
-                    return FixedString{"record[s:"} +
-                           to_fixed_string<sizeof(T)>() +
-                           FixedString{",a:"} +
-                           to_fixed_string<alignof(T)>() +
-                           FixedString{"]{"} +
-                           detail::get_layout_content<T>() +
-                           FixedString{"}"};
+                    return detail::concat("record[s:",
+                                          to_fixed_string<sizeof(T)>(),
+                                          ",a:",
+                                          to_fixed_string<alignof(T)>(),
+                                          "]{",
+                                          detail::get_layout_content<T>(),
+                                          "}");
                 }
             }
             else if constexpr (std::is_void_v<T>) {
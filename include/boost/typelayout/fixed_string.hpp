@@ -227,6 +227,49 @@ inline namespace v1 {
 
 namespace detail {
 
+// Two-pass signature builder.
+//
+// concat(parts...) sizes the result from the parts' static lengths (pass
+// one, entirely at the type level) and then copies every part exactly once
+// into a single FixedString buffer (pass two).  Chaining operator+ instead
+// re-copies the accumulated prefix at every step, which turns a fold over
+// n fields into O(n^2) character copies.
+//
+// Parts may be FixedString<N> or string literals; as with operator+, a
+// FixedString<N> contributes all N of its characters.
+
+template <typename Part>
+struct sig_part_length;
+
+template <size_t N>
+struct sig_part_length<FixedString<N>> : std::integral_constant<size_t, N> {};
+
+template <size_t N>
+struct sig_part_length<char[N]> : std::integral_constant<size_t, N - 1> {};
+
+template <size_t N>
+consteval void write_sig_part(char* out, size_t& pos,
+                              const FixedString<N>& part) noexcept {
+    for (size_t i = 0; i < N; ++i)
+        out[pos++] = part.value[i];
+}
+
+template <size_t N>
+consteval void write_sig_part(char* out, size_t& pos,
+                              const char (&part)[N]) noexcept {
+    for (size_t i = 0; i + 1 < N; ++i)
+        out[pos++] = part[i];
+}
+
+template <typename... Parts>
+[[nodiscard]] consteval auto concat(const Parts&... parts) noexcept {
+    constexpr size_t total = (size_t{0} + ... + sig_part_length<Parts>::value);
+    FixedString<total> result;
+    size_t pos = 0;
+    (write_sig_part(result.value, pos, parts), ...);
+    return result;
+}
+
 template <typename Sig>
 consteval bool sig_has_pointer(const Sig& sig) noexcept {
     return sig_has_pointer(std::string_view(sig));
@@ -27,6 +27,15 @@ inline namespace v1 {
     template <typename T>
     struct TypeSignature;
 
+    namespace detail {
+    // Memoized TypeSignature<T>::calculate().  A variable template is
+    // instantiated (and constant-evaluated) once per T, so every enclosing
+    // signature that embeds T -- arrays, enums, opaque containers, nested
+    // records -- reuses the same string instead of re-reflecting T.
+    template <typename T>
+    inline constexpr auto signature_v = TypeSignature<T>::calculate();
+    } // namespace detail
+
     // Default trait for opaque element type safety.
     // Returns false unless explicitly specialized by opaque registration macros.
     // Used by is_byte_copy_safe to check whether an opaque container's
@@ -34,6 +43,12 @@ inline namespace v1 {
     template <typename T>
     struct opaque_copy_safe : std::false_type {};
 
+    // Annotation (P3394) selecting a class for
+    // SigExporter::add_namespace<^^ns, namespace_filter::annotated>():
+    //   struct [[=boost::typelayout::export_layout]] PacketHeader { ... };
+    struct export_layout_t {};
+    inline constexpr export_layout_t export_layout{};
+
 } // inline namespace v1
 } // namespace typelayout
 } // namespace boost
@@ -0,0 +1,38 @@
+// Error reporting shared by the IPC primitives: their operations return
+// false and, when the caller passes a std::string*, describe the failure
+// there.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_DETAIL_ERROR_HPP
+#define BOOST_TYPELAYOUT_IPC_DETAIL_ERROR_HPP
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+namespace detail {
+
+/// Stores `message`, plus strerror(errno) when errno is set, in `*error`
+/// (if given).  Always false, so a failing call can return it directly.
+inline bool fail_with_errno(std::string* error, std::string message) {
+    if (error) {
+        if (errno != 0) (message += ": ") += std::strerror(errno);
+        *error = std::move(message);
+    }
+    return false;
+}
+
+} // namespace detail
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_DETAIL_ERROR_HPP
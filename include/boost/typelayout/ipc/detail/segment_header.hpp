@@ -0,0 +1,130 @@
+// SegmentHeader -- the first 64 bytes of every segment created by the IPC
+// primitives, and of every mapped_record_file: what the segment is
+// (region, ring, record file), where its payload lies and the
+// layout_stamp of the payload type.
+//
+// The creator writes the header and publishes it last, with a release
+// store of the magic number; an attacher that loads the magic with
+// acquire and finds it set sees a complete header.  verify_segment()
+// is O(1): a handful of integer compares, whatever the payload size.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_DETAIL_SEGMENT_HEADER_HPP
+#define BOOST_TYPELAYOUT_IPC_DETAIL_SEGMENT_HEADER_HPP
+
+#include <boost/typelayout/ipc/layout_stamp.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+namespace detail {
+
+inline constexpr std::uint32_t segment_magic   = 0x544c5347u;   // "TLSG"
+inline constexpr std::uint16_t segment_version = 1;
+inline constexpr std::size_t   segment_header_size = 64;
+
+enum class SegmentKind : std::uint16_t {
+    region  = 1,   // shm_region<T>: one T
+    ring    = 2,   // spsc_ring<T> / mpsc_ring<T>
+    records = 3    // mapped_record_file<T>: payload_size / sizeof(T) Ts
+};
+
+inline const char* segment_kind_name(std::uint16_t kind) noexcept {
+    switch (static_cast<SegmentKind>(kind)) {
+        case SegmentKind::region:  return "shm_region";
+        case SegmentKind::ring:    return "ring";
+        case SegmentKind::records: return "record file";
+    }
+    return "unknown segment";
+}
+
+struct SegmentHeader {
+    std::atomic<std::uint32_t> magic;            // segment_magic once published
+    std::uint16_t              version;
+    std::uint16_t              kind;             // SegmentKind
+    std::uint64_t              payload_offset;   // from the segment start
+    std::uint64_t              payload_size;     // bytes
+    layout_stamp               stamp;            // of the payload type
+};
+
+static_assert(sizeof(SegmentHeader) <= segment_header_size,
+              "SegmentHeader outgrew its reserved space");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+              "shared-memory headers need a lock-free 32-bit atomic");
+
+/// Offset of a payload aligned to `align` (at least a cache line) after
+/// the header.
+constexpr std::size_t segment_payload_offset(std::size_t align) noexcept {
+    const std::size_t a = align < segment_header_size ? segment_header_size : align;
+    return (segment_header_size + a - 1) / a * a;
+}
+
+/// Writes the header into a zero-filled segment, unpublished.
+inline SegmentHeader* init_segment(unsigned char* base, SegmentKind kind,
+                                   std::uint64_t payload_offset,
+                                   std::uint64_t payload_size,
+                                   const layout_stamp& stamp) noexcept {
+    auto* h = ::new (base) SegmentHeader{};
+    h->version = segment_version;
+    h->kind = static_cast<std::uint16_t>(kind);
+    h->payload_offset = payload_offset;
+    h->payload_size = payload_size;
+    h->stamp = stamp;
+    return h;
+}
+
+/// Makes the header (and everything written before) visible to attachers.
+inline void publish_segment(SegmentHeader* h) noexcept {
+    h->magic.store(segment_magic, std::memory_order_release);
+}
+
+/// Checks a mapped segment of `size` bytes against the expected kind and
+/// stamp.  Returns the header, or nullptr with `error` set.  With
+/// `payload_may_grow` the payload size is left to the caller, which must
+/// clamp it to the mapping: another process may still be extending it.
+inline const SegmentHeader* verify_segment(const unsigned char* base, std::size_t size,
+                                           SegmentKind kind, const layout_stamp& expected,
+                                           std::string* error,
+                                           bool payload_may_grow = false) {
+    auto fail = [error](std::string message) -> const SegmentHeader* {
+        if (error) *error = std::move(message);
+        return nullptr;
+    };
+    if (size < segment_header_size)
+        return fail("segment too small for a TypeLayout header");
+    const auto* h = std::launder(reinterpret_cast<const SegmentHeader*>(base));
+    if (h->magic.load(std::memory_order_acquire) != segment_magic)
+        return fail("not a TypeLayout segment, or not initialised yet");
+    if (h->version != segment_version)
+        return fail("segment version " + std::to_string(h->version) +
+                    ", expected " + std::to_string(segment_version));
+    if (h->kind != static_cast<std::uint16_t>(kind))
+        return fail(std::string("segment holds a ") + segment_kind_name(h->kind) +
+                    ", expected a " + segment_kind_name(static_cast<std::uint16_t>(kind)));
+    if (!(h->stamp == expected))
+        return fail("layout mismatch: segment has " + describe(h->stamp) +
+                    ", this build expects " + describe(expected));
+    if (h->payload_offset < segment_header_size || h->payload_offset > size ||
+        (!payload_may_grow && h->payload_size > size - h->payload_offset) ||
+        h->payload_offset % (expected.align ? expected.align : 1) != 0)
+        return fail("segment payload lies outside the mapping");
+    return h;
+}
+
+} // namespace detail
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_DETAIL_SEGMENT_HEADER_HPP
@@ -0,0 +1,192 @@
+// SharedMemory -- a read-write shared mapping of a POSIX shared memory
+// object: a named shm_open() segment, or an anonymous memfd whose file
+// descriptor is handed to the peer (fork, SCM_RIGHTS).
+//
+// The creator of a named segment unlinks the name when it closes, and
+// the memory goes once the last process detaches.  A creator that dies
+// without closing leaves the name behind (it lives until reboot, or under
+// /dev/shm on Linux), and create() then fails with EEXIST: whoever owns
+// the name -- typically the creator on restart -- calls remove() first.
+// Anonymous segments have no name and vanish with their last descriptor
+// or mapping, crash or not.  The mapping does not move when the
+// SharedMemory is moved.
+//
+// POSIX only.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_DETAIL_SHARED_MEMORY_HPP
+#define BOOST_TYPELAYOUT_IPC_DETAIL_SHARED_MEMORY_HPP
+
+#if defined(_WIN32)
+#error "boost/typelayout/ipc requires POSIX shared memory"
+#endif
+
+#include <boost/typelayout/ipc/detail/error.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+namespace detail {
+
+class SharedMemory {
+public:
+    SharedMemory() = default;
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    SharedMemory(SharedMemory&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , fd_(std::exchange(other.fd_, -1))
+        , unlink_(std::move(other.unlink_)) {
+        other.unlink_.clear();
+    }
+
+    SharedMemory& operator=(SharedMemory&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            fd_ = std::exchange(other.fd_, -1);
+            unlink_ = std::move(other.unlink_);
+            other.unlink_.clear();
+        }
+        return *this;
+    }
+
+    ~SharedMemory() { close(); }
+
+    /// Creates the named segment `name` ("/name") of `size` zero bytes;
+    /// fails if it already exists.
+    bool create(const std::string& name, std::size_t size, std::string* error = nullptr) {
+        close();
+        int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) return fail_with_errno(error, "cannot create " + name);
+        if (!resize_and_map(fd, size, error, name)) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return false;
+        }
+        ::close(fd);
+        unlink_ = name;
+        return true;
+    }
+
+    /// Creates an anonymous segment of `size` zero bytes.  fd() stays open
+    /// for passing to the peer.  Uses memfd_create() where available, else
+    /// a uniquely named segment that is unlinked at once.
+    bool create_anonymous(std::size_t size, std::string* error = nullptr) {
+        close();
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+        int fd = ::memfd_create("typelayout", MFD_CLOEXEC);
+        if (fd < 0) return fail_with_errno(error, "cannot create anonymous segment");
+#else
+        std::string name = "/typelayout." + std::to_string(::getpid()) + "." +
+                           std::to_string(reinterpret_cast<std::uintptr_t>(this));
+        int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) return fail_with_errno(error, "cannot create anonymous segment");
+        ::shm_unlink(name.c_str());
+#endif
+        if (!resize_and_map(fd, size, error, "anonymous segment")) {
+            ::close(fd);
+            return false;
+        }
+        fd_ = fd;
+        return true;
+    }
+
+    /// Unlinks the named segment `name`, e.g. one left by a creator that
+    /// crashed.  Processes still attached keep their mapping.  A name
+    /// that does not exist is not an error.
+    static bool remove(const std::string& name, std::string* error = nullptr) {
+        if (::shm_unlink(name.c_str()) == 0 || errno == ENOENT) return true;
+        return fail_with_errno(error, "cannot remove " + name);
+    }
+
+    /// Maps the existing named segment `name`, whole.
+    bool open(const std::string& name, std::string* error = nullptr) {
+        close();
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) return fail_with_errno(error, "cannot open " + name);
+        bool ok = map_existing(fd, error, name);
+        ::close(fd);
+        return ok;
+    }
+
+    /// Maps the segment behind `fd`, whole.  `fd` is borrowed: the caller
+    /// keeps ownership and may close it once this returns.
+    bool open_fd(int fd, std::string* error = nullptr) {
+        close();
+        return map_existing(fd, error, "fd " + std::to_string(fd));
+    }
+
+    void close() noexcept {
+        if (data_) ::munmap(data_, size_);
+        if (fd_ >= 0) ::close(fd_);
+        if (!unlink_.empty()) ::shm_unlink(unlink_.c_str());
+        data_ = nullptr;
+        size_ = 0;
+        fd_ = -1;
+        unlink_.clear();
+    }
+
+    unsigned char* data() const noexcept { return static_cast<unsigned char*>(data_); }
+    std::size_t    size() const noexcept { return size_; }
+
+    /// File descriptor of an anonymous segment, else -1.
+    int fd() const noexcept { return fd_; }
+
+private:
+    void*       data_ = nullptr;
+    std::size_t size_ = 0;
+    int         fd_ = -1;
+    std::string unlink_;   // name to shm_unlink() on close (creator only)
+
+    bool resize_and_map(int fd, std::size_t size, std::string* error,
+                        const std::string& what) {
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+            return fail_with_errno(error, "cannot size " + what);
+        return map(fd, size, error, what);
+    }
+
+    bool map_existing(int fd, std::string* error, const std::string& what) {
+        struct stat st;
+        if (::fstat(fd, &st) != 0) return fail_with_errno(error, "cannot stat " + what);
+        if (st.st_size == 0) {
+            errno = 0;
+            return fail_with_errno(error, what + " is empty");
+        }
+        return map(fd, static_cast<std::size_t>(st.st_size), error, what);
+    }
+
+    bool map(int fd, std::size_t size, std::string* error, const std::string& what) {
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) return fail_with_errno(error, "cannot map " + what);
+        data_ = p;
+        size_ = size;
+        return true;
+    }
+};
+
+} // namespace detail
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_DETAIL_SHARED_MEMORY_HPP
@@ -0,0 +1,302 @@
+// Socket helpers for socket_channel: connecting and listening on TCP and
+// Unix domain stream sockets, and blocking whole-buffer I/O that retries
+// on EINTR and never raises SIGPIPE.
+//
+// POSIX only.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_DETAIL_SOCKET_HPP
+#define BOOST_TYPELAYOUT_IPC_DETAIL_SOCKET_HPP
+
+#if defined(_WIN32)
+#error "boost/typelayout/ipc requires POSIX sockets"
+#endif
+
+#include <boost/typelayout/ipc/detail/error.hpp>
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+namespace detail {
+
+#if defined(MSG_NOSIGNAL)
+inline constexpr int socket_send_flags = MSG_NOSIGNAL;
+#else
+inline constexpr int socket_send_flags = 0;   // socket_no_sigpipe() instead
+#endif
+
+#if defined(IOV_MAX)
+inline constexpr std::size_t socket_iov_max = IOV_MAX;
+#else
+inline constexpr std::size_t socket_iov_max = 16;   // the POSIX minimum
+#endif
+
+#if defined(SOCK_CLOEXEC)
+inline constexpr int socket_cloexec = SOCK_CLOEXEC;
+#else
+inline constexpr int socket_cloexec = 0;
+#endif
+
+/// Suppresses SIGPIPE where MSG_NOSIGNAL is missing (macOS).
+inline void socket_no_sigpipe(int fd) noexcept {
+#if defined(SO_NOSIGPIPE)
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#else
+    (void)fd;
+#endif
+}
+
+inline bool fill_unix_address(const std::string& path, sockaddr_un& addr,
+                              std::string* error) {
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        errno = 0;
+        return fail_with_errno(error, "socket path too long: " + path);
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+/// Connected TCP socket to host:port with Nagle off, or -1.
+inline int connect_tcp(const std::string& host, std::uint16_t port, std::string* error) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* list = nullptr;
+    const std::string service = std::to_string(port);
+    if (int rc = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &list); rc != 0) {
+        if (error) *error = "cannot resolve " + host + ": " + ::gai_strerror(rc);
+        return -1;
+    }
+    int fd = -1;
+    for (addrinfo* ai = list; ai && fd < 0; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype | socket_cloexec, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    ::freeaddrinfo(list);
+    if (fd < 0) {
+        fail_with_errno(error, "cannot connect to " + host + ":" + service);
+        return -1;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    socket_no_sigpipe(fd);
+    return fd;
+}
+
+/// Connected Unix domain stream socket to `path`, or -1.
+inline int connect_unix(const std::string& path, std::string* error) {
+    sockaddr_un addr;
+    if (!fill_unix_address(path, addr, error)) return -1;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | socket_cloexec, 0);
+    if (fd < 0) {
+        fail_with_errno(error, "cannot create socket");
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        fail_with_errno(error, "cannot connect to " + path);
+        ::close(fd);
+        return -1;
+    }
+    socket_no_sigpipe(fd);
+    return fd;
+}
+
+/// Listening TCP socket on host:port (port 0 picks a free one), or -1;
+/// `bound` receives the port actually bound.
+inline int listen_tcp(const std::string& host, std::uint16_t port, std::uint16_t* bound,
+                      std::string* error) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* list = nullptr;
+    const std::string service = std::to_string(port);
+    if (int rc = ::getaddrinfo(host.empty() ? nullptr : host.c_str(), service.c_str(),
+                               &hints, &list);
+        rc != 0) {
+        if (error) *error = "cannot resolve " + host + ": " + ::gai_strerror(rc);
+        return -1;
+    }
+    int fd = -1;
+    for (addrinfo* ai = list; ai && fd < 0; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype | socket_cloexec, ai->ai_protocol);
+        if (fd < 0) continue;
+        int one = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (::bind(fd, ai->ai_addr, ai->ai_addrlen) != 0 || ::listen(fd, SOMAXCONN) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    ::freeaddrinfo(list);
+    if (fd < 0) {
+        fail_with_errno(error, "cannot listen on " + host + ":" + service);
+        return -1;
+    }
+    sockaddr_storage addr{};
+    socklen_t len = sizeof(addr);
+    if (bound && ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        if (addr.ss_family == AF_INET)
+            *bound = ntohs(reinterpret_cast<const sockaddr_in&>(addr).sin_port);
+        else if (addr.ss_family == AF_INET6)
+            *bound = ntohs(reinterpret_cast<const sockaddr_in6&>(addr).sin6_port);
+    }
+    return fd;
+}
+
+/// Listening Unix domain stream socket at `path`, or -1.  A stale socket
+/// file at `path` is replaced.
+inline int listen_unix(const std::string& path, std::string* error) {
+    sockaddr_un addr;
+    if (!fill_unix_address(path, addr, error)) return -1;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | socket_cloexec, 0);
+    if (fd < 0) {
+        fail_with_errno(error, "cannot create socket");
+        return -1;
+    }
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        fail_with_errno(error, "cannot listen on " + path);
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/// Sends all of iov[0, count), advancing through partial writes.  The
+/// iovec array is consumed.
+inline bool send_all(int fd, iovec* iov, std::size_t count, std::string* error) {
+    while (count > 0) {
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count < socket_iov_max ? count : socket_iov_max;
+        const ssize_t n = ::sendmsg(fd, &msg, socket_send_flags);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return fail_with_errno(error, "send failed");
+        }
+        auto left = static_cast<std::size_t>(n);
+        while (count > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+            iov->iov_len -= left;
+        }
+    }
+    return true;
+}
+
+inline bool send_all(int fd, const void* data, std::size_t size, std::string* error) {
+    iovec iov{const_cast<void*>(data), size};
+    return send_all(fd, &iov, 1, error);
+}
+
+/// Receives up to `size` bytes, at least one; 0 on orderly shutdown, -1
+/// on error.
+inline ssize_t receive_some(int fd, void* data, std::size_t size, std::string* error) {
+    for (;;) {
+        const ssize_t n = ::recv(fd, data, size, 0);
+        if (n >= 0) return n;
+        if (errno != EINTR) {
+            fail_with_errno(error, "receive failed");
+            return -1;
+        }
+    }
+}
+
+/// Receives exactly `size` bytes.
+inline bool receive_all(int fd, void* data, std::size_t size, std::string* error) {
+    auto* p = static_cast<unsigned char*>(data);
+    while (size > 0) {
+        const ssize_t n = receive_some(fd, p, size, error);
+        if (n < 0) return false;
+        if (n == 0) {
+            errno = 0;
+            return fail_with_errno(error, "peer closed the connection");
+        }
+        p += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+/// Sends `out_size` bytes from `out` while receiving exactly `in_size`
+/// bytes into `in`.  Two peers may both call it at once with exchanges
+/// larger than their socket buffers: each drains the other while it
+/// writes, so neither blocks on a full buffer.
+inline bool exchange_all(int fd, const void* out, std::size_t out_size,
+                         void* in, std::size_t in_size, std::string* error) {
+    auto* o = static_cast<const unsigned char*>(out);
+    auto* i = static_cast<unsigned char*>(in);
+    while (out_size > 0 || in_size > 0) {
+        pollfd p{fd, static_cast<short>((in_size > 0 ? POLLIN : 0) |
+                                        (out_size > 0 ? POLLOUT : 0)), 0};
+        if (::poll(&p, 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            return fail_with_errno(error, "poll failed");
+        }
+        const bool broken = (p.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+        if (in_size > 0 && (p.revents & POLLIN || broken)) {
+            const ssize_t n = ::recv(fd, i, in_size, MSG_DONTWAIT);
+            if (n == 0) {
+                errno = 0;
+                return fail_with_errno(error, "peer closed the connection");
+            }
+            if (n > 0) {
+                i += n;
+                in_size -= static_cast<std::size_t>(n);
+            } else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                return fail_with_errno(error, "receive failed");
+            }
+        }
+        if (out_size > 0 && (p.revents & POLLOUT || broken)) {
+            const ssize_t n = ::send(fd, o, out_size, socket_send_flags | MSG_DONTWAIT);
+            if (n > 0) {
+                o += n;
+                out_size -= static_cast<std::size_t>(n);
+            } else if (n < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                return fail_with_errno(error, "send failed");
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_DETAIL_SOCKET_HPP
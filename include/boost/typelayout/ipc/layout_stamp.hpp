@@ -0,0 +1,85 @@
+// layout_stamp -- the layout identity of a type, in a fixed 32-byte form
+// that can be stored next to shared or persisted data and compared in O(1).
+//
+// A stamp holds get_layout_hash<T>() (FNV-1a over the full layout
+// signature, arch prefix included), the arch prefix itself, sizeof(T) and
+// alignof(T).  Two independently built programs that agree on a stamp
+// agree on the byte layout of T, so data written by one can be used in
+// place by the other: the IPC primitives check the stamp once, when a
+// segment is attached, instead of validating every record.
+//
+// The hash alone decides layout equality; the other fields make the stamp
+// self-describing, so a mismatch can be reported as "[32-le], 24 bytes"
+// rather than as two opaque hashes.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_LAYOUT_STAMP_HPP
+#define BOOST_TYPELAYOUT_IPC_LAYOUT_STAMP_HPP
+
+#include <boost/typelayout/signature.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+
+struct layout_stamp {
+    std::uint64_t layout_hash;   // get_layout_hash<T>()
+    char          arch[8];       // get_layout_signature<T>()'s "[64-le]", NUL-padded
+    std::uint64_t size;          // sizeof(T)
+    std::uint64_t align;         // alignof(T)
+
+    std::string_view arch_prefix() const noexcept {
+        std::size_t n = 0;
+        while (n < sizeof(arch) && arch[n] != '\0') ++n;
+        return {arch, n};
+    }
+
+    friend constexpr bool operator==(const layout_stamp& a,
+                                     const layout_stamp& b) noexcept {
+        if (a.layout_hash != b.layout_hash || a.size != b.size || a.align != b.align)
+            return false;
+        for (std::size_t i = 0; i < sizeof(a.arch); ++i)
+            if (a.arch[i] != b.arch[i]) return false;
+        return true;
+    }
+};
+
+static_assert(sizeof(layout_stamp) == 32, "layout_stamp is a wire format");
+
+/// The stamp of T on this platform.
+template <typename T>
+[[nodiscard]] consteval layout_stamp layout_stamp_of() noexcept {
+    layout_stamp s{get_layout_hash<T>(), {}, sizeof(T), alignof(T)};
+    constexpr auto prefix = detail::get_arch_prefix();
+    static_assert(prefix.size < sizeof(s.arch), "arch prefix does not fit a stamp");
+    for (std::size_t i = 0; i < prefix.size; ++i) s.arch[i] = prefix.value[i];
+    return s;
+}
+
+/// "[64-le] size=24 align=8 hash=0x..." for diagnostics.
+inline std::string describe(const layout_stamp& s) {
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15, h = 0; i >= 0; --i, ++h)
+        hex[static_cast<std::size_t>(i)] = digits[(s.layout_hash >> (4 * h)) & 0xf];
+    std::string out(s.arch_prefix());
+    if (out.empty()) out = "[?]";
+    out += " size=" + std::to_string(s.size) + " align=" + std::to_string(s.align) +
+           " hash=0x" + hex;
+    return out;
+}
+
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_LAYOUT_STAMP_HPP
@@ -0,0 +1,355 @@
+// mapped_record_file<T> -- a file of fixed-layout records, read in place
+// through a memory mapping.
+//
+//   // writer
+//   ipc::mapped_record_file<SensorRecord> log;
+//   if (!log.create("telemetry.tlr", &error)) ...
+//   log.append(std::span<const SensorRecord>(batch, n), &error);
+//
+//   // reader (another build, maybe another compiler)
+//   ipc::mapped_record_file<SensorRecord> log;
+//   if (!log.open("telemetry.tlr", &error)) ...   // layout checked here
+//   log.advise(ipc::access_hint::sequential);
+//   for (const SensorRecord& r : log.records()) ...   // no parsing, no copy
+//
+// The file starts with the common segment header (detail/segment_header.hpp)
+// holding the layout_stamp of T -- get_layout_hash<T>(), the arch prefix,
+// sizeof(T), alignof(T) -- and the byte count of the records that follow.
+// open() compares the stamp with this build's in O(1), whatever the file
+// size, and then hands out the mapped body as a span<const T>: a
+// multi-gigabyte log costs one mmap(), and pages are read as the records
+// are touched.
+//
+// A writer (create(), open_append()) keeps spare capacity past the last
+// record and grows the file geometrically, remapping it (mremap() where
+// available); growth invalidates spans and references obtained earlier.
+// append() copies the records first and then bumps the header's byte
+// count, so a crashed writer leaves a file whose header still describes
+// complete records only; close() trims the spare capacity.  flush()
+// makes the file durable.  One writer per file; the writer publishes the
+// byte count with a release store, and a reader loads it once, in open(),
+// so it sees the records committed when it opened the file and no more.
+//
+// advise() passes madvise() hints -- sequential or random access,
+// prefetch, transparent huge pages -- for the whole mapping.  Hints are
+// advisory: a refused hint returns false and changes nothing else.
+//
+// Only byte-copy-safe, trivially copyable types are admitted.  POSIX only.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_MAPPED_RECORD_FILE_HPP
+#define BOOST_TYPELAYOUT_IPC_MAPPED_RECORD_FILE_HPP
+
+#if defined(_WIN32)
+#error "boost/typelayout/ipc requires POSIX memory mapping"
+#endif
+
+#include <boost/typelayout/admission.hpp>
+#include <boost/typelayout/ipc/layout_stamp.hpp>
+#include <boost/typelayout/ipc/detail/error.hpp>
+#include <boost/typelayout/ipc/detail/segment_header.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+
+enum class access_hint {
+    normal,       // MADV_NORMAL: the kernel's default read-ahead
+    sequential,   // MADV_SEQUENTIAL: aggressive read-ahead, early reclaim
+    random,       // MADV_RANDOM: no read-ahead
+    willneed,     // MADV_WILLNEED: start reading the whole file now
+    hugepage      // MADV_HUGEPAGE: back the mapping with huge pages
+};
+
+template <typename T>
+    requires (is_byte_copy_safe_v<T> && std::is_trivially_copyable_v<T>)
+class mapped_record_file {
+public:
+    using value_type = T;
+
+    /// The stamp written by create() and required by open().
+    static constexpr layout_stamp stamp = layout_stamp_of<T>();
+
+    mapped_record_file() = default;
+    mapped_record_file(const mapped_record_file&) = delete;
+    mapped_record_file& operator=(const mapped_record_file&) = delete;
+
+    mapped_record_file(mapped_record_file&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr))
+        , mapped_(std::exchange(other.mapped_, 0))
+        , count_(std::exchange(other.count_, 0))
+        , fd_(std::exchange(other.fd_, -1))
+        , hint_(other.hint_) {}
+
+    mapped_record_file& operator=(mapped_record_file&& other) noexcept {
+        if (this != &other) {
+            close();
+            base_ = std::exchange(other.base_, nullptr);
+            mapped_ = std::exchange(other.mapped_, 0);
+            count_ = std::exchange(other.count_, 0);
+            fd_ = std::exchange(other.fd_, -1);
+            hint_ = other.hint_;
+        }
+        return *this;
+    }
+
+    ~mapped_record_file() { close(); }
+
+    /// Creates `path` holding no records, replacing any existing file, and
+    /// opens it for appending.
+    bool create(const std::string& path, std::string* error = nullptr) {
+        close();
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) return detail::fail_with_errno(error, "cannot create " + path);
+        if (::ftruncate(fd, static_cast<off_t>(payload_offset)) != 0 ||
+            !map(fd, payload_offset, PROT_READ | PROT_WRITE)) {
+            detail::fail_with_errno(error, "cannot size " + path);
+            ::close(fd);
+            return false;
+        }
+        fd_ = fd;
+        auto* h = detail::init_segment(base_, detail::SegmentKind::records,
+                                       payload_offset, 0, stamp);
+        detail::publish_segment(h);
+        return true;
+    }
+
+    /// Maps `path` read-only, verifying its layout stamp.
+    bool open(const std::string& path, std::string* error = nullptr) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return detail::fail_with_errno(error, "cannot open " + path);
+        bool ok = map_existing(fd, PROT_READ, path, error);
+        ::close(fd);
+        return ok;
+    }
+
+    /// Maps the existing `path` for appending, verifying its layout stamp.
+    bool open_append(const std::string& path, std::string* error = nullptr) {
+        close();
+        int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) return detail::fail_with_errno(error, "cannot open " + path);
+        if (!map_existing(fd, PROT_READ | PROT_WRITE, path, error)) {
+            ::close(fd);
+            return false;
+        }
+        fd_ = fd;
+        return true;
+    }
+
+    /// Unmaps the file; a writer first trims it to the committed records.
+    void close() noexcept {
+        if (base_) {
+            ::munmap(base_, mapped_);
+            if (fd_ >= 0)
+                (void)::ftruncate(fd_, static_cast<off_t>(payload_offset + count_ * sizeof(T)));
+        }
+        if (fd_ >= 0) ::close(fd_);
+        base_ = nullptr;
+        mapped_ = 0;
+        count_ = 0;
+        fd_ = -1;
+        hint_ = access_hint::normal;
+    }
+
+    bool is_open() const noexcept { return base_ != nullptr; }
+    bool writable() const noexcept { return fd_ >= 0; }
+    explicit operator bool() const noexcept { return is_open(); }
+
+    /// The committed records, in place.  Invalidated by growth and close().
+    std::span<const T> records() const noexcept {
+        if (!base_) return {};
+        return {std::launder(reinterpret_cast<const T*>(base_ + payload_offset)), size()};
+    }
+
+    /// Records committed when the file was opened, plus those appended
+    /// through this object since.
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return size() == 0; }
+
+    /// Record `i`.  Requires i < size().
+    const T& operator[](std::size_t i) const noexcept { return records()[i]; }
+
+    /// Records that fit before the file must grow.
+    std::size_t capacity() const noexcept {
+        return base_ ? (mapped_ - payload_offset) / sizeof(T) : 0;
+    }
+
+    /// Grows the file to hold at least `count` records.  Requires writable().
+    bool reserve(std::size_t count, std::string* error = nullptr) {
+        if (!writable()) return fail_plain(error, "record file is not open for writing");
+        return count <= capacity() || grow(count * sizeof(T), error);
+    }
+
+    /// Appends the records, growing the file as needed, and commits them
+    /// in the header.  Requires writable().
+    bool append(std::span<const T> records, std::string* error = nullptr) {
+        if (!writable()) return fail_plain(error, "record file is not open for writing");
+        const std::size_t used = count_ * sizeof(T);
+        const std::size_t bytes = records.size_bytes();
+        if (payload_offset + used + bytes > mapped_ && !grow(used + bytes, error))
+            return false;
+        if (bytes != 0) std::memcpy(base_ + payload_offset + used, records.data(), bytes);
+        count_ += records.size();
+        committed_bytes().store(count_ * sizeof(T), std::memory_order_release);
+        return true;
+    }
+
+    bool append(const T& record, std::string* error = nullptr) {
+        return append(std::span<const T>(&record, 1), error);
+    }
+
+    /// Writes the committed records and the header to disk (msync).
+    bool flush(std::string* error = nullptr) {
+        if (!base_) return fail_plain(error, "record file is not open");
+        if (::msync(base_, payload_offset + count_ * sizeof(T), MS_SYNC) != 0)
+            return detail::fail_with_errno(error, "cannot flush record file");
+        return true;
+    }
+
+    /// Applies `hint` to the whole mapping, and again after every growth.
+    bool advise(access_hint hint, std::string* error = nullptr) {
+        if (!base_) return fail_plain(error, "record file is not open");
+        if (!apply_hint(hint, error)) return false;
+        hint_ = hint;
+        return true;
+    }
+
+private:
+    static constexpr std::size_t payload_offset =
+        detail::segment_payload_offset(alignof(T));
+
+    unsigned char* base_ = nullptr;
+    std::size_t    mapped_ = 0;                     // bytes mapped = file size
+    std::size_t    count_ = 0;                      // records size() reports
+    int            fd_ = -1;                        // writers only
+    access_hint    hint_ = access_hint::normal;
+
+    detail::SegmentHeader* header() const noexcept {
+        return std::launder(reinterpret_cast<detail::SegmentHeader*>(base_));
+    }
+
+    /// The header's byte count, which a writer in another process may
+    /// advance while this one reads it.
+    std::atomic_ref<std::uint64_t> committed_bytes() const noexcept {
+        return std::atomic_ref<std::uint64_t>(header()->payload_size);
+    }
+
+    bool map(int fd, std::size_t size, int prot) {
+        void* p = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) return false;
+        base_ = static_cast<unsigned char*>(p);
+        mapped_ = size;
+        return true;
+    }
+
+    bool map_existing(int fd, int prot, const std::string& path, std::string* error) {
+        struct stat st;
+        if (::fstat(fd, &st) != 0) return detail::fail_with_errno(error, "cannot stat " + path);
+        if (st.st_size == 0) return fail_plain(error, path + " is empty");
+        if (!map(fd, static_cast<std::size_t>(st.st_size), prot))
+            return detail::fail_with_errno(error, "cannot map " + path);
+        std::string why;
+        const detail::SegmentHeader* h = detail::verify_segment(
+            base_, mapped_, detail::SegmentKind::records, stamp, &why,
+            /*payload_may_grow=*/true);
+        // Read the count once.  A writer may commit more records after the
+        // fstat() above; those lie beyond this mapping and stay unseen.
+        const std::uint64_t committed =
+            h ? committed_bytes().load(std::memory_order_acquire) : 0;
+        const std::uint64_t room = mapped_ - payload_offset;
+        if (h && h->payload_offset != payload_offset) {
+            why = "records start at offset " + std::to_string(h->payload_offset) +
+                  ", expected " + std::to_string(payload_offset);
+            h = nullptr;
+        } else if (h && committed % sizeof(T) != 0) {
+            h = nullptr;
+            why = "record file ends inside a record";
+        } else if (h && committed > room && (prot & PROT_WRITE)) {
+            h = nullptr;
+            why = "record file is shorter than its header says";
+        }
+        if (!h) {
+            ::munmap(base_, mapped_);
+            base_ = nullptr;
+            mapped_ = 0;
+            return fail_plain(error, path + ": " + why);
+        }
+        count_ = static_cast<std::size_t>(std::min(committed, room) / sizeof(T));
+        return true;
+    }
+
+    /// Makes room for `payload` bytes: at least doubles the file, in whole
+    /// pages, and remaps it.  On failure the old mapping stays valid.
+    bool grow(std::uint64_t payload, std::string* error) {
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        std::size_t size = std::max<std::size_t>(payload_offset + payload, 2 * mapped_);
+        size = (size + page - 1) / page * page;
+        if (::ftruncate(fd_, static_cast<off_t>(size)) != 0)
+            return detail::fail_with_errno(error, "cannot grow record file");
+#if defined(MREMAP_MAYMOVE)
+        void* p = ::mremap(base_, mapped_, size, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) return detail::fail_with_errno(error, "cannot remap record file");
+#else
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) return detail::fail_with_errno(error, "cannot remap record file");
+        ::munmap(base_, mapped_);
+#endif
+        base_ = static_cast<unsigned char*>(p);
+        mapped_ = size;
+        if (hint_ != access_hint::normal) (void)apply_hint(hint_, nullptr);
+        return true;
+    }
+
+    bool apply_hint(access_hint hint, std::string* error) {
+        int advice = MADV_NORMAL;
+        switch (hint) {
+            case access_hint::normal:     advice = MADV_NORMAL; break;
+            case access_hint::sequential: advice = MADV_SEQUENTIAL; break;
+            case access_hint::random:     advice = MADV_RANDOM; break;
+            case access_hint::willneed:   advice = MADV_WILLNEED; break;
+            case access_hint::hugepage:
+#if defined(MADV_HUGEPAGE)
+                advice = MADV_HUGEPAGE;
+                break;
+#else
+                return fail_plain(error, "huge-page hints are not supported here");
+#endif
+        }
+        if (::madvise(base_, mapped_, advice) != 0)
+            return detail::fail_with_errno(error, "madvise refused the hint");
+        return true;
+    }
+
+    static bool fail_plain(std::string* error, std::string message) {
+        if (error) *error = std::move(message);
+        return false;
+    }
+};
+
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_MAPPED_RECORD_FILE_HPP
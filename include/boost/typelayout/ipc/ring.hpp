@@ -0,0 +1,403 @@
+// spsc_ring<T>, mpsc_ring<T> -- bounded lock-free queues of byte-copy-safe
+// records in POSIX shared memory.
+//
+//   // consumer process
+//   ipc::spsc_ring<SensorRecord> ring;
+//   ring.create("/sensors", 4096, &error);
+//   SensorRecord batch[64];
+//   std::size_t n = ring.try_pop_n(batch, 64);
+//
+//   // producer process (another build)
+//   ipc::spsc_ring<SensorRecord> ring;
+//   ring.attach("/sensors", &error);     // refused if SensorRecord differs
+//   ring.try_push_n(records, count);
+//
+// The segment holds the common header (detail/segment_header.hpp) with
+// the layout_stamp of T, a control block and the slot array.  attach()
+// verifies the stamp, the ring flavour and the geometry once, in O(1);
+// after that records are copied in and out with no per-message checks.
+//
+// Both rings are single-consumer.  spsc_ring is wait-free: the producer
+// owns `tail`, the consumer owns `head`, and each side keeps a private
+// copy of the other's index so it touches the shared line only when its
+// copy says the ring is full (empty).  mpsc_ring claims slots with a CAS
+// on `tail` and publishes each slot through a sequence number; a
+// producer that stalls between the two holds up the consumer at that
+// slot, but never another producer.
+//
+// try_push_n / try_pop_n move as many records as fit in one go, with one
+// release (acquire) per batch instead of one per record.  `head` and
+// `tail` live on separate 128-byte lines (two 64-byte lines, as paired by
+// adjacent-line prefetch) so producer and consumer do not false-share.
+//
+// One ring endpoint object per thread; the object caches indices and is
+// not itself thread-safe.  POSIX only.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_RING_HPP
+#define BOOST_TYPELAYOUT_IPC_RING_HPP
+
+#include <boost/typelayout/admission.hpp>
+#include <boost/typelayout/ipc/layout_stamp.hpp>
+#include <boost/typelayout/ipc/detail/segment_header.hpp>
+#include <boost/typelayout/ipc/detail/shared_memory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+namespace detail {
+
+inline constexpr std::size_t ring_line = 128;
+
+enum class RingMode : std::uint32_t { spsc = 1, mpsc = 2 };
+
+struct RingControl {
+    std::uint64_t capacity;    // slots, a power of two
+    std::uint32_t mode;        // RingMode
+    std::uint32_t slot_size;   // bytes per slot
+    alignas(ring_line) std::atomic<std::uint64_t> head;   // next slot to pop
+    alignas(ring_line) std::atomic<std::uint64_t> tail;   // next slot to push
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "shared-memory rings need a lock-free 64-bit atomic");
+
+/// An mpsc_ring slot: `seq` == position + 1 once the record at
+/// `position` is written.
+template <typename T>
+struct MpscSlot {
+    std::atomic<std::uint64_t> seq{0};
+    T                          value;
+};
+
+template <typename T, RingMode Mode>
+using ring_slot_t = std::conditional_t<Mode == RingMode::spsc, T, MpscSlot<T>>;
+
+/// Segment handling shared by both rings: create / attach and geometry.
+template <typename T, RingMode Mode>
+class RingSegment {
+public:
+    using Slot = ring_slot_t<T, Mode>;
+
+    static constexpr layout_stamp stamp = layout_stamp_of<T>();
+
+    RingSegment() = default;
+
+    RingSegment(RingSegment&& other) noexcept
+        : shm_(std::move(other.shm_))
+        , control_(std::exchange(other.control_, nullptr))
+        , slots_(std::exchange(other.slots_, nullptr))
+        , mask_(std::exchange(other.mask_, 0))
+        , head_cache_(other.head_cache_)
+        , tail_cache_(other.tail_cache_) {}
+
+    RingSegment& operator=(RingSegment&& other) noexcept {
+        if (this != &other) {
+            shm_ = std::move(other.shm_);
+            control_ = std::exchange(other.control_, nullptr);
+            slots_ = std::exchange(other.slots_, nullptr);
+            mask_ = std::exchange(other.mask_, 0);
+            head_cache_ = other.head_cache_;
+            tail_cache_ = other.tail_cache_;
+        }
+        return *this;
+    }
+
+    /// Creates the named segment `name` with room for `capacity` records,
+    /// rounded up to a power of two.
+    bool create(const std::string& name, std::size_t capacity,
+                std::string* error = nullptr)
+        requires std::is_default_constructible_v<T>
+    {
+        close();
+        std::size_t slots = 0;
+        if (!ring_slots(capacity, slots, error) ||
+            !shm_.create(name, segment_size(slots), error))
+            return false;
+        construct(slots);
+        return true;
+    }
+
+    /// As create(), in an anonymous memfd segment; pass fd() to the peer.
+    bool create_anonymous(std::size_t capacity, std::string* error = nullptr)
+        requires std::is_default_constructible_v<T>
+    {
+        close();
+        std::size_t slots = 0;
+        if (!ring_slots(capacity, slots, error) ||
+            !shm_.create_anonymous(segment_size(slots), error))
+            return false;
+        construct(slots);
+        return true;
+    }
+
+    /// Unlinks the named ring `name`, e.g. one left by a creator that
+    /// crashed, so create() can make it again.
+    static bool remove(const std::string& name, std::string* error = nullptr) {
+        return SharedMemory::remove(name, error);
+    }
+
+    /// Attaches to the named ring `name`, verifying layout and geometry.
+    bool attach(const std::string& name, std::string* error = nullptr) {
+        close();
+        return shm_.open(name, error) && bind(error);
+    }
+
+    /// Attaches to the ring behind `fd` (borrowed).
+    bool attach_fd(int fd, std::string* error = nullptr) {
+        close();
+        return shm_.open_fd(fd, error) && bind(error);
+    }
+
+    void close() noexcept {
+        shm_.close();
+        control_ = nullptr;
+        slots_ = nullptr;
+        mask_ = 0;
+        head_cache_ = tail_cache_ = 0;
+    }
+
+    bool is_open() const noexcept { return control_ != nullptr; }
+    explicit operator bool() const noexcept { return is_open(); }
+
+    std::size_t capacity() const noexcept { return is_open() ? mask_ + 1 : 0; }
+
+    /// Records in the ring; exact only while no side is active.  0 when
+    /// not open.
+    std::size_t size_approx() const noexcept {
+        if (!is_open()) return 0;
+        const std::uint64_t h = control_->head.load(std::memory_order_acquire);
+        const std::uint64_t t = control_->tail.load(std::memory_order_acquire);
+        return t > h ? static_cast<std::size_t>(t - h) : 0;
+    }
+
+    /// File descriptor of an anonymous ring, else -1.
+    int fd() const noexcept { return shm_.fd(); }
+
+protected:
+    SharedMemory  shm_;
+    RingControl*  control_ = nullptr;
+    Slot*         slots_ = nullptr;
+    std::uint64_t mask_ = 0;
+    // This endpoint's last view of the other side's index.
+    std::uint64_t head_cache_ = 0;   // producer side
+    std::uint64_t tail_cache_ = 0;   // consumer side
+
+private:
+    static constexpr std::size_t payload_offset =
+        segment_payload_offset(alignof(Slot) > ring_line ? alignof(Slot) : ring_line);
+    static constexpr std::size_t slots_offset =
+        (sizeof(RingControl) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+    static constexpr std::size_t max_slots =
+        (std::size_t(-1) - payload_offset - slots_offset) / sizeof(Slot);
+
+    static std::size_t segment_size(std::size_t slots) noexcept {
+        return payload_offset + slots_offset + slots * sizeof(Slot);
+    }
+
+    static bool ring_slots(std::size_t capacity, std::size_t& slots, std::string* error) {
+        if (capacity == 0 || capacity > max_slots / 2 + 1) {
+            if (error) *error = "invalid ring capacity " + std::to_string(capacity);
+            return false;
+        }
+        slots = 2;
+        while (slots < capacity) slots *= 2;
+        return true;
+    }
+
+    void construct(std::size_t slots) {
+        unsigned char* payload = shm_.data() + payload_offset;
+        auto* h = init_segment(shm_.data(), SegmentKind::ring, payload_offset,
+                               slots_offset + slots * sizeof(Slot), stamp);
+        control_ = ::new (payload) RingControl{};
+        control_->capacity = slots;
+        control_->mode = static_cast<std::uint32_t>(Mode);
+        control_->slot_size = static_cast<std::uint32_t>(sizeof(Slot));
+        // Every slot is constructed before the segment is published.  An
+        // MpscSlot starts with seq 0, which no position + 1 equals; for a
+        // trivial T the spsc slots cost nothing and their pages stay
+        // unallocated until first use.
+        auto* first = reinterpret_cast<Slot*>(payload + slots_offset);
+        for (std::size_t i = 0; i < slots; ++i)
+            ::new (static_cast<void*>(first + i)) Slot;
+        slots_ = std::launder(first);
+        mask_ = slots - 1;
+        publish_segment(h);
+    }
+
+    bool bind(std::string* error) {
+        const SegmentHeader* h = verify_segment(shm_.data(), shm_.size(),
+                                                SegmentKind::ring, stamp, error);
+        auto fail = [&](std::string message) {
+            if (error) *error = std::move(message);
+            shm_.close();
+            return false;
+        };
+        if (!h) {
+            shm_.close();
+            return false;
+        }
+        if (h->payload_offset != payload_offset || h->payload_size < slots_offset)
+            return fail("ring control block is not where this build expects it");
+        unsigned char* payload = shm_.data() + payload_offset;
+        auto* control = std::launder(reinterpret_cast<RingControl*>(payload));
+        const std::uint64_t slots = control->capacity;
+        if (control->mode != static_cast<std::uint32_t>(Mode))
+            return fail(control->mode == static_cast<std::uint32_t>(RingMode::spsc)
+                            ? "segment holds an spsc_ring"
+                            : "segment holds an mpsc_ring");
+        if (control->slot_size != sizeof(Slot) || slots < 2 || (slots & (slots - 1)) ||
+            slots > max_slots || h->payload_size != slots_offset + slots * sizeof(Slot))
+            return fail("ring geometry does not match its segment");
+        control_ = control;
+        slots_ = std::launder(reinterpret_cast<Slot*>(payload + slots_offset));
+        mask_ = slots - 1;
+        head_cache_ = control_->head.load(std::memory_order_acquire);
+        tail_cache_ = control_->tail.load(std::memory_order_acquire);
+        return true;
+    }
+};
+
+template <typename T>
+concept ring_value = is_byte_copy_safe_v<T> && std::is_trivially_copyable_v<T>;
+
+} // namespace detail
+
+/// Single-producer single-consumer ring.
+template <typename T>
+    requires detail::ring_value<T>
+class spsc_ring : public detail::RingSegment<T, detail::RingMode::spsc> {
+public:
+    using value_type = T;
+
+    /// Producer: appends up to `n` records; returns how many (0 when not
+    /// open).
+    std::size_t try_push_n(const T* items, std::size_t n) noexcept {
+        if (!this->is_open()) return 0;
+        auto& c = *this->control_;
+        const std::uint64_t cap = this->mask_ + 1;
+        const std::uint64_t tail = c.tail.load(std::memory_order_relaxed);
+        std::uint64_t used = tail - this->head_cache_;
+        if (used > cap || cap - used < n) {
+            this->head_cache_ = c.head.load(std::memory_order_acquire);
+            used = tail - this->head_cache_;
+        }
+        const std::size_t k = static_cast<std::size_t>(std::min<std::uint64_t>(n, cap - used));
+        if (k == 0) return 0;
+        const std::size_t at = static_cast<std::size_t>(tail & this->mask_);
+        const std::size_t first = std::min<std::size_t>(k, static_cast<std::size_t>(cap) - at);
+        std::copy_n(items, first, this->slots_ + at);
+        std::copy_n(items + first, k - first, this->slots_);
+        c.tail.store(tail + k, std::memory_order_release);
+        return k;
+    }
+
+    /// Consumer: removes up to `n` records into `out`; returns how many
+    /// (0 when not open).
+    std::size_t try_pop_n(T* out, std::size_t n) noexcept {
+        if (!this->is_open()) return 0;
+        auto& c = *this->control_;
+        const std::uint64_t cap = this->mask_ + 1;
+        const std::uint64_t head = c.head.load(std::memory_order_relaxed);
+        std::uint64_t avail = this->tail_cache_ - head;
+        if (avail < n) {
+            this->tail_cache_ = c.tail.load(std::memory_order_acquire);
+            avail = this->tail_cache_ - head;
+        }
+        const std::size_t k = static_cast<std::size_t>(std::min<std::uint64_t>(n, avail));
+        if (k == 0) return 0;
+        const std::size_t at = static_cast<std::size_t>(head & this->mask_);
+        const std::size_t first = std::min<std::size_t>(k, static_cast<std::size_t>(cap) - at);
+        std::copy_n(this->slots_ + at, first, out);
+        std::copy_n(this->slots_, k - first, out + first);
+        c.head.store(head + k, std::memory_order_release);
+        return k;
+    }
+
+    bool try_push(const T& item) noexcept { return try_push_n(&item, 1) == 1; }
+    bool try_pop(T& out) noexcept { return try_pop_n(&out, 1) == 1; }
+};
+
+/// Multi-producer single-consumer ring.
+template <typename T>
+    requires detail::ring_value<T>
+class mpsc_ring : public detail::RingSegment<T, detail::RingMode::mpsc> {
+public:
+    using value_type = T;
+
+    /// Producer: appends up to `n` records as one contiguous run; returns
+    /// how many (0 when not open).
+    std::size_t try_push_n(const T* items, std::size_t n) noexcept {
+        if (!this->is_open()) return 0;
+        auto& c = *this->control_;
+        const std::uint64_t cap = this->mask_ + 1;
+        std::uint64_t tail = c.tail.load(std::memory_order_relaxed);
+        std::size_t k = 0;
+        for (;;) {
+            std::uint64_t used = tail - this->head_cache_;
+            if (used > cap || cap - used < n) {
+                this->head_cache_ = c.head.load(std::memory_order_acquire);
+                used = tail - this->head_cache_;
+                if (used > cap) {   // our tail is older than the head we saw
+                    tail = c.tail.load(std::memory_order_relaxed);
+                    continue;
+                }
+            }
+            k = static_cast<std::size_t>(std::min<std::uint64_t>(n, cap - used));
+            if (k == 0) return 0;
+            if (c.tail.compare_exchange_weak(tail, tail + k, std::memory_order_relaxed,
+                                             std::memory_order_relaxed))
+                break;
+        }
+        for (std::size_t i = 0; i < k; ++i)
+            this->slots_[(tail + i) & this->mask_].value = items[i];
+        // One fence publishes the whole run; the consumer pairs it with
+        // its own acquire fence.
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < k; ++i)
+            this->slots_[(tail + i) & this->mask_].seq.store(tail + i + 1,
+                                                           std::memory_order_relaxed);
+        return k;
+    }
+
+    /// Consumer: removes up to `n` published records, in order; returns
+    /// how many (0 when not open).  Stops at the first slot a producer has
+    /// claimed but not yet written.
+    std::size_t try_pop_n(T* out, std::size_t n) noexcept {
+        if (!this->is_open()) return 0;
+        auto& c = *this->control_;
+        const std::uint64_t head = c.head.load(std::memory_order_relaxed);
+        std::size_t k = 0;
+        while (k < n && this->slots_[(head + k) & this->mask_].seq.load(
+                            std::memory_order_relaxed) == head + k + 1)
+            ++k;
+        if (k == 0) return 0;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        for (std::size_t i = 0; i < k; ++i)
+            out[i] = this->slots_[(head + i) & this->mask_].value;
+        c.head.store(head + k, std::memory_order_release);
+        return k;
+    }
+
+    bool try_push(const T& item) noexcept { return try_push_n(&item, 1) == 1; }
+    bool try_pop(T& out) noexcept { return try_pop_n(&out, 1) == 1; }
+};
+
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_RING_HPP
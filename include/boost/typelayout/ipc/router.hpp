@@ -0,0 +1,280 @@
+// message_router<Ts...> -- dispatch of received records by layout hash.
+//
+//   using Bus = ipc::message_router<PacketHeader, SensorRecord, IpcCommand>;
+//
+//   // frame = { get_layout_hash<T>(), sizeof(T), bytes of a T }
+//   Bus::dispatch(frame.tag, frame.data, frame.size, overloaded{
+//       [](const SensorRecord& r) { ... },
+//       [](const IpcCommand& c)   { ... },
+//       [](const PacketHeader& h) { ... },
+//       [](const ipc::unrouted_message& m) { ... },   // optional slow path
+//   });
+//
+// A frame's type tag is the sender's get_layout_hash<T>().  The router
+// maps it to a slot of a minimal perfect hash built at compile time over
+// the registered types' layout hashes (hash-and-displace: a bucket hash
+// picks a displacement, the displaced hash picks one of N slots), checks
+// the one key stored there and calls handler(const T&) on the received
+// bytes in place -- no copy, no parsing, no string compares.  The tag
+// identifies the layout, not just the name: a sender built with a
+// different T produces a different hash and lands on the slow path.
+//
+// Frames that cannot be dispatched -- unknown hash, payload size other
+// than sizeof(T), payload not aligned for T -- go to the handler's
+// unrouted_message overload when it has one; dispatch() returns why.
+//
+// Registered types must be byte-copy safe and trivially copyable, and
+// their layouts pairwise different: two types with the same layout have
+// the same hash, and a hash-keyed router cannot tell them apart.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_ROUTER_HPP
+#define BOOST_TYPELAYOUT_IPC_ROUTER_HPP
+
+#include <boost/typelayout/admission.hpp>
+#include <boost/typelayout/signature.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+
+enum class route_status : std::uint8_t {
+    dispatched,      // handler(const T&) was called
+    unknown_type,    // no registered type has this layout hash
+    size_mismatch,   // known hash, but the payload is not sizeof(T) bytes
+    misaligned       // known hash, but the payload is not aligned for T
+};
+
+/// What the slow path receives for a frame that was not dispatched.
+struct unrouted_message {
+    std::uint64_t layout_hash;
+    const void*   data;
+    std::size_t   size;
+    route_status  status;
+};
+
+namespace detail {
+
+/// MurmurHash3's 64-bit finaliser.
+constexpr std::uint64_t route_mix(std::uint64_t x) noexcept {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+/// Minimal perfect hash of N distinct 64-bit keys onto slots [0, N).
+template <std::size_t N>
+struct RouteTable {
+    static constexpr std::size_t buckets = N / 2 + 1;
+
+    std::uint64_t                     seed = 0;
+    std::array<std::uint32_t, buckets> displacement{};
+    std::array<std::uint64_t, N>       keys{};      // slot -> key
+    std::array<std::size_t, N>         slot_of{};   // key index -> slot
+
+    static constexpr std::size_t bucket(std::uint64_t key, std::uint64_t seed) noexcept {
+        return static_cast<std::size_t>(route_mix(key ^ seed) % buckets);
+    }
+
+    static constexpr std::size_t place(std::uint64_t key, std::uint64_t seed,
+                                       std::uint32_t d) noexcept {
+        return static_cast<std::size_t>(
+            route_mix((key ^ seed) + (std::uint64_t{d} + 1) * 0x9e3779b97f4a7c15ull) % N);
+    }
+
+    constexpr std::size_t slot(std::uint64_t key) const noexcept {
+        return place(key, seed, displacement[bucket(key, seed)]);
+    }
+};
+
+template <std::size_t N>
+consteval bool all_distinct(const std::array<std::uint64_t, N>& keys) {
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = i + 1; j < N; ++j)
+            if (keys[i] == keys[j]) return false;
+    return true;
+}
+
+/// Hash and displace: buckets are placed largest first, each with the
+/// smallest displacement that puts all of its keys on free slots.  A seed
+/// that leaves some bucket unplaceable is replaced by the next one, which
+/// terminates for distinct keys (message_router asserts that they are).
+template <std::size_t N>
+consteval RouteTable<N> build_route_table(const std::array<std::uint64_t, N>& keys) {
+    using Table = RouteTable<N>;
+    if (!all_distinct(keys)) return {};
+    constexpr std::uint32_t max_displacement = 1u << 16;
+    for (std::uint64_t seed = 0;; ++seed) {
+        Table t;
+        t.seed = seed;
+        std::array<std::size_t, N> bucket_of{};
+        std::array<std::size_t, Table::buckets> load{};
+        for (std::size_t i = 0; i < N; ++i) ++load[bucket_of[i] = Table::bucket(keys[i], seed)];
+
+        std::array<std::size_t, Table::buckets> order{};
+        for (std::size_t b = 0; b < Table::buckets; ++b) order[b] = b;
+        for (std::size_t i = 1; i < Table::buckets; ++i)   // insertion sort, largest first
+            for (std::size_t j = i; j > 0 && load[order[j - 1]] < load[order[j]]; --j)
+                std::swap(order[j - 1], order[j]);
+
+        std::array<bool, N> taken{};
+        bool placed_all = true;
+        for (std::size_t b : order) {
+            if (load[b] == 0) break;
+            bool placed = false;
+            for (std::uint32_t d = 0; d < max_displacement && !placed; ++d) {
+                std::array<bool, N> mine{};
+                placed = true;
+                for (std::size_t i = 0; i < N && placed; ++i) {
+                    if (bucket_of[i] != b) continue;
+                    const std::size_t s = Table::place(keys[i], seed, d);
+                    if (taken[s] || mine[s]) placed = false;
+                    mine[s] = true;
+                }
+                if (!placed) continue;
+                t.displacement[b] = d;
+                for (std::size_t i = 0; i < N; ++i) {
+                    if (bucket_of[i] != b) continue;
+                    const std::size_t s = Table::place(keys[i], seed, d);
+                    taken[s] = true;
+                    t.keys[s] = keys[i];
+                    t.slot_of[i] = s;
+                }
+            }
+            if (!placed) {
+                placed_all = false;
+                break;
+            }
+        }
+        if (placed_all) return t;
+    }
+}
+
+} // namespace detail
+
+template <typename... Ts>
+    requires (sizeof...(Ts) > 0 &&
+              ((is_byte_copy_safe_v<Ts> && std::is_trivially_copyable_v<Ts>) && ...))
+class message_router {
+public:
+    static constexpr std::size_t type_count = sizeof...(Ts);
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// get_layout_hash<Ts>()..., in registration order.
+    static constexpr std::array<std::uint64_t, type_count> layout_hashes{
+        get_layout_hash<Ts>()...};
+
+    static_assert(detail::all_distinct(layout_hashes),
+                  "message_router: two registered types have the same layout, "
+                  "so their layout hashes cannot tell them apart");
+
+    /// Index in Ts... of the type whose layout hash is `hash`, or npos.  O(1).
+    static constexpr std::size_t index_of(std::uint64_t hash) noexcept {
+        const std::size_t s = table_.slot(hash);
+        return table_.keys[s] == hash ? type_at_[s] : npos;
+    }
+
+    /// Calls handler(const T&) on the `size` bytes at `data` when `hash`
+    /// is get_layout_hash<T>() of a registered T, the size is sizeof(T) and
+    /// `data` is aligned for T.  Otherwise calls
+    /// handler(const unrouted_message&) if the handler accepts one.
+    template <typename Handler>
+    static route_status dispatch(std::uint64_t hash, const void* data, std::size_t size,
+                                 Handler&& handler) {
+        static_assert((std::is_invocable_v<Handler&, const Ts&> && ...),
+                      "message_router: the handler must accept every registered type");
+        route_status status = route_status::unknown_type;
+        const std::size_t s = table_.slot(hash);
+        if (table_.keys[s] == hash) {
+            // A switch on the slot, so the compiler emits one jump table
+            // and inlines each handler overload; slots past the cases go
+            // through a table of per-type thunks (one indirect call).
+            using H = std::remove_reference_t<Handler>;
+#define BOOST_TYPELAYOUT_ROUTE_CASE(k)                                        \
+            case k:                                                           \
+                if constexpr (k < type_count)                                 \
+                    status = deliver<slot_type<k>>(data, size, handler);      \
+                break;
+            switch (s) {
+                BOOST_TYPELAYOUT_ROUTE_CASE(0)  BOOST_TYPELAYOUT_ROUTE_CASE(1)
+                BOOST_TYPELAYOUT_ROUTE_CASE(2)  BOOST_TYPELAYOUT_ROUTE_CASE(3)
+                BOOST_TYPELAYOUT_ROUTE_CASE(4)  BOOST_TYPELAYOUT_ROUTE_CASE(5)
+                BOOST_TYPELAYOUT_ROUTE_CASE(6)  BOOST_TYPELAYOUT_ROUTE_CASE(7)
+                BOOST_TYPELAYOUT_ROUTE_CASE(8)  BOOST_TYPELAYOUT_ROUTE_CASE(9)
+                BOOST_TYPELAYOUT_ROUTE_CASE(10) BOOST_TYPELAYOUT_ROUTE_CASE(11)
+                BOOST_TYPELAYOUT_ROUTE_CASE(12) BOOST_TYPELAYOUT_ROUTE_CASE(13)
+                BOOST_TYPELAYOUT_ROUTE_CASE(14) BOOST_TYPELAYOUT_ROUTE_CASE(15)
+            default:
+                if constexpr (type_count > switch_cases)
+                    status = thunks_<H>[s](data, size, handler);
+                break;
+            }
+#undef BOOST_TYPELAYOUT_ROUTE_CASE
+            if (status == route_status::dispatched) return status;
+        }
+        if constexpr (std::is_invocable_v<Handler&, const unrouted_message&>)
+            handler(unrouted_message{hash, data, size, status});
+        return status;
+    }
+
+private:
+    static constexpr detail::RouteTable<type_count> table_ =
+        detail::build_route_table(layout_hashes);
+
+    template <typename T, typename Handler>
+    static route_status deliver(const void* data, std::size_t size, Handler& handler) {
+        if (size != sizeof(T)) return route_status::size_mismatch;
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0)
+            return route_status::misaligned;
+        handler(*std::launder(static_cast<const T*>(data)));
+        return route_status::dispatched;
+    }
+
+    // Slot -> index in Ts..., for index_of().
+    static constexpr std::array<std::size_t, type_count> type_at_ =
+        []<std::size_t... I>(std::index_sequence<I...>) {
+            std::array<std::size_t, type_count> t{};
+            ((t[table_.slot_of[I]] = I), ...);
+            return t;
+        }(std::index_sequence_for<Ts...>{});
+
+    // The type stored at slot S (S < type_count).
+    template <std::size_t S>
+    using slot_type = std::tuple_element_t<type_at_[S], std::tuple<Ts...>>;
+
+    // Slots dispatch() switches on directly.
+    static constexpr std::size_t switch_cases = 16;
+
+    template <typename Handler>
+    using thunk = route_status (*)(const void*, std::size_t, Handler&);
+
+    // Slot -> deliver<T> of the type stored there, for dispatch().
+    template <typename Handler>
+    static constexpr std::array<thunk<Handler>, type_count> thunks_ = [] {
+        constexpr std::array<thunk<Handler>, type_count> by_type{&deliver<Ts, Handler>...};
+        std::array<thunk<Handler>, type_count> t{};
+        for (std::size_t s = 0; s < type_count; ++s) t[s] = by_type[type_at_[s]];
+        return t;
+    }();
+};
+
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_ROUTER_HPP
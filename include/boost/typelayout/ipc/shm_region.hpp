@@ -0,0 +1,171 @@
+// shm_region<T> -- one T in POSIX shared memory, shared in place between
+// independently built processes.
+//
+//   // process A
+//   ipc::shm_region<SharedMemRegion> region;
+//   if (!region.create("/telemetry", &error)) ...
+//   region->owner_pid = getpid();
+//
+//   // process B (another build, maybe another compiler)
+//   ipc::shm_region<SharedMemRegion> region;
+//   if (!region.attach("/telemetry", &error)) ...   // layout checked here
+//   SharedMemRegion& r = *region;                    // no copy
+//
+// The segment starts with a header (detail/segment_header.hpp) holding the
+// layout_stamp of T: get_layout_hash<T>(), the arch prefix, sizeof(T) and
+// alignof(T).  attach() compares it with this build's stamp -- O(1), once
+// -- and refuses a segment whose T has a different layout, so accesses
+// through the returned reference need no per-access validation.
+//
+// Only byte-copy-safe types (is_byte_copy_safe_v) are admitted: a pointer
+// stored by one process means nothing in another.  The region does no
+// synchronisation of its own; use std::atomic members (lock-free ones are
+// address-free) or one of the rings for concurrent access.
+//
+// Named segments are shm_open() objects; the creator unlinks the name when
+// it closes the region.  A creator that crashes leaves the name behind
+// and the next create() fails, so a restarting creator calls
+// remove(name) first.  create_anonymous() uses a memfd instead, whose
+// fd() the peer receives by fork() or SCM_RIGHTS and attaches with
+// attach_fd(); it leaves nothing behind.
+//
+// POSIX only.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_SHM_REGION_HPP
+#define BOOST_TYPELAYOUT_IPC_SHM_REGION_HPP
+
+#include <boost/typelayout/admission.hpp>
+#include <boost/typelayout/ipc/layout_stamp.hpp>
+#include <boost/typelayout/ipc/detail/segment_header.hpp>
+#include <boost/typelayout/ipc/detail/shared_memory.hpp>
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+
+template <typename T>
+    requires is_byte_copy_safe_v<T>
+class shm_region {
+public:
+    using value_type = T;
+
+    /// The stamp written by create() and required by attach().
+    static constexpr layout_stamp stamp = layout_stamp_of<T>();
+
+    shm_region() = default;
+
+    shm_region(shm_region&& other) noexcept
+        : shm_(std::move(other.shm_)), value_(std::exchange(other.value_, nullptr)) {}
+
+    shm_region& operator=(shm_region&& other) noexcept {
+        if (this != &other) {
+            shm_ = std::move(other.shm_);
+            value_ = std::exchange(other.value_, nullptr);
+        }
+        return *this;
+    }
+
+    /// Creates the named segment `name` ("/name") holding a value-initialised
+    /// T; fails if the name exists.
+    bool create(const std::string& name, std::string* error = nullptr)
+        requires std::is_default_constructible_v<T>
+    {
+        close();
+        if (!shm_.create(name, segment_size, error)) return false;
+        construct();
+        return true;
+    }
+
+    /// As create(), in an anonymous memfd segment; pass fd() to the peer.
+    bool create_anonymous(std::string* error = nullptr)
+        requires std::is_default_constructible_v<T>
+    {
+        close();
+        if (!shm_.create_anonymous(segment_size, error)) return false;
+        construct();
+        return true;
+    }
+
+    /// Unlinks the named segment `name` (see the header comment); false
+    /// only if it exists and cannot be removed.
+    static bool remove(const std::string& name, std::string* error = nullptr) {
+        return detail::SharedMemory::remove(name, error);
+    }
+
+    /// Attaches to the named segment `name`, verifying its layout stamp.
+    bool attach(const std::string& name, std::string* error = nullptr) {
+        close();
+        return shm_.open(name, error) && bind(error);
+    }
+
+    /// Attaches to the segment behind `fd` (borrowed), verifying its stamp.
+    bool attach_fd(int fd, std::string* error = nullptr) {
+        close();
+        return shm_.open_fd(fd, error) && bind(error);
+    }
+
+    void close() noexcept {
+        shm_.close();
+        value_ = nullptr;
+    }
+
+    bool is_open() const noexcept { return value_ != nullptr; }
+    explicit operator bool() const noexcept { return is_open(); }
+
+    /// The shared T.  Requires is_open().
+    T&       get() noexcept { return *value_; }
+    const T& get() const noexcept { return *value_; }
+    T&       operator*() noexcept { return *value_; }
+    const T& operator*() const noexcept { return *value_; }
+    T*       operator->() noexcept { return value_; }
+    const T* operator->() const noexcept { return value_; }
+
+    /// File descriptor of an anonymous region (create_anonymous()), else -1.
+    int fd() const noexcept { return shm_.fd(); }
+
+private:
+    static constexpr std::size_t payload_offset =
+        detail::segment_payload_offset(alignof(T));
+    static constexpr std::size_t segment_size = payload_offset + sizeof(T);
+
+    detail::SharedMemory shm_;
+    T*                   value_ = nullptr;
+
+    void construct() {
+        auto* h = detail::init_segment(shm_.data(), detail::SegmentKind::region,
+                                       payload_offset, sizeof(T), stamp);
+        value_ = ::new (shm_.data() + payload_offset) T();
+        detail::publish_segment(h);
+    }
+
+    bool bind(std::string* error) {
+        const detail::SegmentHeader* h =
+            detail::verify_segment(shm_.data(), shm_.size(),
+                                   detail::SegmentKind::region, stamp, error);
+        if (!h || h->payload_size != sizeof(T)) {
+            if (h && error) *error = "segment payload is not one object";
+            shm_.close();
+            return false;
+        }
+        // The creator constructed the T; this process only views it.
+        value_ = std::launder(reinterpret_cast<T*>(shm_.data() + h->payload_offset));
+        return true;
+    }
+};
+
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_SHM_REGION_HPP
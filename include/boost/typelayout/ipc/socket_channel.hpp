@@ -0,0 +1,565 @@
+// socket_channel<Ts...> -- batches of byte-copy-safe records over a TCP or
+// Unix domain stream socket, sent as raw bytes after a one-time layout
+// handshake.
+//
+//   using Link = ipc::socket_channel<SensorRecord, IpcCommand>;
+//
+//   // sender (one build)
+//   Link link;
+//   if (!link.connect_tcp("collector", 7000, &error)) ...   // handshake here
+//   link.queue(std::span<const SensorRecord>(samples));
+//   link.queue(std::span<const IpcCommand>(&command, 1));
+//   link.flush(&error);                                      // one sendmsg()
+//
+//   // receiver (another build, maybe another compiler)
+//   ipc::socket_listener listener;
+//   listener.listen_tcp("", 7000, &error);
+//   Link link;
+//   link.open_fd(listener.accept(&error), &error);           // handshake here
+//   while (link.receive(overloaded{
+//       [](std::span<const SensorRecord> rs) { ... },        // in place
+//       [](std::span<const IpcCommand> cs)   { ... }}, &error)) {}
+//
+// On connect both ends send the layout_stamp of every registered type --
+// get_layout_hash<T>() over the full layout signature, the arch prefix,
+// sizeof(T) and alignof(T): the data CompatReporter compares -- and
+// check the peer's list once.  The channel opens only if both ends have
+// the same layouts, in any order; a peer built with a different layout
+// of any T is refused, on both ends, before a single record moves.
+// After that records cross as their own bytes: no per-message encoding,
+// no per-message checks.  A channel registers at most 65536 types; the
+// lists (32 bytes per type) go both ways at once, each end reading while
+// it writes, so the handshake cannot stall on a full socket buffer.
+//
+// A batch is a 16-byte header (the sender's type index, the count and
+// byte size) and then the records, both padded to the channel's frame
+// alignment -- 16 bytes, or the largest alignof(T) of either end.
+// queue() only records the caller's spans, which must stay alive until
+// flush(); flush() sends all queued batches with gather I/O, as few
+// sendmsg() calls as IOV_MAX allows, and no copy.
+//
+// receive() reads as much as the socket has into a reusable receive
+// arena and hands every complete batch to the handler as a
+// std::span<const T> into the arena.  Frames keep the arena aligned for
+// every T, so the spans point at properly aligned records; they stay
+// valid until the next receive().
+//
+// Blocking sockets, one thread per direction at most.  POSIX only.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_IPC_SOCKET_CHANNEL_HPP
+#define BOOST_TYPELAYOUT_IPC_SOCKET_CHANNEL_HPP
+
+#include <boost/typelayout/admission.hpp>
+#include <boost/typelayout/ipc/layout_stamp.hpp>
+#include <boost/typelayout/ipc/detail/socket.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace ipc {
+namespace detail {
+
+inline constexpr std::uint32_t channel_magic   = 0x544c4348u;   // "TLCH"
+inline constexpr std::uint16_t channel_version = 1;
+inline constexpr std::size_t   channel_max_align = 64;
+inline constexpr std::uint64_t channel_max_batch = std::uint64_t{1} << 30;
+inline constexpr std::uint32_t channel_max_types = 65536;
+
+/// First message in each direction, followed by `type_count` stamps.
+struct ChannelHello {
+    std::uint32_t magic;         // channel_magic, in the sender's byte order
+    std::uint16_t version;
+    std::uint16_t frame_align;   // the sender's; the channel uses the larger
+    std::uint32_t type_count;
+    std::uint32_t reserved;
+};
+
+struct BatchHeader {
+    std::uint32_t type;    // index in the sender's Ts...
+    std::uint32_t count;   // records
+    std::uint64_t bytes;   // count * sizeof(T)
+};
+
+static_assert(sizeof(ChannelHello) == 16 && sizeof(BatchHeader) == 16,
+              "channel headers are a wire format");
+
+constexpr std::uint32_t byte_swap32(std::uint32_t x) noexcept {
+    return (x >> 24) | ((x >> 8) & 0xff00u) | ((x << 8) & 0xff0000u) | (x << 24);
+}
+
+constexpr std::size_t round_up(std::size_t n, std::size_t align) noexcept {
+    return (n + align - 1) / align * align;
+}
+
+/// Receive arena: a growable buffer aligned to channel_max_align.
+class ChannelArena {
+public:
+    ChannelArena() = default;
+    ChannelArena(const ChannelArena&) = delete;
+    ChannelArena& operator=(const ChannelArena&) = delete;
+
+    ChannelArena(ChannelArena&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , capacity_(std::exchange(other.capacity_, 0)) {}
+
+    ChannelArena& operator=(ChannelArena&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+        return *this;
+    }
+
+    ~ChannelArena() { release(); }
+
+    /// Grows to at least `size` bytes, keeping the first `used`.
+    void reserve(std::size_t size, std::size_t used) {
+        if (size <= capacity_) return;
+        std::size_t capacity = capacity_ ? capacity_ : 64 * 1024;
+        while (capacity < size) capacity *= 2;
+        auto* data = static_cast<unsigned char*>(
+            ::operator new(capacity, std::align_val_t{channel_max_align}));
+        if (used) std::memcpy(data, data_, used);
+        release();
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    unsigned char* data() const noexcept { return data_; }
+    std::size_t    capacity() const noexcept { return capacity_; }
+
+private:
+    unsigned char* data_ = nullptr;
+    std::size_t    capacity_ = 0;
+
+    void release() noexcept {
+        if (data_) ::operator delete(data_, std::align_val_t{channel_max_align});
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+};
+
+template <typename T, typename... Ts>
+constexpr std::size_t channel_index() noexcept {
+    std::size_t i = 0;
+    (void)((std::is_same_v<T, Ts> ? true : (++i, false)) || ...);
+    return i;
+}
+
+} // namespace detail
+
+/// Listening TCP or Unix domain socket whose accepted connections are
+/// handed to socket_channel::open_fd().
+class socket_listener {
+public:
+    socket_listener() = default;
+    socket_listener(const socket_listener&) = delete;
+    socket_listener& operator=(const socket_listener&) = delete;
+
+    socket_listener(socket_listener&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , port_(std::exchange(other.port_, 0))
+        , unlink_(std::move(other.unlink_)) {
+        other.unlink_.clear();
+    }
+
+    socket_listener& operator=(socket_listener&& other) noexcept {
+        if (this != &other) {
+            close();
+            fd_ = std::exchange(other.fd_, -1);
+            port_ = std::exchange(other.port_, 0);
+            unlink_ = std::move(other.unlink_);
+            other.unlink_.clear();
+        }
+        return *this;
+    }
+
+    ~socket_listener() { close(); }
+
+    /// Listens on host:port; an empty host means every interface, port 0
+    /// a free port (see port()).
+    bool listen_tcp(const std::string& host, std::uint16_t port,
+                    std::string* error = nullptr) {
+        close();
+        fd_ = detail::listen_tcp(host, port, &port_, error);
+        return fd_ >= 0;
+    }
+
+    /// Listens on the Unix domain socket `path`, removed again by close().
+    bool listen_unix(const std::string& path, std::string* error = nullptr) {
+        close();
+        fd_ = detail::listen_unix(path, error);
+        if (fd_ >= 0) unlink_ = path;
+        return fd_ >= 0;
+    }
+
+    /// Waits for a connection; its socket, or -1.
+    int accept(std::string* error = nullptr) {
+        for (;;) {
+            int fd = ::accept(fd_, nullptr, nullptr);
+            if (fd >= 0) {
+                int one = 1;
+                if (unlink_.empty())
+                    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                detail::socket_no_sigpipe(fd);
+                return fd;
+            }
+            if (errno != EINTR) {
+                detail::fail_with_errno(error, "accept failed");
+                return -1;
+            }
+        }
+    }
+
+    void close() noexcept {
+        if (fd_ >= 0) ::close(fd_);
+        if (!unlink_.empty()) ::unlink(unlink_.c_str());
+        fd_ = -1;
+        port_ = 0;
+        unlink_.clear();
+    }
+
+    bool          is_open() const noexcept { return fd_ >= 0; }
+    int           fd() const noexcept { return fd_; }
+    std::uint16_t port() const noexcept { return port_; }   // TCP only
+
+private:
+    int           fd_ = -1;
+    std::uint16_t port_ = 0;
+    std::string   unlink_;   // Unix socket path to remove on close
+};
+
+template <typename... Ts>
+    requires (sizeof...(Ts) > 0 &&
+              ((is_byte_copy_safe_v<Ts> && std::is_trivially_copyable_v<Ts>) && ...))
+class socket_channel {
+public:
+    static constexpr std::size_t type_count = sizeof...(Ts);
+
+    /// layout_stamp_of<Ts>()..., in registration order: what the
+    /// handshake sends and expects back.
+    static constexpr std::array<layout_stamp, type_count> stamps{layout_stamp_of<Ts>()...};
+
+    static_assert(type_count <= detail::channel_max_types,
+                  "socket_channel: at most 65536 types per channel");
+    static_assert(((alignof(Ts) <= detail::channel_max_align) && ...),
+                  "socket_channel: records aligned beyond 64 bytes are not supported");
+    static_assert([] {
+        for (std::size_t i = 0; i < type_count; ++i)
+            for (std::size_t j = i + 1; j < type_count; ++j)
+                if (stamps[i] == stamps[j]) return false;
+        return true;
+    }(), "socket_channel: two registered types have the same layout");
+
+    socket_channel() = default;
+    socket_channel(const socket_channel&) = delete;
+    socket_channel& operator=(const socket_channel&) = delete;
+
+    socket_channel(socket_channel&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , align_(other.align_)
+        , peer_to_local_(std::move(other.peer_to_local_))
+        , pending_(std::move(other.pending_))
+        , arena_(std::move(other.arena_))
+        , begin_(std::exchange(other.begin_, 0))
+        , end_(std::exchange(other.end_, 0))
+        , eof_(std::exchange(other.eof_, false)) {}
+
+    socket_channel& operator=(socket_channel&& other) noexcept {
+        if (this != &other) {
+            close();
+            fd_ = std::exchange(other.fd_, -1);
+            align_ = other.align_;
+            peer_to_local_ = std::move(other.peer_to_local_);
+            pending_ = std::move(other.pending_);
+            arena_ = std::move(other.arena_);
+            begin_ = std::exchange(other.begin_, 0);
+            end_ = std::exchange(other.end_, 0);
+            eof_ = std::exchange(other.eof_, false);
+        }
+        return *this;
+    }
+
+    ~socket_channel() { close(); }
+
+    /// Connects to host:port and runs the handshake.
+    bool connect_tcp(const std::string& host, std::uint16_t port,
+                     std::string* error = nullptr) {
+        close();
+        int fd = detail::connect_tcp(host, port, error);
+        return fd >= 0 && open_fd(fd, error);
+    }
+
+    /// Connects to the Unix domain socket `path` and runs the handshake.
+    bool connect_unix(const std::string& path, std::string* error = nullptr) {
+        close();
+        int fd = detail::connect_unix(path, error);
+        return fd >= 0 && open_fd(fd, error);
+    }
+
+    /// Takes ownership of the connected stream socket `fd` (accepted, or
+    /// one end of a socketpair) and runs the handshake.  On failure the
+    /// socket is closed.
+    bool open_fd(int fd, std::string* error = nullptr) {
+        close();
+        if (fd < 0) {
+            if (error && error->empty()) *error = "no socket to open";
+            return false;
+        }
+        fd_ = fd;
+        if (!handshake(error)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() noexcept {
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+        align_ = local_align;
+        peer_to_local_.clear();
+        pending_.clear();
+        begin_ = end_ = 0;
+        eof_ = false;
+    }
+
+    bool is_open() const noexcept { return fd_ >= 0; }
+    explicit operator bool() const noexcept { return is_open(); }
+    int  fd() const noexcept { return fd_; }
+
+    /// True once receive() has seen the peer close the connection.
+    bool eof() const noexcept { return eof_; }
+
+    /// Adds a batch to the next flush(), split into batches of at most
+    /// 1 GiB.  No copy: `records` must stay alive and unchanged until then.
+    template <typename T>
+        requires (std::is_same_v<T, Ts> || ...)
+    void queue(std::span<const T> records) {
+        constexpr std::size_t max_count = detail::channel_max_batch / sizeof(T);
+        while (!records.empty()) {
+            const std::span<const T> batch = records.first(std::min(records.size(), max_count));
+            pending_.push_back({detail::BatchHeader{
+                                    static_cast<std::uint32_t>(detail::channel_index<T, Ts...>()),
+                                    static_cast<std::uint32_t>(batch.size()),
+                                    batch.size_bytes()},
+                                batch.data()});
+            records = records.subspan(batch.size());
+        }
+    }
+
+    /// Sends every queued batch with gather I/O.  Requires is_open().
+    bool flush(std::string* error = nullptr) {
+        if (pending_.empty()) return true;
+        static constexpr unsigned char zeros[detail::channel_max_align] = {};
+        std::vector<iovec> iov;
+        iov.reserve(pending_.size() * 3);
+        for (const Pending& p : pending_) {
+            iov.push_back({const_cast<detail::BatchHeader*>(&p.header),
+                           sizeof(detail::BatchHeader)});
+            if (align_ > sizeof(detail::BatchHeader))
+                iov.push_back({const_cast<unsigned char*>(zeros),
+                               align_ - sizeof(detail::BatchHeader)});
+            iov.push_back({const_cast<void*>(p.data), static_cast<std::size_t>(p.header.bytes)});
+            if (std::size_t pad = detail::round_up(p.header.bytes, align_) - p.header.bytes)
+                iov.push_back({const_cast<unsigned char*>(zeros), pad});
+        }
+        const bool ok = detail::send_all(fd_, iov.data(), iov.size(), error);
+        pending_.clear();
+        return ok;
+    }
+
+    /// queue() and flush() in one.
+    template <typename T>
+        requires (std::is_same_v<T, Ts> || ...)
+    bool send(std::span<const T> records, std::string* error = nullptr) {
+        queue(records);
+        return flush(error);
+    }
+
+    /// Waits until at least one complete batch has arrived, then calls
+    /// handler(std::span<const T>) for every complete batch received so
+    /// far, in order.  The spans point into the receive arena and stay
+    /// valid until the next receive().  False on a closed connection
+    /// (see eof()) or a malformed batch.
+    template <typename Handler>
+    bool receive(Handler&& handler, std::string* error = nullptr) {
+        static_assert((std::is_invocable_v<Handler&, std::span<const Ts>> && ...),
+                      "socket_channel: the handler must accept a span of every registered type");
+        if (fd_ < 0) {
+            if (error) *error = "channel is not open";
+            return false;
+        }
+        // Drop delivered frames.  begin_ is a frame boundary, a multiple of
+        // align_, so the records that follow keep their alignment.
+        if (begin_ > 0) {
+            std::memmove(arena_.data(), arena_.data() + begin_, end_ - begin_);
+            end_ -= begin_;
+            begin_ = 0;
+        }
+        std::size_t need = 0;
+        while ((need = frame_size(0, error)) == 0 || need > end_) {
+            if (need == npos) return false;
+            arena_.reserve(std::max(need, end_ + sizeof(detail::BatchHeader)), end_);
+            const ssize_t n = detail::receive_some(fd_, arena_.data() + end_,
+                                                   arena_.capacity() - end_, error);
+            if (n < 0) return false;
+            if (n == 0) {
+                eof_ = true;
+                if (error)
+                    *error = end_ ? "peer closed the connection inside a batch"
+                                  : "peer closed the connection";
+                return false;
+            }
+            end_ += static_cast<std::size_t>(n);
+        }
+        while ((need = frame_size(begin_, error)) != 0 && need != npos &&
+               begin_ + need <= end_) {
+            deliver(begin_, handler);
+            begin_ += need;
+        }
+        return need != npos;
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    static constexpr std::size_t local_align =
+        std::max({std::size_t{16}, alignof(Ts)...});
+
+    static constexpr std::array<std::size_t, type_count> sizes{sizeof(Ts)...};
+
+    struct Pending {
+        detail::BatchHeader header;
+        const void*         data;
+    };
+
+    int                        fd_ = -1;
+    std::size_t                align_ = local_align;   // frame alignment, both ways
+    std::vector<std::uint32_t> peer_to_local_;         // peer type index -> ours
+    std::vector<Pending>       pending_;
+    detail::ChannelArena       arena_;
+    std::size_t                begin_ = 0;              // first undelivered frame
+    std::size_t                end_ = 0;                // end of received bytes
+    bool                       eof_ = false;
+
+    bool handshake(std::string* error) {
+        const detail::ChannelHello hello{detail::channel_magic, detail::channel_version,
+                                         static_cast<std::uint16_t>(local_align),
+                                         static_cast<std::uint32_t>(type_count), 0};
+        // The 16-byte hellos fit any socket buffer, so both ends may send
+        // before they read; the stamp lists, up to 2 MB, are exchanged
+        // with each end reading while it writes.
+        if (!detail::send_all(fd_, &hello, sizeof(hello), error)) return false;
+
+        detail::ChannelHello peer;
+        if (!detail::receive_all(fd_, &peer, sizeof(peer), error)) return false;
+        auto fail = [error](std::string message) {
+            if (error) *error = "handshake: " + std::move(message);
+            return false;
+        };
+        if (peer.magic == detail::byte_swap32(detail::channel_magic))
+            return fail("peer has the opposite byte order");
+        if (peer.magic != detail::channel_magic)
+            return fail("peer is not a TypeLayout channel");
+        if (peer.version != detail::channel_version)
+            return fail("peer speaks version " + std::to_string(peer.version) +
+                        ", expected " + std::to_string(detail::channel_version));
+        if (peer.type_count == 0 || peer.type_count > detail::channel_max_types ||
+            peer.frame_align < 16 || peer.frame_align > detail::channel_max_align ||
+            (peer.frame_align & (peer.frame_align - 1)) != 0)
+            return fail("malformed hello");
+
+        std::vector<layout_stamp> theirs(peer.type_count);
+        if (!detail::exchange_all(fd_, stamps.data(), sizeof(stamps), theirs.data(),
+                                  theirs.size() * sizeof(layout_stamp), error))
+            return false;
+
+        // Both ends must register the same layouts, so that both reach
+        // the same verdict here.
+        peer_to_local_.assign(theirs.size(), static_cast<std::uint32_t>(type_count));
+        std::array<bool, type_count> matched{};
+        std::string missing, extra;
+        for (std::size_t j = 0; j < theirs.size(); ++j) {
+            for (std::size_t i = 0; i < type_count; ++i) {
+                if (theirs[j] == stamps[i]) {
+                    peer_to_local_[j] = static_cast<std::uint32_t>(i);
+                    matched[i] = true;
+                }
+            }
+            if (peer_to_local_[j] == type_count)
+                extra += (extra.empty() ? "" : "; ") + describe(theirs[j]);
+        }
+        for (std::size_t i = 0; i < type_count; ++i)
+            if (!matched[i]) missing += (missing.empty() ? "" : "; ") + describe(stamps[i]);
+        if (!missing.empty())
+            return fail("peer lacks this build's layout " + missing);
+        if (!extra.empty())
+            return fail("peer has a layout this build lacks: " + extra);
+        align_ = std::max<std::size_t>(local_align, peer.frame_align);
+        return true;
+    }
+
+    /// Bytes of the frame at `at`: 0 while its header is incomplete, npos
+    /// (with `error` set) when the header is malformed.
+    std::size_t frame_size(std::size_t at, std::string* error) const {
+        if (end_ - at < sizeof(detail::BatchHeader)) return 0;
+        detail::BatchHeader h;
+        std::memcpy(&h, arena_.data() + at, sizeof(h));
+        const std::uint32_t local = h.type < peer_to_local_.size()
+                                        ? peer_to_local_[h.type]
+                                        : static_cast<std::uint32_t>(type_count);
+        if (local >= type_count) {
+            if (error) *error = "batch of unknown type " + std::to_string(h.type);
+            return npos;
+        }
+        if (h.count == 0 || h.bytes != std::uint64_t{h.count} * sizes[local] ||
+            h.bytes > detail::channel_max_batch) {
+            if (error) *error = "malformed batch header";
+            return npos;
+        }
+        return align_ + detail::round_up(static_cast<std::size_t>(h.bytes), align_);
+    }
+
+    template <typename Handler>
+    void deliver(std::size_t at, Handler& handler) {
+        detail::BatchHeader h;
+        std::memcpy(&h, arena_.data() + at, sizeof(h));
+        const std::uint32_t local = peer_to_local_[h.type];
+        const unsigned char* records = arena_.data() + at + align_;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (void)((local == I &&
+                    (handler(std::span<const Ts>(
+                         std::launder(reinterpret_cast<const Ts*>(records)), h.count)),
+                     true)) || ...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+};
+
+} // namespace ipc
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_IPC_SOCKET_CHANNEL_HPP
@@ -1,5 +1,5 @@
 // layout_traits<T> -- Compile-time type layout descriptor.
-// Aggregates signature + has_pointer for byte-copy-safe admission.
+// Aggregates signature + structural flags for byte-copy-safe admission.
 // Requires P2996 for struct/class types.
 //
 // Copyright (c) 2024-2026 TypeLayout Development Team
@@ -19,12 +19,7 @@ namespace detail {
 
 template <typename T>
 [[nodiscard]] consteval bool type_has_pointer_layout() noexcept {
-    using Bare = std::remove_cv_t<T>;
-    if constexpr (requires { TypeSignature<Bare>::pointer_free; }) {
-        return !TypeSignature<Bare>::pointer_free;
-    } else {
-        return sig_has_pointer(get_layout_signature<Bare>());
-    }
+    return !signature_flags_v<std::remove_cv_t<T>>.pointer_free;
 }
 
 template <typename T>
@@ -35,7 +30,11 @@ template <typename T>
 template <typename T>
 struct layout_traits {
     static constexpr auto signature = get_layout_signature<T>();
-    static constexpr bool has_pointer = type_has_pointer_layout<T>();
+    static constexpr SigFlags flags = signature_flags_v<std::remove_cv_t<T>>;
+    static constexpr bool has_pointer = !flags.pointer_free;
+    static constexpr bool has_bitfield = flags.has_bitfield;
+    static constexpr bool has_platform_variant = flags.has_platform_variant;
+    static constexpr bool has_opaque = flags.has_opaque;
 };
 
 } // namespace detail
@@ -31,28 +31,27 @@ namespace detail {
 
 template <std::size_t Size, std::size_t Align, typename Tag>
 [[nodiscard]] consteval auto opaque_signature(const Tag& tag) noexcept {
-    return FixedString{"O("} + FixedString{tag} + FixedString{"|"} +
-           to_fixed_string<Size>() + FixedString{"|"} +
-           to_fixed_string<Align>() + FixedString{")"};
+    return concat("O(", FixedString{tag}, "|",
+                  to_fixed_string<Size>(), "|",
+                  to_fixed_string<Align>(), ")");
 }
 
 template <std::size_t Size, std::size_t Align, typename Elem, typename Tag>
 [[nodiscard]] consteval auto opaque_container_signature(const Tag& tag) noexcept {
-    return opaque_signature<Size, Align>(tag) + FixedString{"<"} +
-           TypeSignature<Elem>::calculate() + FixedString{">"};
+    return concat(opaque_signature<Size, Align>(tag), "<",
+                  signature_v<Elem>, ">");
 }
 
 template <std::size_t Size, std::size_t Align, typename Key, typename Value, typename Tag>
 [[nodiscard]] consteval auto opaque_map_signature(const Tag& tag) noexcept {
-    return opaque_signature<Size, Align>(tag) + FixedString{"<"} +
-           TypeSignature<Key>::calculate() + FixedString{","} +
-           TypeSignature<Value>::calculate() + FixedString{">"};
+    return concat(opaque_signature<Size, Align>(tag), "<",
+                  signature_v<Key>, ",",
+                  signature_v<Value>, ">");
 }
 
-template <typename Sig>
-[[nodiscard]] consteval bool signature_pointer_free(const Sig& sig) noexcept {
-    return !sig_has_pointer(sig);
-}
+// Flags of a TYPELAYOUT_REGISTER_OPAQUE type: opaque, no element types.
+template <bool HasPointer>
+inline constexpr SigFlags registered_opaque_flags{!HasPointer, false, false, true};
 
 } // namespace detail
 
@@ -69,9 +68,11 @@ template <typename Sig>
     static_assert(std::is_trivially_copyable_v<Type>,                           \
         "TYPELAYOUT_REGISTER_OPAQUE: opaque type must be trivially copyable");  \
     template <>                                                                 \
-    struct TypeSignature<Type> {                                                \
+    struct TypeSignature<Type>                                                  \
+        : ::boost::typelayout::detail::fixed_sig_flags<                        \
+              ::boost::typelayout::detail::registered_opaque_flags<            \
+                  static_cast<bool>(HasPointer)>> {                            \
         static constexpr bool is_opaque = true;                                \
-        static constexpr bool pointer_free = !(HasPointer);                    \
         static consteval auto calculate() noexcept {                           \
             return ::boost::typelayout::detail::opaque_signature<              \
                 sizeof(Type), alignof(Type)>(Tag);                             \
@@ -89,14 +90,15 @@ template <typename Sig>
 // ===========================================================================
 
 // TYPELAYOUT_OPAQUE_TYPE_RELOCATABLE(Type, name)
-//   Concrete type, pointer_free = true (no element type to scan).
+//   Concrete type, pointer_free = true (no element type).
 //   Relocatable semantics inherently exclude native pointers — types using
 //   offset_ptr are byte-copy safe and contain no address-space dependencies.
 #define TYPELAYOUT_OPAQUE_TYPE_RELOCATABLE(Type, name)                         \
     template <>                                                                 \
-    struct TypeSignature<Type> {                                                \
+    struct TypeSignature<Type>                                                  \
+        : ::boost::typelayout::detail::fixed_sig_flags<                        \
+              ::boost::typelayout::detail::opaque_sig_flags> {                 \
         static constexpr bool is_opaque = true;                                \
-        static constexpr bool pointer_free = true;                             \
         static consteval auto calculate() noexcept {                           \
             return ::boost::typelayout::detail::opaque_signature<              \
                 sizeof(Type), alignof(Type)>(name);                            \
@@ -107,18 +109,18 @@ template <typename Sig>
 
 // TYPELAYOUT_OPAQUE_CONTAINER_RELOCATABLE(Template, name)
 //   Single-parameter container template.  Embeds element type signature.
-//   pointer_free is derived from the generated signature (scans for all
-//   pointer-like tokens via detail::sig_has_pointer).
+//   pointer_free (and the other structural flags) come from the element
+//   type's flags.
 #define TYPELAYOUT_OPAQUE_CONTAINER_RELOCATABLE(Template, name)                \
     template <typename T_>                                                      \
-    struct TypeSignature<Template<T_>> {                                        \
+    struct TypeSignature<Template<T_>>                                          \
+        : ::boost::typelayout::detail::embedded_sig_flags<                     \
+              ::boost::typelayout::detail::opaque_sig_flags, T_> {             \
         static constexpr bool is_opaque = true;                                \
         static consteval auto calculate() noexcept {                           \
             return ::boost::typelayout::detail::opaque_container_signature<    \
                 sizeof(Template<T_>), alignof(Template<T_>), T_>(name);        \
         }                                                                      \
-        static constexpr bool pointer_free =                                   \
-            ::boost::typelayout::detail::signature_pointer_free(calculate());  \
     };                                                                         \
     template <typename T_>                                                      \
     struct opaque_copy_safe<Template<T_>>                                   \
@@ -127,19 +129,19 @@ template <typename Sig>
 
 // TYPELAYOUT_OPAQUE_MAP_RELOCATABLE(Template, name)
 //   Two-parameter container template.  Embeds key + value type signatures.
-//   pointer_free is derived from the generated signature (scans for all
-//   pointer-like tokens via detail::sig_has_pointer).
+//   pointer_free (and the other structural flags) come from the key and
+//   value types' flags.
 #define TYPELAYOUT_OPAQUE_MAP_RELOCATABLE(Template, name)                      \
     template <typename K_, typename V_>                                         \
-    struct TypeSignature<Template<K_, V_>> {                                    \
+    struct TypeSignature<Template<K_, V_>>                                      \
+        : ::boost::typelayout::detail::embedded_sig_flags<                     \
+              ::boost::typelayout::detail::opaque_sig_flags, K_, V_> {         \
         static constexpr bool is_opaque = true;                                \
         static consteval auto calculate() noexcept {                           \
             return ::boost::typelayout::detail::opaque_map_signature<          \
                 sizeof(Template<K_, V_>), alignof(Template<K_, V_>),           \
                 K_, V_>(name);                                                 \
         }                                                                      \
-        static constexpr bool pointer_free =                                   \
-            ::boost::typelayout::detail::signature_pointer_free(calculate());  \
     };                                                                         \
     template <typename K_, typename V_>                                         \
     struct opaque_copy_safe<Template<K_, V_>>                               \
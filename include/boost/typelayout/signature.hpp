@@ -1,12 +1,15 @@
 // Copyright (c) 2024-2026 TypeLayout Development Team
 // Distributed under the Boost Software License, Version 1.0.
 //
-// Public API: get_layout_signature<T>().
+// Public API: get_layout_signature<T>(), get_layout_signature_compact<T>(),
+// get_layout_hash<T>().
 
 #ifndef BOOST_TYPELAYOUT_SIGNATURE_HPP
 #define BOOST_TYPELAYOUT_SIGNATURE_HPP
 
 #include <boost/typelayout/detail/type_map.hpp>
+#include <boost/typelayout/detail/layout_hash.hpp>
+#include <boost/typelayout/detail/sig_compact.hpp>
 
 namespace boost {
 namespace typelayout {
@@ -29,7 +32,46 @@ namespace detail {
 
 template <typename T>
 [[nodiscard]] consteval auto get_layout_signature() noexcept {
-    return detail::get_arch_prefix() + TypeSignature<T>::calculate();
+    return detail::concat(detail::get_arch_prefix(), detail::signature_v<T>);
+}
+
+namespace detail {
+
+template <typename T>
+inline constexpr auto layout_signature_v = get_layout_signature<T>();
+
+} // namespace detail
+
+// Compact layout signature -- the canonical run-length / back-reference
+// form of get_layout_signature<T>() (see detail/sig_compact.hpp).
+// expand_signature() restores the full string.
+
+template <typename T>
+[[nodiscard]] consteval auto get_layout_signature_compact() noexcept {
+    constexpr auto& full = detail::layout_signature_v<T>;
+    constexpr std::string_view view{full.value, full.size};
+    constexpr std::size_t len = compact_signature(view).size();
+    const std::string compact = compact_signature(view);
+    FixedString<len> result;
+    for (std::size_t i = 0; i < len; ++i)
+        result.value[i] = compact[i];
+    return result;
+}
+
+// Layout hash -- FNV-1a over the full signature (see detail/layout_hash.hpp).
+// Equal layouts hash equal across compilers and platforms, so exported
+// hashes can be compared in O(1) instead of comparing signature strings.
+
+template <typename T>
+[[nodiscard]] consteval std::uint64_t get_layout_hash() noexcept {
+    constexpr auto sig = get_layout_signature<T>();
+    return layout_hash(std::string_view(sig.value, sig.size));
+}
+
+template <typename T>
+[[nodiscard]] consteval layout_hash128 get_layout_hash128() noexcept {
+    constexpr auto sig = get_layout_signature<T>();
+    return layout_hash_128(std::string_view(sig.value, sig.size));
 }
 
 } // inline namespace v1
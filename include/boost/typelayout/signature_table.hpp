@@ -0,0 +1,125 @@
+// signature_table.hpp -- Layout signatures of a type list in one static pool.
+//
+// signature_table<Ts...> lays get_layout_signature<Ts>()... out back to
+// back in a single constexpr character pool and describes each type by
+// one fixed-size row (pool offset, length, layout hash, structural flags,
+// byte-copy safety).  Rows follow the order of Ts..., so every lookup is
+// an array index -- at compile time and at runtime alike -- and nothing
+// is allocated: the pool and the rows are static constexpr data.
+//
+//   using Wire = signature_table<PacketHeader, SensorRecord>;
+//   static_assert(Wire::signature_of<SensorRecord>() ==
+//                 std::string_view(get_layout_signature<SensorRecord>()));
+//   std::string_view sig = Wire::signature(i);      // runtime, O(1)
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_SIGNATURE_TABLE_HPP
+#define BOOST_TYPELAYOUT_SIGNATURE_TABLE_HPP
+
+#include <boost/typelayout/signature.hpp>
+#include <boost/typelayout/admission.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+
+/// One type of a signature_table.
+struct signature_table_row {
+    std::uint32_t    offset;          // first character in the pool
+    std::uint32_t    length;          // signature length (no terminator)
+    std::uint64_t    layout_hash;     // get_layout_hash<T>()
+    detail::SigFlags flags;           // structural flags of T
+    bool             byte_copy_safe;  // is_byte_copy_safe_v<T>
+};
+
+namespace detail {
+
+template <typename T, typename... Ts>
+consteval std::size_t signature_table_index() noexcept {
+    constexpr bool matches[] = {std::is_same_v<T, Ts>..., false};
+    static_assert((std::size_t{0} + ... + std::size_t(std::is_same_v<T, Ts>)) == 1,
+        "signature_table: T must appear exactly once in the type list");
+    std::size_t i = 0;
+    while (!matches[i]) ++i;
+    return i;
+}
+
+template <typename T>
+consteval signature_table_row make_signature_table_row(std::size_t offset) noexcept {
+    constexpr auto& sig = layout_signature_v<T>;
+    static_assert(sig.size <= 0xffffffffu,
+        "signature_table: signature longer than 4 GiB");
+    return {static_cast<std::uint32_t>(offset),
+            static_cast<std::uint32_t>(sig.size),
+            layout_hash(std::string_view(sig.value, sig.size)),
+            signature_flags_v<std::remove_cv_t<T>>,
+            is_byte_copy_safe_v<T>};
+}
+
+} // namespace detail
+
+template <typename... Ts>
+struct signature_table {
+    static constexpr std::size_t size = sizeof...(Ts);
+
+private:
+    static consteval auto make_pool() noexcept {
+        if constexpr (sizeof...(Ts) == 0) return FixedString<0>{};
+        else return detail::concat(detail::layout_signature_v<Ts>...);
+    }
+
+public:
+    /// All signatures, concatenated in the order of Ts... .
+    static constexpr auto pool = make_pool();
+
+    static_assert(pool.size <= 0xffffffffu,
+        "signature_table: signature pool larger than 4 GiB");
+
+private:
+    static consteval std::array<signature_table_row, size> make_rows() noexcept {
+        std::array<signature_table_row, size> rows{};
+        [[maybe_unused]] std::size_t i = 0;
+        [[maybe_unused]] std::size_t offset = 0;
+        ((rows[i++] = detail::make_signature_table_row<Ts>(offset),
+          offset += detail::layout_signature_v<Ts>.size), ...);
+        return rows;
+    }
+
+public:
+    static constexpr std::array<signature_table_row, size> rows = make_rows();
+
+    /// Row index of T (a compile error unless T occurs exactly once).
+    template <typename T>
+    static constexpr std::size_t index_of = detail::signature_table_index<T, Ts...>();
+
+    static constexpr const signature_table_row& row(std::size_t i) noexcept {
+        return rows[i];
+    }
+
+    static constexpr std::string_view signature(std::size_t i) noexcept {
+        return {pool.value + rows[i].offset, rows[i].length};
+    }
+
+    static constexpr std::uint64_t layout_hash(std::size_t i) noexcept {
+        return rows[i].layout_hash;
+    }
+
+    template <typename T>
+    static constexpr std::string_view signature_of() noexcept {
+        return signature(index_of<T>);
+    }
+};
+
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_SIGNATURE_TABLE_HPP
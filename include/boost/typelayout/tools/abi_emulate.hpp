@@ -0,0 +1,359 @@
+// AbiEmulator -- predict the signatures another platform would export,
+// from one build on the host.
+//
+// Phase 1 normally runs the exporter once per platform.  AbiEmulator
+// describes each registered type with P2996 reflection (an AbiTypeGraph,
+// tools/abi_layout.hpp) and lays it out under a declared AbiModel
+// (tools/abi_model.hpp), so one host build can also write the .sig.hpp of
+// platforms that have no P2996 toolchain:
+//
+//   AbiEmulator em;
+//   em.add<PacketHeader>("PacketHeader");
+//   SigExporter win = em.predict(abi::x86_64_windows_msvc);
+//   win.write("sigs/x86_64_windows_msvc.sig.hpp");
+//
+// or, as a generated main(), TYPELAYOUT_EXPORT_TYPES_PREDICTED(...) with
+// `--predict=x86_64_windows_msvc,arm64_macos_clang` (or `--predict=all`).
+//
+// A prediction is only as good as the model.  Before predicting, every
+// type is laid out under host_abi_model() and compared with the host's own
+// layout_signature_v<T>; a type that does not reproduce (packed records,
+// hand-written TypeSignature specializations, layouts outside the modelled
+// rules) is reported by unpredictable() and left out of every prediction.
+// Opaque types keep their registered signature, host size included.
+//
+// Declared scalar kinds come from the member's spelled type: an alias
+// named [u]intN_t is fixed width, size_t / ptrdiff_t / [u]intptr_t /
+// ssize_t follow the pointer size, any other alias keeps the host width of
+// the type it names, and a member declared `long` follows the model's
+// sizeof(long).
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_ABI_EMULATE_HPP
+#define BOOST_TYPELAYOUT_TOOLS_ABI_EMULATE_HPP
+
+#include <boost/typelayout/tools/abi_layout.hpp>
+#include <boost/typelayout/tools/abi_model.hpp>
+#include <boost/typelayout/tools/sig_export.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+
+namespace detail {
+
+    // One graph node per spelled type: `Spelling` is the reflection of the
+    // type as written (an alias stays an alias).  With `HostLong`, long
+    // keeps its host width wherever it is spelled.
+    template <std::meta::info Spelling, bool HostLong>
+    inline constexpr char abi_type_key = 0;
+
+    consteval bool abi_alias_named(std::meta::info t,
+                                   std::initializer_list<std::string_view> names) {
+        if (!std::meta::is_type_alias(t) || !std::meta::has_identifier(t)) return false;
+        for (std::string_view n : names)
+            if (std::meta::identifier_of(t) == n) return true;
+        return false;
+    }
+
+    template <typename T>
+    consteval AbiScalar abi_fixed_int() noexcept {
+        constexpr bool s = std::is_signed_v<T>;
+        if constexpr (sizeof(T) == 1) return s ? AbiScalar::I8 : AbiScalar::U8;
+        else if constexpr (sizeof(T) == 2) return s ? AbiScalar::I16 : AbiScalar::U16;
+        else if constexpr (sizeof(T) == 4) return s ? AbiScalar::I32 : AbiScalar::U32;
+        else return s ? AbiScalar::I64 : AbiScalar::U64;
+    }
+
+    // Declared kind of the scalar T, spelled `Spelling`.
+    template <typename T, std::meta::info Spelling, bool HostLong>
+    consteval AbiScalar abi_scalar() noexcept {
+        if constexpr (std::is_same_v<T, std::byte>) return AbiScalar::Byte;
+        else if constexpr (std::is_same_v<T, bool>) return AbiScalar::Bool;
+        else if constexpr (std::is_same_v<T, char>) return AbiScalar::Char;
+        else if constexpr (std::is_same_v<T, wchar_t>) return AbiScalar::WChar;
+        else if constexpr (std::is_same_v<T, char8_t>) return AbiScalar::Char8;
+        else if constexpr (std::is_same_v<T, char16_t>) return AbiScalar::Char16;
+        else if constexpr (std::is_same_v<T, char32_t>) return AbiScalar::Char32;
+        else if constexpr (std::is_same_v<T, float>) return AbiScalar::F32;
+        else if constexpr (std::is_same_v<T, double>) return AbiScalar::F64;
+        else if constexpr (std::is_same_v<T, long double>) return AbiScalar::LongDouble;
+        else if constexpr (std::is_null_pointer_v<T>) return AbiScalar::Nullptr;
+        else if constexpr (std::is_lvalue_reference_v<T>) return AbiScalar::Ref;
+        else if constexpr (std::is_rvalue_reference_v<T>) return AbiScalar::RRef;
+        else if constexpr (std::is_member_function_pointer_v<T>) return AbiScalar::MemFnPtr;
+        else if constexpr (std::is_member_object_pointer_v<T>) return AbiScalar::MemDataPtr;
+        else if constexpr (std::is_pointer_v<T>) {
+            return std::is_function_v<std::remove_pointer_t<T>> ? AbiScalar::FnPtr
+                                                                : AbiScalar::Ptr;
+        } else if constexpr (abi_alias_named(Spelling, {"size_t", "ssize_t", "ptrdiff_t",
+                                                        "intptr_t", "uintptr_t"})) {
+            return std::is_signed_v<T> ? AbiScalar::ISize : AbiScalar::USize;
+        } else if constexpr (std::is_same_v<T, long> || std::is_same_v<T, unsigned long>) {
+            if constexpr (HostLong || std::meta::is_type_alias(Spelling))
+                return abi_fixed_int<T>();
+            else return std::is_same_v<T, long> ? AbiScalar::Long : AbiScalar::ULong;
+        } else if constexpr (std::is_same_v<T, long long>) {
+            return AbiScalar::LongLong;
+        } else if constexpr (std::is_same_v<T, unsigned long long>) {
+            return AbiScalar::ULongLong;
+        } else {
+            static_assert(std::is_integral_v<T>, "AbiEmulator: unsupported scalar type");
+            return abi_fixed_int<T>();
+        }
+    }
+
+    template <std::meta::info Spelling, bool HostLong = false>
+    std::uint32_t describe_abi_type(AbiTypeGraph& graph);
+
+    template <typename T, std::size_t Index>
+    AbiMember describe_abi_base(AbiTypeGraph& graph) {
+        constexpr auto base = reflected_bases_v<T>[Index];
+        AbiMember m;
+        m.type        = describe_abi_type<std::meta::type_of(base)>(graph);
+        m.base        = true;
+        m.host_offset = std::meta::offset_of(base).bytes;
+        return m;
+    }
+
+    template <typename T, std::size_t Index>
+    AbiMember describe_abi_field(AbiTypeGraph& graph) {
+        constexpr auto member = reflected_members_v<T>[Index];
+        using F = [:std::meta::type_of(member):];
+        AbiMember m;
+        m.type        = describe_abi_type<std::meta::type_of(member)>(graph);
+        m.host_offset = std::meta::offset_of(member).bytes;
+        if constexpr (std::meta::is_bit_field(member)) {
+            m.bit_field = true;
+            m.bit_width = static_cast<std::uint32_t>(std::meta::bit_size_of(member));
+            m.host_bit  = static_cast<std::uint32_t>(std::meta::offset_of(member).bits);
+        } else if constexpr (!std::is_reference_v<F> &&
+                             std::meta::alignment_of(member) > alignof(F)) {
+            m.explicit_align = std::meta::alignment_of(member);
+        }
+        return m;
+    }
+
+    // Itanium "POD for the purpose of layout": C++03 POD.
+    template <typename T>
+    consteval bool abi_pod_for_layout() noexcept {
+        if constexpr (!std::is_trivially_copyable_v<T> ||
+                      !std::is_trivially_default_constructible_v<T> ||
+                      !std::is_standard_layout_v<T> || get_base_count<T>() != 0) {
+            return false;
+        } else {
+            for (std::meta::info m : reflected_members_v<T>)
+                if (!std::meta::is_public(m)) return false;
+            return true;
+        }
+    }
+
+    template <typename T>
+    AbiType describe_abi_record(AbiTypeGraph& graph) {
+        AbiType t;
+        t.kind           = std::is_union_v<T> ? AbiTypeKind::Union : AbiTypeKind::Record;
+        t.polymorphic    = std::is_polymorphic_v<T>;
+        t.empty          = std::is_empty_v<T>;
+        t.pod_for_layout = abi_pod_for_layout<T>();
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (t.members.push_back(describe_abi_base<T, Is>(graph)), ...);
+        }(std::make_index_sequence<get_base_count<T>()>{});
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (t.members.push_back(describe_abi_field<T, Is>(graph)), ...);
+        }(std::make_index_sequence<get_member_count<T>()>{});
+        return t;
+    }
+
+    template <std::meta::info Spelling, bool HostLong>
+    std::uint32_t describe_abi_type(AbiTypeGraph& graph) {
+        const void* key = &abi_type_key<Spelling, HostLong>;
+        if (std::uint32_t id = graph.find(key); id != AbiTypeGraph::npos) return id;
+
+        using T = std::remove_cv_t<typename [:Spelling:]>;
+        AbiType t;
+        if constexpr (has_opaque_signature<T>) {
+            constexpr auto& sig = signature_v<T>;
+            t.kind      = AbiTypeKind::Opaque;
+            t.signature = std::string(sig.value, sig.size);
+        } else if constexpr (std::is_array_v<T>) {
+            using E = std::remove_extent_t<T>;
+            t.kind       = AbiTypeKind::Array;
+            t.element    = describe_abi_type<std::meta::remove_extent(Spelling), HostLong>(graph);
+            t.count      = std::extent_v<T>;
+            t.byte_array = is_byte_element<std::remove_cv_t<E>>();
+        } else if constexpr (std::is_enum_v<T> && !std::is_same_v<T, std::byte>) {
+            // The enum-base is not reflected as spelled; an underlying
+            // long is taken at host width (usually an [u]int64_t base).
+            t.kind    = AbiTypeKind::Enum;
+            t.element = describe_abi_type<^^std::underlying_type_t<T>, true>(graph);
+        } else if constexpr (std::is_class_v<T> || std::is_union_v<T>) {
+            static_assert(!has_virtual_base<T>(),
+                "AbiEmulator: virtual inheritance is not supported");
+            t = describe_abi_record<T>(graph);
+        } else {
+            t.kind   = AbiTypeKind::Scalar;
+            t.scalar = abi_scalar<T, Spelling, HostLong>();
+        }
+        if constexpr (!std::is_reference_v<T>) {
+            t.host_size  = sizeof(T);
+            t.host_align = alignof(T);
+        }
+        return graph.add(key, std::move(t));
+    }
+
+} // namespace detail
+
+/// Describes registered types once and predicts their signatures under
+/// any number of AbiModels.
+class AbiEmulator {
+public:
+    /// Register T under `name` (as SigExporter::add).
+    template <typename T>
+    void add(const std::string& name) {
+        constexpr auto& sig = detail::layout_signature_v<T>;
+        const std::uint32_t type = detail::describe_abi_type<^^T>(graph_);
+        entries_.push_back({name, type, std::string_view(sig.value, sig.size),
+                            is_byte_copy_safe_v<T>, false});
+        checked_ = false;
+    }
+
+    /// Register Ts..., one name per type, in order (as SigExporter::add_table).
+    template <typename... Ts>
+    void add_table(std::span<const std::string_view, sizeof...(Ts)> names) {
+        std::size_t i = 0;
+        (add<Ts>(std::string(names[i++])), ...);
+    }
+
+    /// An exporter holding `target`'s predicted signatures, named after
+    /// `target` and carrying its metadata.  Types that the host model does
+    /// not reproduce are left out and reported on `warn` (once).
+    SigExporter predict(const AbiModel& target, std::ostream& warn = std::cerr) {
+        check_host(warn);
+        AbiLayoutEngine engine(graph_, target);
+        SigExporter ex(target, target.display_name);
+        for (const Entry& e : entries_)
+            if (!e.unpredictable) ex.add_signature(e.name, engine.signature(e.type),
+                                                   e.byte_copy_safe);
+        return ex;
+    }
+
+    /// Names of the registered types that cannot be predicted.
+    std::vector<std::string> unpredictable(std::ostream& warn = std::cerr) {
+        check_host(warn);
+        std::vector<std::string> names;
+        for (const Entry& e : entries_)
+            if (e.unpredictable) names.push_back(e.name);
+        return names;
+    }
+
+private:
+    struct Entry {
+        std::string      name;
+        std::uint32_t    type;
+        std::string_view host_sig;       // layout_signature_v<T>
+        bool             byte_copy_safe;
+        bool             unpredictable;
+    };
+
+    AbiTypeGraph       graph_;
+    std::vector<Entry> entries_;
+    bool               checked_ = false;
+
+    // Calibrate against the host and mark the types its model misses.
+    void check_host(std::ostream& warn) {
+        if (checked_) return;
+        const AbiModel host = host_abi_model();
+        AbiLayoutEngine::calibrate(graph_, host);
+        AbiLayoutEngine engine(graph_, host);
+        for (Entry& e : entries_) {
+            e.unpredictable = engine.signature(e.type) != e.host_sig;
+            if (e.unpredictable)
+                warn << "[typelayout] " << e.name << ": layout is outside the "
+                     << "emulated ABI rules; not predicted\n";
+        }
+        checked_ = true;
+    }
+};
+
+namespace detail {
+
+/// run_export() that also writes predicted platforms: `--predict=a,b`
+/// names AbiModels from abi_models[] (`all` for every one but the host's
+/// own platform); the other arguments apply to each export.
+inline int run_export(SigExporter& ex, AbiEmulator& em, int argc, char* argv[]) {
+    std::vector<char*> args;
+    std::vector<const AbiModel*> targets;
+    const std::string host = ex.platform_name();
+    for (int i = 0; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (i == 0 || !arg.starts_with("--predict=")) {
+            args.push_back(argv[i]);
+            continue;
+        }
+        std::string_view list = arg.substr(10);
+        while (!list.empty()) {
+            std::string_view name = list.substr(0, list.find(','));
+            list.remove_prefix(std::min(list.size(), name.size() + 1));
+            if (name == "all") {
+                for (const AbiModel& m : abi_models)
+                    if (m.platform_name != host) targets.push_back(&m);
+            } else if (const AbiModel* m = find_abi_model(name)) {
+                if (m->platform_name != host) targets.push_back(m);
+            } else {
+                std::cerr << "[typelayout] unknown --predict platform: " << name << "\n";
+                return 2;
+            }
+        }
+    }
+
+    const int n = static_cast<int>(args.size());
+    int rc = run_export(ex, n, args.data());
+    for (const AbiModel* m : targets) {
+        if (rc != 0) break;
+        SigExporter predicted = em.predict(*m);
+        rc = run_export(predicted, n, args.data());
+    }
+    return rc;
+}
+
+} // namespace detail
+
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+// ---------------------------------------------------------------------------
+// TYPELAYOUT_EXPORT_TYPES_PREDICTED(...)
+//
+// TYPELAYOUT_EXPORT_TYPES with --predict: the generated main() exports the
+// host and, for each platform named by --predict=a,b (or all), a predicted
+// .sig.hpp next to it.
+// ---------------------------------------------------------------------------
+#define TYPELAYOUT_EXPORT_TYPES_PREDICTED(...)                              \
+    int main(int argc, char* argv[]) {                                      \
+        static constexpr std::string_view typelayout_type_names_[] = {      \
+            TYPELAYOUT_DETAIL_FOR_EACH(TYPELAYOUT_DETAIL_TYPE_NAME,         \
+                                       __VA_ARGS__)                         \
+        };                                                                  \
+        ::boost::typelayout::SigExporter ex;                                \
+        ex.add_table<__VA_ARGS__>(typelayout_type_names_);                  \
+        ::boost::typelayout::AbiEmulator em;                                \
+        em.add_table<__VA_ARGS__>(typelayout_type_names_);                  \
+        return ::boost::typelayout::detail::run_export(ex, em, argc, argv); \
+    }
+
+#endif // BOOST_TYPELAYOUT_TOOLS_ABI_EMULATE_HPP
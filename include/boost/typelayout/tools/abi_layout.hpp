@@ -0,0 +1,562 @@
+// AbiTypeGraph / AbiLayoutEngine -- lay a described type out under an
+// AbiModel and write the signature that model's compiler would export.
+//
+// An AbiTypeGraph holds what layout depends on and the host's sizes do
+// not: the declared kind of every scalar (`long` and `wchar_t` rather
+// than i64 and wchar[s:4]), the bases and fields of records and unions in
+// declaration order, bit-field widths, alignas values, and the host's own
+// sizes and offsets.  tools/abi_emulate.hpp builds it with P2996
+// reflection; the engine itself needs no reflection.
+//
+// AbiLayoutEngine applies the model's rules -- primitive sizes and
+// alignments, vptr and primary-base placement, empty-base placement,
+// Itanium tail-padding reuse, [[no_unique_address]], and Itanium or MSVC
+// bit-field allocation -- and emits the signature grammar of
+// detail/signature_impl.hpp (records flattened, empty classes at s:0, byte
+// arrays as bytes[...]).
+//
+// Two properties cannot be reflected and are recovered by calibrate(),
+// which lays the graph out under the host's own model and compares with
+// the host's offsets: class-level alignas, and [[no_unique_address]] on
+// empty members.  Packed records and anything else outside the modelled
+// rules are not detected here; AbiEmulator compares the host prediction
+// with the host signature and does not predict types that differ.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_ABI_LAYOUT_HPP
+#define BOOST_TYPELAYOUT_TOOLS_ABI_LAYOUT_HPP
+
+#include <boost/typelayout/tools/abi_model.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+
+/// A scalar as declared, before a model gives it a size.
+enum class AbiScalar : std::uint8_t {
+    I8, U8, I16, U16, I32, U32, I64, U64,   // fixed width (also int, short, ...)
+    Long, ULong,                            // sizeof_long
+    LongLong, ULongLong,                    // 8 bytes, int64_align
+    ISize, USize,                           // ptrdiff_t, size_t, [u]intptr_t
+    F32, F64, LongDouble,
+    Char, WChar, Char8, Char16, Char32, Bool, Byte, Nullptr,
+    Ptr, Ref, RRef, FnPtr, MemDataPtr, MemFnPtr,
+};
+
+enum class AbiTypeKind : std::uint8_t {
+    Scalar,
+    Record,   // class or struct
+    Union,
+    Enum,     // element: the underlying type
+    Array,    // element, count
+    Opaque,   // registered opaque signature, copied verbatim
+};
+
+/// A direct base or non-static data member.
+struct AbiMember {
+    std::uint32_t type           = 0;
+    bool          base           = false;
+    bool          bit_field      = false;
+    bool          overlapping    = false;   // [[no_unique_address]] (calibrate)
+    std::uint32_t bit_width      = 0;
+    std::size_t   explicit_align = 0;       // alignas on the member; 0 if none
+    std::size_t   host_offset    = 0;       // bit-fields: byte of the first bit
+    std::uint32_t host_bit       = 0;
+};
+
+struct AbiType {
+    AbiTypeKind   kind           = AbiTypeKind::Scalar;
+    AbiScalar     scalar         = AbiScalar::I8;
+    bool          polymorphic    = false;
+    bool          empty          = false;   // std::is_empty_v
+    bool          pod_for_layout = false;   // Itanium never reuses its tail padding
+    bool          byte_array     = false;   // Array written as bytes[s:N,a:1]
+    std::size_t   host_size      = 0;
+    std::size_t   host_align     = 0;
+    std::size_t   explicit_align = 0;       // alignas on a record (calibrate)
+    std::uint32_t element        = 0;
+    std::uint64_t count          = 0;
+    std::string   signature;                // Opaque
+    std::vector<AbiMember> members;         // bases first, then fields
+};
+
+/// Described types, indexed by position.  Types added with a key (one per
+/// C++ type) are shared.
+class AbiTypeGraph {
+public:
+    static constexpr std::uint32_t npos = 0xffffffffu;
+
+    std::uint32_t find(const void* key) const {
+        auto it = keys_.find(key);
+        return it == keys_.end() ? npos : it->second;
+    }
+
+    std::uint32_t add(AbiType type) {
+        types_.push_back(std::move(type));
+        return static_cast<std::uint32_t>(types_.size() - 1);
+    }
+
+    std::uint32_t add(const void* key, AbiType type) {
+        std::uint32_t i = add(std::move(type));
+        keys_.emplace(key, i);
+        return i;
+    }
+
+    const AbiType& operator[](std::uint32_t i) const { return types_[i]; }
+    AbiType&       operator[](std::uint32_t i) { return types_[i]; }
+    std::size_t    size() const noexcept { return types_.size(); }
+
+private:
+    std::vector<AbiType>                           types_;
+    std::unordered_map<const void*, std::uint32_t> keys_;
+};
+
+/// "@<offset><tail>" in a flattened member list, e.g. {8, ":u32[s:4,a:4]"}
+/// or {2, ".3:bits<5,u8[s:1,a:1]>"}.
+struct AbiField {
+    std::size_t offset;
+    std::string tail;
+};
+
+/// An empty class subobject, for Itanium's same-type-same-address rule.
+struct AbiEmptySubobject {
+    std::uint32_t type;
+    std::size_t   offset;
+};
+
+/// One type under one model.
+struct AbiLayout {
+    std::size_t size      = 0;
+    std::size_t align     = 1;
+    std::size_t data_size = 0;                // without tail padding
+    std::string signature;                    // no arch prefix
+    std::vector<AbiField>          fields;    // Record: flattened members
+    std::vector<AbiEmptySubobject> empties;   // Record/Union
+    bool leads_with_empty = false;            // MSVC base padding
+    bool ends_with_empty  = false;
+};
+
+class AbiLayoutEngine {
+public:
+    AbiLayoutEngine(const AbiTypeGraph& types, const AbiModel& model)
+        : types_(&types), model_(model),
+          layouts_(types.size()), state_(types.size(), 0) {}
+
+    const AbiModel& model() const noexcept { return model_; }
+
+    /// Layout of `type`; computed once per engine.
+    const AbiLayout& layout(std::uint32_t type) {
+        if (state_[type] == 2) return layouts_[type];
+        state_[type] = 1;
+        const AbiType& t = (*types_)[type];
+        AbiLayout& out = layouts_[type];
+        switch (t.kind) {
+        case AbiTypeKind::Scalar: layout_scalar(t, out); break;
+        case AbiTypeKind::Record: layout_record(type, out); break;
+        case AbiTypeKind::Union:  layout_union(type, out); break;
+        case AbiTypeKind::Enum:   layout_enum(t, out); break;
+        case AbiTypeKind::Array:  layout_array(t, out); break;
+        case AbiTypeKind::Opaque:
+            out.size = t.host_size;
+            out.align = t.host_align;
+            out.data_size = t.host_size;
+            out.signature = t.signature;
+            break;
+        }
+        state_[type] = 2;
+        return out;
+    }
+
+    /// Full signature of `type` (arch prefix included).
+    std::string signature(std::uint32_t type) {
+        std::string sig(model_.arch_prefix());
+        sig += layout(type).signature;
+        return sig;
+    }
+
+    /// Lays every type out under `host` and records what reflection does
+    /// not expose: a record whose host alignment exceeds the modelled one
+    /// gets that alignment as its alignas, and an empty member found where
+    /// only [[no_unique_address]] could put it is marked overlapping.
+    static void calibrate(AbiTypeGraph& types, const AbiModel& host) {
+        AbiLayoutEngine engine(types, host);
+        engine.calibrating_ = &types;
+        for (std::uint32_t i = 0; i < types.size(); ++i) engine.layout(i);
+    }
+
+private:
+    static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+    const AbiTypeGraph*    types_;
+    AbiTypeGraph*          calibrating_ = nullptr;
+    AbiModel               model_;
+    std::vector<AbiLayout> layouts_;
+    std::vector<char>      state_;     // 0 new, 1 in progress, 2 done
+
+    static std::size_t align_up(std::size_t v, std::size_t a) {
+        return a <= 1 ? v : (v + a - 1) / a * a;
+    }
+
+    static std::string params(std::size_t size, std::size_t align) {
+        return "[s:" + std::to_string(size) + ",a:" + std::to_string(align) + "]";
+    }
+
+    static std::string join_fields(const std::vector<AbiField>& fields) {
+        std::string s;
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            if (i) s += ',';
+            s += '@';
+            s += std::to_string(fields[i].offset);
+            s += fields[i].tail;
+        }
+        return s;
+    }
+
+    static std::string record_signature(std::size_t size, std::size_t align, bool vptr,
+                                        const std::vector<AbiField>& fields) {
+        std::string s = "record[s:" + std::to_string(size) + ",a:" + std::to_string(align);
+        s += vptr ? ",vptr]{" : "]{";
+        s += join_fields(fields);
+        s += '}';
+        return s;
+    }
+
+    void layout_scalar(const AbiType& t, AbiLayout& out) const {
+        const std::size_t p = model_.pointer_size;
+        const std::size_t i64a = model_.int64_align;
+        const char* name = "";
+        std::size_t size = 1, align = 1;
+        auto set = [&](const char* n, std::size_t s, std::size_t a) {
+            name = n; size = s; align = a;
+        };
+        switch (t.scalar) {
+        case AbiScalar::I8:         set("i8", 1, 1); break;
+        case AbiScalar::U8:         set("u8", 1, 1); break;
+        case AbiScalar::I16:        set("i16", 2, 2); break;
+        case AbiScalar::U16:        set("u16", 2, 2); break;
+        case AbiScalar::I32:        set("i32", 4, 4); break;
+        case AbiScalar::U32:        set("u32", 4, 4); break;
+        case AbiScalar::I64:
+        case AbiScalar::LongLong:   set("i64", 8, i64a); break;
+        case AbiScalar::U64:
+        case AbiScalar::ULongLong:  set("u64", 8, i64a); break;
+        case AbiScalar::Long:
+            if (model_.sizeof_long == 8) set("i64", 8, i64a); else set("i32", 4, 4);
+            break;
+        case AbiScalar::ULong:
+            if (model_.sizeof_long == 8) set("u64", 8, i64a); else set("u32", 4, 4);
+            break;
+        case AbiScalar::ISize:      if (p == 8) set("i64", 8, i64a); else set("i32", 4, 4); break;
+        case AbiScalar::USize:      if (p == 8) set("u64", 8, i64a); else set("u32", 4, 4); break;
+        case AbiScalar::F32:        set("f32", 4, 4); break;
+        case AbiScalar::F64:        set("f64", 8, model_.double_align); break;
+        case AbiScalar::LongDouble:
+            set(model_.long_double_tag, model_.sizeof_long_double, model_.long_double_align);
+            break;
+        case AbiScalar::Char:       set("char", 1, 1); break;
+        case AbiScalar::WChar:      set("wchar", model_.sizeof_wchar_t, model_.sizeof_wchar_t); break;
+        case AbiScalar::Char8:      set("char8", 1, 1); break;
+        case AbiScalar::Char16:     set("char16", 2, 2); break;
+        case AbiScalar::Char32:     set("char32", 4, 4); break;
+        case AbiScalar::Bool:       set("bool", 1, 1); break;
+        case AbiScalar::Byte:       set("byte", 1, 1); break;
+        case AbiScalar::Nullptr:    set("nullptr", p, p); break;
+        case AbiScalar::Ptr:        set("ptr", p, p); break;
+        case AbiScalar::Ref:        set("ref", p, p); break;
+        case AbiScalar::RRef:       set("rref", p, p); break;
+        case AbiScalar::FnPtr:      set("fnptr", p, p); break;
+        case AbiScalar::MemDataPtr:
+            set("memptr", model_.member_data_ptr_size, std::min(model_.member_data_ptr_size, p));
+            break;
+        case AbiScalar::MemFnPtr:
+            set("memptr", model_.member_fn_ptr_size, std::min(model_.member_fn_ptr_size, p));
+            break;
+        }
+        out.size = size;
+        out.align = align;
+        out.data_size = size;
+        out.signature = name + params(size, align);
+    }
+
+    void layout_enum(const AbiType& t, AbiLayout& out) {
+        const AbiLayout& u = layout(t.element);
+        out.size = u.size;
+        out.align = u.align;
+        out.data_size = u.size;
+        out.signature = "enum" + params(u.size, u.align) + "<" + u.signature + ">";
+    }
+
+    void layout_array(const AbiType& t, AbiLayout& out) {
+        const AbiLayout& e = layout(t.element);
+        out.size = e.size * static_cast<std::size_t>(t.count);
+        out.align = e.align;
+        out.data_size = out.size;
+        if (t.byte_array)
+            out.signature = "bytes[s:" + std::to_string(t.count) + ",a:1]";
+        else
+            out.signature = "array" + params(out.size, out.align) + "<" + e.signature +
+                            "," + std::to_string(t.count) + ">";
+    }
+
+    // ---- Itanium empty-subobject rule ------------------------------------
+
+    static bool conflicts(const std::vector<AbiEmptySubobject>& placed,
+                          const std::vector<AbiEmptySubobject>& incoming,
+                          std::size_t offset) {
+        for (const auto& e : incoming)
+            for (const auto& p : placed)
+                if (p.type == e.type && p.offset == e.offset + offset) return true;
+        return false;
+    }
+
+    static std::size_t avoid_conflicts(const std::vector<AbiEmptySubobject>& placed,
+                                       const std::vector<AbiEmptySubobject>& incoming,
+                                       std::size_t offset, std::size_t align) {
+        while (conflicts(placed, incoming, offset)) offset += std::max<std::size_t>(align, 1);
+        return offset;
+    }
+
+    // Offset 0 if free, else the first free aligned offset from data_size.
+    static std::size_t place_empty(const std::vector<AbiEmptySubobject>& placed,
+                                   const AbiLayout& empty, std::size_t data_size,
+                                   std::size_t align) {
+        if (!conflicts(placed, empty.empties, 0)) return 0;
+        return avoid_conflicts(placed, empty.empties, align_up(data_size, align), align);
+    }
+
+    static void add_empties(std::vector<AbiEmptySubobject>& placed,
+                            const std::vector<AbiEmptySubobject>& incoming,
+                            std::size_t offset) {
+        for (const auto& e : incoming) placed.push_back({e.type, e.offset + offset});
+    }
+
+    // ---- Records ---------------------------------------------------------
+
+    // Bit-field cursor state.  `bits` is the data size in bits; an MSVC
+    // storage unit, while open, ends at `unit_end`.
+    struct BitCursor {
+        std::size_t bits      = 0;
+        std::size_t unit_size = 0;   // bytes of the open MSVC unit's type; 0 = none
+        std::size_t unit_end  = 0;
+
+        void close_unit() {
+            if (unit_size) bits = unit_end;
+            unit_size = 0;
+        }
+        std::size_t data_size() const { return (bits + 7) / 8; }
+    };
+
+    // Places a bit-field of layout `fl` and width `w`; returns its bit offset.
+    std::size_t place_bitfield(BitCursor& c, const AbiLayout& fl, std::size_t w,
+                               std::size_t& align) const {
+        const std::size_t unit_bits  = fl.size * 8;
+        const std::size_t align_bits = fl.align * 8;
+        if (model_.bitfield_rule == AbiBitfieldRule::itanium) {
+            if (w == 0) {
+                c.bits = align_up(c.bits, align_bits);
+                return c.bits;
+            }
+            if (c.bits % align_bits + w > unit_bits) c.bits = align_up(c.bits, align_bits);
+            const std::size_t pos = c.bits;
+            c.bits += w;
+            align = std::max(align, fl.align);
+            return pos;
+        }
+        if (w == 0) {
+            c.close_unit();
+            return c.bits;
+        }
+        if (c.unit_size != fl.size || c.bits + w > c.unit_end) {
+            c.close_unit();
+            c.bits = align_up(c.data_size(), fl.align) * 8;
+            c.unit_size = fl.size;
+            c.unit_end = c.bits + unit_bits;
+        }
+        const std::size_t pos = c.bits;
+        c.bits += w;
+        align = std::max(align, fl.align);
+        return pos;
+    }
+
+    void layout_record(std::uint32_t id, AbiLayout& out) {
+        const AbiType& t = (*types_)[id];
+        const bool itanium = model_.empty_base_rule == AbiEmptyBaseRule::itanium;
+        const std::size_t n = t.members.size();
+        std::vector<std::size_t> offsets(n, 0);
+        std::vector<std::size_t> bit_offsets(n, 0);
+        std::size_t align = 1;
+        std::size_t size_floor = 0;   // sizeof >= this (bases and members past the data)
+        BitCursor c;
+
+        // The primary base -- the first polymorphic one -- shares its vptr
+        // and goes first; otherwise a polymorphic record starts with one.
+        std::size_t primary = none;
+        for (std::size_t i = 0; i < n && primary == none; ++i)
+            if (t.members[i].base && (*types_)[t.members[i].type].polymorphic) primary = i;
+        if (t.polymorphic && primary == none) {
+            c.bits = model_.pointer_size * 8;
+            align = model_.pointer_size;
+        }
+
+        std::vector<std::size_t> base_order;
+        if (primary != none) base_order.push_back(primary);
+        for (std::size_t i = 0; i < n; ++i)
+            if (t.members[i].base && i != primary) base_order.push_back(i);
+
+        bool prev_base_ends_empty = false;
+        for (std::size_t k = 0; k < base_order.size(); ++k) {
+            const std::size_t i = base_order[k];
+            const AbiType& bt = (*types_)[t.members[i].type];
+            const AbiLayout& bl = layout(t.members[i].type);
+            std::size_t off;
+            if (bt.empty && itanium) {
+                off = place_empty(out.empties, bl, c.data_size(), bl.align);
+                size_floor = std::max(size_floor, off + bl.size);
+            } else if (bt.empty) {
+                std::size_t size = c.data_size();
+                if (prev_base_ends_empty && bl.leads_with_empty) ++size;
+                off = align_up(size, bl.align);
+                c.bits = off * 8;
+            } else {
+                off = align_up(c.data_size(), bl.align);
+                if (itanium) off = avoid_conflicts(out.empties, bl.empties, off, bl.align);
+                const bool reuse = model_.reuse_tail_padding && !bt.pod_for_layout;
+                c.bits = (off + (reuse ? bl.data_size : bl.size)) * 8;
+                size_floor = std::max(size_floor, off + bl.size);
+            }
+            if (k == 0) out.leads_with_empty = bt.empty || bl.leads_with_empty;
+            prev_base_ends_empty = bt.empty || bl.ends_with_empty;
+            align = std::max(align, bl.align);
+            add_empties(out.empties, bl.empties, off);
+            offsets[i] = off;
+        }
+
+        bool has_fields = false;
+        for (std::size_t i = 0; i < n; ++i) {
+            const AbiMember& m = t.members[i];
+            if (m.base) continue;
+            has_fields = true;
+            const AbiType& ft = (*types_)[m.type];
+            const AbiLayout& fl = layout(m.type);
+            if (m.bit_field) {
+                bit_offsets[i] = place_bitfield(c, fl, m.bit_width, align);
+                offsets[i] = bit_offsets[i] / 8;
+                continue;
+            }
+            c.close_unit();
+            const std::size_t a = std::max(fl.align, m.explicit_align);
+            const std::size_t data = c.data_size();
+            const bool empty_record = ft.kind == AbiTypeKind::Record && ft.empty;
+            bool overlap = m.overlapping && model_.no_unique_address;
+            if (calibrating_ && empty_record && model_.no_unique_address) {
+                // [[no_unique_address]] is not reflected: an empty member at
+                // an offset only it could have carries the attribute.
+                std::size_t plain = align_up(data, a);
+                if (itanium) plain = avoid_conflicts(out.empties, fl.empties, plain, a);
+                const std::size_t shared = place_empty(out.empties, fl, data, a);
+                overlap = m.host_offset == shared && shared != plain;
+                (*calibrating_)[id].members[i].overlapping = overlap;
+            }
+            std::size_t off;
+            if (empty_record && overlap) {
+                off = place_empty(out.empties, fl, data, a);
+                size_floor = std::max(size_floor, off + fl.size);
+            } else {
+                off = align_up(data, a);
+                if (itanium) off = avoid_conflicts(out.empties, fl.empties, off, a);
+                const bool reuse = overlap && model_.reuse_tail_padding &&
+                                   ft.kind == AbiTypeKind::Record && !ft.pod_for_layout;
+                c.bits = (off + (reuse ? fl.data_size : fl.size)) * 8;
+                size_floor = std::max(size_floor, off + fl.size);
+            }
+            align = std::max(align, a);
+            add_empties(out.empties, fl.empties, off);
+            offsets[i] = off;
+        }
+        c.close_unit();
+        if (has_fields) out.ends_with_empty = false;
+        else out.ends_with_empty = prev_base_ends_empty;
+
+        if (calibrating_ && t.host_align > align)
+            (*calibrating_)[id].explicit_align = t.host_align;
+        align = std::max(align, t.explicit_align);
+
+        out.data_size = c.data_size();
+        const std::size_t size = std::max<std::size_t>({out.data_size, size_floor, 1});
+        out.size = align_up(size, align);
+        out.align = align;
+        if (t.empty) {
+            out.empties.insert(out.empties.begin(), AbiEmptySubobject{id, 0});
+            out.leads_with_empty = out.ends_with_empty = true;
+        }
+
+        // Signature: bases, then fields, in declaration order.
+        for (std::size_t i = 0; i < n; ++i) {
+            const AbiMember& m = t.members[i];
+            const AbiType& ft = (*types_)[m.type];
+            const AbiLayout& fl = layout(m.type);
+            if (m.bit_field) {
+                out.fields.push_back({bit_offsets[i] / 8,
+                    "." + std::to_string(bit_offsets[i] % 8) + ":bits<" +
+                    std::to_string(m.bit_width) + "," + fl.signature + ">"});
+            } else if (ft.kind == AbiTypeKind::Record && !ft.empty) {
+                for (const auto& f : fl.fields)
+                    out.fields.push_back({f.offset + offsets[i], f.tail});
+            } else if (ft.kind == AbiTypeKind::Record) {
+                out.fields.push_back({offsets[i],
+                    ":" + record_signature(0, fl.align, false, fl.fields)});
+            } else {
+                out.fields.push_back({offsets[i], ":" + fl.signature});
+            }
+        }
+        out.signature = record_signature(out.size, out.align, t.polymorphic, out.fields);
+    }
+
+    void layout_union(std::uint32_t id, AbiLayout& out) {
+        const AbiType& t = (*types_)[id];
+        std::size_t size = 0;
+        std::size_t align = 1;
+        std::string body;
+        for (std::size_t i = 0; i < t.members.size(); ++i) {
+            const AbiMember& m = t.members[i];
+            const AbiLayout& fl = layout(m.type);
+            if (i) body += ',';
+            if (m.bit_field) {
+                const std::size_t bytes = model_.bitfield_rule == AbiBitfieldRule::msvc
+                    ? fl.size : (m.bit_width + 7) / 8;
+                size = std::max(size, bytes);
+                if (m.bit_width) align = std::max(align, fl.align);
+                body += "@0.0:bits<" + std::to_string(m.bit_width) + "," + fl.signature + ">";
+            } else {
+                size = std::max(size, fl.size);
+                align = std::max({align, fl.align, m.explicit_align});
+                add_empties(out.empties, fl.empties, 0);
+                body += "@0:" + fl.signature;
+            }
+        }
+        if (calibrating_ && t.host_align > align)
+            (*calibrating_)[id].explicit_align = t.host_align;
+        align = std::max(align, t.explicit_align);
+        out.size = align_up(std::max<std::size_t>(size, 1), align);
+        out.align = align;
+        out.data_size = out.size;
+        out.signature = "union" + params(out.size, out.align) + "{" + body + "}";
+    }
+};
+
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_TOOLS_ABI_LAYOUT_HPP
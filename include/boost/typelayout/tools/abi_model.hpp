@@ -0,0 +1,183 @@
+// AbiModel -- a declared target ABI: what AbiLayoutEngine needs to lay a
+// type out the way a foreign compiler would, without that compiler.
+//
+//   - primitive sizes and alignments (pointers, long, long long, double,
+//     wchar_t, long double and its representation tag)
+//   - record rules: bit-field allocation, empty-base placement, tail
+//     padding reuse, [[no_unique_address]]
+//   - the platform metadata written into an exported .sig.hpp
+//
+// The presets in abi_models[] are named like platform::get_platform_name()
+// ("{arch}_{os}_{compiler}"), so a predicted export lands in the file the
+// native export on that platform would write.  host_abi_model() describes
+// the compiler in use; AbiEmulator uses it to check that a type's layout is
+// reproduced before predicting it elsewhere.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_ABI_MODEL_HPP
+#define BOOST_TYPELAYOUT_TOOLS_ABI_MODEL_HPP
+
+#include <boost/typelayout/config.hpp>
+#include <boost/typelayout/tools/platform_detect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+
+/// How consecutive bit-fields share storage.
+enum class AbiBitfieldRule : std::uint8_t {
+    itanium,   // SysV / AAPCS: a bit-field goes at the next free bit unless it
+               // would straddle a unit of its declared type; types may mix
+    msvc,      // Microsoft: a run of same-sized declared types shares one
+               // unit; a different size or a full unit starts a new one
+};
+
+/// Where empty base classes go.
+enum class AbiEmptyBaseRule : std::uint8_t {
+    itanium,   // offset 0 (or the first offset free of a same-type empty
+               // subobject); occupies no storage
+    msvc,      // occupies no storage, but an empty base that directly
+               // follows another one is pushed one byte further
+};
+
+/// A target ABI.  Sizes and alignments are in bytes.
+struct AbiModel {
+    const char*      platform_name;        // e.g. "x86_64_windows_msvc"
+    const char*      display_name;         // e.g. "x86-64 Windows (MSVC)"
+    const char*      data_model;           // "LP64", "LLP64", "ILP32", ...
+    bool             big_endian;
+    std::size_t      pointer_size;         // also ptr/ref/fnptr/nullptr alignment
+    std::size_t      sizeof_long;          // alignment equals size
+    std::size_t      int64_align;          // long long, [u]int64_t in records
+    std::size_t      double_align;         // double in records
+    std::size_t      sizeof_wchar_t;       // alignment equals size
+    std::size_t      sizeof_long_double;
+    std::size_t      long_double_align;
+    const char*      long_double_tag;      // "fld64", "fld80", "fld106", "fld128"
+    std::size_t      member_data_ptr_size; // T C::*
+    std::size_t      member_fn_ptr_size;   // R (C::*)(Args...)
+    std::size_t      max_align;            // alignof(std::max_align_t)
+    AbiBitfieldRule  bitfield_rule;
+    AbiEmptyBaseRule empty_base_rule;
+    bool             reuse_tail_padding;   // Itanium: non-POD bases' tail padding
+    bool             no_unique_address;    // honours [[no_unique_address]]
+
+    /// The signature arch prefix, e.g. "[64-le]".
+    constexpr std::string_view arch_prefix() const noexcept {
+        if (pointer_size == 8) return big_endian ? "[64-be]" : "[64-le]";
+        return big_endian ? "[32-be]" : "[32-le]";
+    }
+};
+
+namespace abi {
+
+inline constexpr AbiModel x86_64_linux_gcc{
+    "x86_64_linux_gcc", "x86-64 Linux (GCC)", "LP64", false,
+    8, 8, 8, 8, 4, 16, 16, "fld80", 8, 16, 16,
+    AbiBitfieldRule::itanium, AbiEmptyBaseRule::itanium, true, true};
+
+inline constexpr AbiModel x86_64_linux_clang{
+    "x86_64_linux_clang", "x86-64 Linux (Clang)", "LP64", false,
+    8, 8, 8, 8, 4, 16, 16, "fld80", 8, 16, 16,
+    AbiBitfieldRule::itanium, AbiEmptyBaseRule::itanium, true, true};
+
+inline constexpr AbiModel arm64_linux_gcc{
+    "arm64_linux_gcc", "AArch64 Linux (GCC)", "LP64", false,
+    8, 8, 8, 8, 4, 16, 16, "fld128", 8, 16, 16,
+    AbiBitfieldRule::itanium, AbiEmptyBaseRule::itanium, true, true};
+
+inline constexpr AbiModel arm64_linux_clang{
+    "arm64_linux_clang", "AArch64 Linux (Clang)", "LP64", false,
+    8, 8, 8, 8, 4, 16, 16, "fld128", 8, 16, 16,
+    AbiBitfieldRule::itanium, AbiEmptyBaseRule::itanium, true, true};
+
+// Apple arm64: long double is double, and max_align_t is 8.
+inline constexpr AbiModel arm64_macos_clang{
+    "arm64_macos_clang", "AArch64 macOS (Clang)", "LP64", false,
+    8, 8, 8, 8, 4, 8, 8, "fld64", 8, 16, 8,
+    AbiBitfieldRule::itanium, AbiEmptyBaseRule::itanium, true, true};
+
+// Single-inheritance member pointers; MSVC ignores [[no_unique_address]]
+// (it has [[msvc::no_unique_address]]) and never reuses tail padding.
+inline constexpr AbiModel x86_64_windows_msvc{
+    "x86_64_windows_msvc", "x86-64 Windows (MSVC)", "LLP64", false,
+    8, 4, 8, 8, 2, 8, 8, "fld64", 4, 8, 8,
+    AbiBitfieldRule::msvc, AbiEmptyBaseRule::msvc, false, false};
+
+inline constexpr AbiModel arm64_windows_msvc{
+    "arm64_windows_msvc", "AArch64 Windows (MSVC)", "LLP64", false,
+    8, 4, 8, 8, 2, 8, 8, "fld64", 4, 8, 8,
+    AbiBitfieldRule::msvc, AbiEmptyBaseRule::msvc, false, false};
+
+// MinGW-w64: LLP64 and MS bit-fields (-mms-bitfields), Itanium C++ layout.
+inline constexpr AbiModel x86_64_windows_gcc{
+    "x86_64_windows_gcc", "x86-64 Windows (GCC)", "LLP64", false,
+    8, 4, 8, 8, 2, 16, 16, "fld80", 8, 16, 16,
+    AbiBitfieldRule::msvc, AbiEmptyBaseRule::itanium, true, true};
+
+// 32-bit ARM EABI (hard float): 8-byte long long and double alignment.
+inline constexpr AbiModel arm_linux_gcc{
+    "arm_linux_gcc", "ARM Linux (GCC)", "ILP32", false,
+    4, 4, 8, 8, 4, 8, 8, "fld64", 4, 8, 8,
+    AbiBitfieldRule::itanium, AbiEmptyBaseRule::itanium, true, true};
+
+} // namespace abi
+
+/// The built-in target models.
+inline constexpr AbiModel abi_models[] = {
+    abi::x86_64_linux_gcc,   abi::x86_64_linux_clang,  abi::arm64_linux_gcc,
+    abi::arm64_linux_clang,  abi::arm64_macos_clang,   abi::x86_64_windows_msvc,
+    abi::arm64_windows_msvc, abi::x86_64_windows_gcc,  abi::arm_linux_gcc,
+};
+
+/// The built-in model named `platform_name`, or nullptr.
+constexpr const AbiModel* find_abi_model(std::string_view platform_name) noexcept {
+    for (const AbiModel& m : abi_models)
+        if (platform_name == m.platform_name) return &m;
+    return nullptr;
+}
+
+/// The compiler in use, from sizeof/alignof and the platform macros.
+inline AbiModel host_abi_model() noexcept {
+    struct fn_holder { void f(); };
+#if defined(_MSC_VER)
+    constexpr bool msvc = true;           // MSVC and clang-cl
+#else
+    constexpr bool msvc = false;
+#endif
+#if defined(_WIN32)
+    constexpr bool ms_bitfields = true;   // MSVC, clang-cl and MinGW
+#else
+    constexpr bool ms_bitfields = false;
+#endif
+    struct int64_in_record { char c; long long v; };
+    struct double_in_record { char c; double v; };
+    static const std::string name = platform::get_platform_name();
+    static const std::string display = platform::get_platform_display_name();
+    return {
+        name.c_str(), display.c_str(), platform::get_data_model(),
+        !TYPELAYOUT_LITTLE_ENDIAN,
+        sizeof(void*), sizeof(long),
+        offsetof(int64_in_record, v), offsetof(double_in_record, v),
+        sizeof(wchar_t), sizeof(long double), alignof(long double),
+        BOOST_TYPELAYOUT_LONG_DOUBLE_TAG,
+        sizeof(int fn_holder::*), sizeof(void (fn_holder::*)()),
+        alignof(std::max_align_t),
+        ms_bitfields ? AbiBitfieldRule::msvc : AbiBitfieldRule::itanium,
+        msvc ? AbiEmptyBaseRule::msvc : AbiEmptyBaseRule::itanium,
+        !msvc, !msvc,
+    };
+}
+
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_TOOLS_ABI_MODEL_HPP
@@ -8,58 +8,281 @@
 #define BOOST_TYPELAYOUT_TOOLS_COMPAT_AUTO_HPP
 
 #include <boost/typelayout/tools/compat_check.hpp>
+#include <boost/typelayout/tools/compat_report.hpp>
 #include <boost/typelayout/tools/detail/foreach.hpp>
 
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace boost {
+namespace typelayout {
+namespace compat {
+namespace detail {
+
+inline bool parse_thread_count(std::string_view s, unsigned& out) noexcept {
+    if (s == "auto") { out = 0; return true; }
+    unsigned n = 0;
+    auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), n);
+    if (ec != std::errc{} || end != s.data() + s.size()) return false;
+    out = n;
+    return true;
+}
+
+/// Value of `--flag=V` or `--flag V` (the last one wins) on the command
+/// line, else of environment variable `env`, else nullptr.  `source` names
+/// where the value came from, for diagnostics.
+inline const char* compat_option(int argc, char* argv[], std::string_view flag,
+                                 const char* env, const char*& source) {
+    const char* value = nullptr;
+    source = env;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg.size() > flag.size() && arg.substr(0, flag.size()) == flag &&
+            arg[flag.size()] == '=') {
+            value = argv[i] + flag.size() + 1;
+            source = argv[i];
+        } else if (arg == flag && i + 1 < argc) {
+            value = argv[++i];
+            source = argv[i - 1];
+        }
+    }
+    if (!value) value = std::getenv(env);
+    return value;
+}
+
+/// Thread count for TYPELAYOUT_CHECK_COMPAT: `--threads=N` or
+/// `--threads N` on the command line, else the TYPELAYOUT_COMPAT_THREADS
+/// environment variable, else 1.  N = 0 or "auto" uses every hardware
+/// thread.  Invalid values are reported on stderr and ignored.
+inline unsigned compat_threads_option(int argc, char* argv[]) {
+    unsigned threads = 1;
+    const char* source = nullptr;
+    const char* value = compat_option(argc, argv, "--threads",
+                                      "TYPELAYOUT_COMPAT_THREADS", source);
+    if (value && *value && !parse_thread_count(value, threads)) {
+        std::cerr << "TypeLayout: ignoring invalid " << source << " value '"
+                  << value << "'\n";
+        threads = 1;
+    }
+    return threads;
+}
+
+/// Result cache file for TYPELAYOUT_CHECK_COMPAT: `--cache=PATH` or
+/// `--cache PATH`, else TYPELAYOUT_COMPAT_CACHE; nullptr (no cache) when
+/// neither is set or the path is empty.
+inline const char* compat_cache_option(int argc, char* argv[]) {
+    const char* source = nullptr;
+    const char* value = compat_option(argc, argv, "--cache",
+                                      "TYPELAYOUT_COMPAT_CACHE", source);
+    return value && *value ? value : nullptr;
+}
+
+/// Report format for TYPELAYOUT_CHECK_COMPAT: `--format=F` or
+/// `--format F`, else TYPELAYOUT_COMPAT_FORMAT, else text.  F is one of
+/// text, jsonl, junit, sarif; invalid values are reported on stderr and
+/// ignored.
+inline ReportFormat compat_format_option(int argc, char* argv[]) {
+    ReportFormat format = ReportFormat::text;
+    const char* source = nullptr;
+    const char* value = compat_option(argc, argv, "--format",
+                                      "TYPELAYOUT_COMPAT_FORMAT", source);
+    if (value && *value && !parse_report_format(value, format)) {
+        std::cerr << "TypeLayout: ignoring invalid " << source << " value '"
+                  << value << "'\n";
+        format = ReportFormat::text;
+    }
+    return format;
+}
+
+} // namespace detail
+} // namespace compat
+} // namespace typelayout
+} // namespace boost
+
 // Generates main() that prints a compatibility report and returns non-zero
 // when a compared type has a layout mismatch or fails exported
-// transport-precondition checks.
+// transport-precondition checks.  Comparison runs on the thread count
+// given by compat_threads_option(); the report does not depend on it.
+// With compat_cache_option() set, unchanged types are replayed from the
+// cache file and the file is rewritten after the run.  The report and the
+// exit status come from one comparison; compat_format_option() selects a
+// streamed machine-readable report instead of the text one.
 
 #define TYPELAYOUT_DETAIL_ADD_PLATFORM(ns)                              \
     reporter.add_platform(                                              \
         ::boost::typelayout::platform::ns::get_platform_info());
 
 #define TYPELAYOUT_CHECK_COMPAT(...)                                    \
-    int main() {                                                        \
+    int main(int argc, char* argv[]) {                                  \
         ::boost::typelayout::compat::CompatReporter reporter;           \
+        reporter.set_threads(                                           \
+            ::boost::typelayout::compat::detail::compat_threads_option( \
+                argc, argv));                                           \
+        if (const char* cache =                                         \
+                ::boost::typelayout::compat::detail::                   \
+                    compat_cache_option(argc, argv))                    \
+            reporter.set_cache_file(cache);                             \
         TYPELAYOUT_DETAIL_FOR_EACH(TYPELAYOUT_DETAIL_ADD_PLATFORM,      \
                                    __VA_ARGS__)                         \
-        reporter.print_report();                                        \
-        return reporter.all_types_transfer_safe() ? 0 : 1;              \
+        const bool safe = ::boost::typelayout::compat::write_report(    \
+            reporter, std::cout,                                        \
+            ::boost::typelayout::compat::detail::compat_format_option(  \
+                argc, argv));                                           \
+        reporter.save_cache();                                          \
+        return safe ? 0 : 1;                                            \
     }
 
 // static_assert that all types match across listed platforms.
+//
+// Types are paired by name with a merge-join, so platforms may export
+// different type lists in different orders; a type exported by only one
+// platform is a mismatch.  Exporters write the type registry sorted by
+// name, which the join walks directly; an unsorted registry (an older or
+// hand-written header) is joined through a sorted index.  Layouts compare
+// by hash, and a hash mismatch is confirmed by comparing the signatures
+// when both platforms have them.
+//
+// A platform exported with a hash header (SigExporter::set_hash_header)
+// is read through its get_hash_info(), so the assert needs only
+// <platform>.sighash.hpp and never parses a signature string; otherwise
+// through get_platform_info().
+//
+// On failure the first offending type is passed as a template argument to
+// layout_mismatch_check, whose own static_assert puts the type's name into
+// the "in instantiation of" note of the diagnostic.
 
 namespace boost {
 namespace typelayout {
 namespace compat {
 namespace detail {
 
+enum class MismatchKind : unsigned char {
+    none,
+    differs,        // exported by both platforms with different layouts
+    only_in_first,  // exported by the first platform only
+    only_in_second  // exported by the second platform only
+};
+
+/// First type on which two platforms disagree.  A structural type, so it
+/// can be a template argument; names longer than the buffer are truncated.
+struct LayoutMismatch {
+    char         type[128] = {};
+    MismatchKind kind      = MismatchKind::none;
+
+    constexpr bool empty() const noexcept { return kind == MismatchKind::none; }
+};
+
+constexpr LayoutMismatch make_layout_mismatch(const char* name, MismatchKind kind) {
+    LayoutMismatch m;
+    std::size_t n = 0;
+    for (; name[n] != '\0' && n + 1 < sizeof(m.type); ++n) m.type[n] = name[n];
+    m.kind = kind;
+    return m;
+}
+
+/// A platform's type registry in name order.  Holds an index only when the
+/// registry is not already sorted.
+class NameOrderedTypes {
+public:
+    constexpr explicit NameOrderedTypes(const PlatformInfo& p) : p_(p) {
+        bool sorted = true;
+        for (std::size_t i = 1; i < p.type_count && sorted; ++i)
+            sorted = name(p.types[i - 1]) < name(p.types[i]);
+        if (sorted) return;
+        order_.resize(p.type_count);
+        for (std::size_t i = 0; i < p.type_count; ++i) order_[i] = i;
+        std::sort(order_.begin(), order_.end(), [&p](std::size_t x, std::size_t y) {
+            return name(p.types[x]) < name(p.types[y]);
+        });
+    }
+
+    constexpr std::size_t size() const noexcept { return p_.type_count; }
+
+    constexpr const TypeEntry& operator[](std::size_t i) const {
+        return p_.types[order_.empty() ? i : order_[i]];
+    }
+
+    static constexpr std::string_view name(const TypeEntry& e) { return e.name; }
+
+private:
+    const PlatformInfo&      p_;
+    std::vector<std::size_t> order_;
+};
+
+constexpr LayoutMismatch first_layout_mismatch(const PlatformInfo& a,
+                                               const PlatformInfo& b) {
+    NameOrderedTypes x(a), y(b);
+    std::size_t i = 0, j = 0;
+    while (i < x.size() || j < y.size()) {
+        if (j == y.size() ||
+            (i < x.size() && NameOrderedTypes::name(x[i]) < NameOrderedTypes::name(y[j])))
+            return make_layout_mismatch(x[i].name, MismatchKind::only_in_first);
+        if (i == x.size() || NameOrderedTypes::name(y[j]) < NameOrderedTypes::name(x[i]))
+            return make_layout_mismatch(y[j].name, MismatchKind::only_in_second);
+        if (!same_layout(x[i], y[j]) &&
+            !(x[i].layout_sig && y[j].layout_sig &&
+              layout_match(x[i].layout_sig, y[j].layout_sig)))
+            return make_layout_mismatch(x[i].name, MismatchKind::differs);
+        ++i;
+        ++j;
+    }
+    return {};
+}
+
 inline constexpr bool all_layouts_match(const PlatformInfo& a,
                                         const PlatformInfo& b) {
-    if (a.type_count != b.type_count) return false;
-    for (std::size_t i = 0; i < a.type_count; ++i) {
-        const char* sa = a.types[i].layout_sig;
-        const char* sb = b.types[i].layout_sig;
-        int j = 0;
-        while (sa[j] != '\0' && sb[j] != '\0') {
-            if (sa[j] != sb[j]) return false;
-            ++j;
-        }
-        if (sa[j] != sb[j]) return false;
-    }
-    return true;
+    return first_layout_mismatch(a, b).empty();
 }
 
+// Fallbacks found by TYPELAYOUT_DETAIL_ASSERT_INFO's unqualified lookup
+// when a platform namespace lacks get_hash_info() or get_platform_info();
+// as templates they lose overload resolution to the generated functions.
+namespace assert_lookup {
+struct absent {};
+template <int = 0> constexpr absent get_hash_info() noexcept { return {}; }
+template <int = 0> constexpr absent get_platform_info() noexcept { return {}; }
+} // namespace assert_lookup
+
+template <typename Full>
+constexpr PlatformInfo assert_platform_info(const PlatformInfo& hashes, const Full&) {
+    return hashes;
+}
+
+constexpr PlatformInfo assert_platform_info(assert_lookup::absent, const PlatformInfo& full) {
+    return full;
+}
+
+template <LayoutMismatch Mismatch>
+struct layout_mismatch_check {
+    static_assert(Mismatch.empty(),
+        "TypeLayout: layout mismatch in the type named by this template argument");
+    static constexpr bool value = Mismatch.empty();
+};
+
 } // namespace detail
 } // namespace compat
 } // namespace typelayout
 } // namespace boost
 
+#define TYPELAYOUT_DETAIL_ASSERT_INFO(ns)                                        \
+    [] {                                                                         \
+        using namespace ::boost::typelayout::compat::detail::assert_lookup;      \
+        using namespace ::boost::typelayout::platform::ns;                       \
+        return ::boost::typelayout::compat::detail::assert_platform_info(        \
+            get_hash_info(), get_platform_info());                               \
+    }()
+
 #define TYPELAYOUT_DETAIL_ASSERT_PAIR(ref, other)                               \
     static_assert(                                                               \
-        ::boost::typelayout::compat::detail::all_layouts_match(                  \
-            ::boost::typelayout::platform::ref::get_platform_info(),             \
-            ::boost::typelayout::platform::other::get_platform_info()),          \
+        ::boost::typelayout::compat::detail::layout_mismatch_check<              \
+            ::boost::typelayout::compat::detail::first_layout_mismatch(          \
+                TYPELAYOUT_DETAIL_ASSERT_INFO(ref),                              \
+                TYPELAYOUT_DETAIL_ASSERT_INFO(other))>::value,                   \
         "TypeLayout: layout mismatch between " #ref " and " #other);
 
 // Reuses FOR_EACH_CTX from foreach.hpp; supports up to 32 platforms.
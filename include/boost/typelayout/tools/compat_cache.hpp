@@ -0,0 +1,387 @@
+// compat_cache.hpp -- Persistent per-type results for CompatReporter.
+//
+// A CI job usually re-checks the same types against the same platforms,
+// with only a few layouts changed since the previous run.  CompatCache
+// stores, for each compared type, the key it was compared under -- a
+// 64-bit FNV-1a digest of the type's layout hash, byte-copy flag and entry
+// kind (full signature or hash only) on every platform, in platform
+// order -- together with the verdict (layout
+// match, byte-copy safety, safety level) and the rendered DIFFER
+// sections.  When a later run sees the same key, CompatReporter replays
+// the stored result instead of comparing, classifying and diffing the
+// signatures again.
+//
+// The cache is bound to the ordered list of platform names; a different
+// list discards it.  It is also bound to the file format and library
+// version (BOOST_TYPELAYOUT_VERSION), which seed every key: a file written
+// by another version is discarded, since its verdicts and DIFFER text may
+// come from different rules.  Types with an unexported layout hash (0) are
+// never replayed, and neither is a type whose entry on some platform
+// changed between signature and hash only: DIFFER text quotes the
+// signatures.  A missing, unreadable or corrupt file is treated as empty.
+//
+// CompatReporter fills the current run's slots from its const reporting
+// functions.  Within one call each worker writes only its own slots, but
+// two reporting calls on the same reporter must not run concurrently
+// while a cache file is set.
+//
+// File format (text, version 3):
+//
+//   typelayout-compat-cache 3 <library version>\n
+//   <P>\n  then P lines  <len>:<platform name>\n
+//   <T>\n  then T records:
+//   <len>:<name> <match><copy><level> <key> <d0> <d1>\n
+//   <DIFFER text, plain><DIFFER text, with diff annotations>
+//
+// <match>/<copy> are 0/1, <level> is the SafetyLevel value, <key> is hex,
+// and <d0>/<d1> are text lengths or '-' when not rendered.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_COMPAT_CACHE_HPP
+#define BOOST_TYPELAYOUT_TOOLS_COMPAT_CACHE_HPP
+
+#include <boost/typelayout/config.hpp>
+#include <boost/typelayout/detail/layout_hash.hpp>
+#include <boost/typelayout/tools/safety_level.hpp>
+#include <boost/typelayout/tools/detail/name_index.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace compat {
+namespace detail {
+
+/// Folds one platform's entry into a cache key: its layout hash and
+/// state ('s' byte-copy safe, 'u' not, 'S'/'U' the same for a hash-only
+/// entry, '-' missing).  FNV-1a steps over whole words: the inputs are
+/// hashes already.
+constexpr std::uint64_t cache_key_step(std::uint64_t key, std::uint64_t layout_hash,
+                                       char state) noexcept {
+    key = (key ^ layout_hash) * typelayout::detail::fnv1a_64_prime;
+    key = (key ^ static_cast<unsigned char>(state)) * typelayout::detail::fnv1a_64_prime;
+    return key;
+}
+
+inline constexpr std::uint64_t cache_format_version = 3;
+inline constexpr std::uint64_t cache_library_version = BOOST_TYPELAYOUT_VERSION;
+
+/// Initial key: the format and library versions, so that no key computed
+/// by another version can match.
+inline constexpr std::uint64_t cache_key_basis =
+    cache_key_step(typelayout::detail::fnv1a_64_offset_basis,
+                   cache_format_version << 32 | cache_library_version, 'v');
+
+/// One type as loaded from a cache file: its comparison key and result.
+struct CachedResult {
+    std::string   name;
+    std::uint64_t key            = 0;
+    bool          layout_match   = false;
+    bool          byte_copy_safe = false;
+    SafetyLevel   safety         = SafetyLevel::TrivialSafe;
+    bool          has_differ[2]  = {false, false};
+    std::string   differ[2];     // [0] plain, [1] with diff
+};
+
+/// One type's result in the current run, index-aligned with the
+/// reporter's comparison.  On a cache hit `replayed` points at the loaded
+/// entry, whose DIFFER texts are reused rather than copied.
+struct CacheSlot {
+    std::string_view    name;
+    std::uint64_t       key            = 0;
+    bool                layout_match   = false;
+    bool                byte_copy_safe = false;
+    SafetyLevel         safety         = SafetyLevel::TrivialSafe;
+    const CachedResult* replayed       = nullptr;
+    bool                has_differ[2]  = {false, false};
+    std::string         differ[2];     // rendered in this run
+
+    const std::string* text(int mode) const noexcept {
+        if (has_differ[mode]) return &differ[mode];
+        if (replayed && replayed->has_differ[mode]) return &replayed->differ[mode];
+        return nullptr;
+    }
+};
+
+class CompatCache {
+    struct NameAt {
+        const std::vector<CachedResult>* entries;
+        std::string_view operator()(std::size_t i) const {
+            return (*entries)[i].name;
+        }
+    };
+    NameAt name_at() const noexcept { return {&entries_}; }
+
+public:
+    static constexpr std::string_view magic = "typelayout-compat-cache";
+
+    /// Replaces the contents with `path`; false (and empty) when the file
+    /// is missing, malformed or written by another format or library
+    /// version.
+    bool load(const std::string& path) {
+        clear();
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        std::string data((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+        Reader r{data};
+        if (!parse(r)) {
+            clear();
+            return false;
+        }
+        return true;
+    }
+
+    /// Writes the current run's slots -- or, before any comparison, the
+    /// loaded entries -- to `path`, through a temporary file so readers
+    /// never see a partial cache.
+    bool save(const std::string& path) const {
+        std::string out;
+        out += magic;
+        out += ' ';
+        append_uint(out, cache_format_version);
+        out += ' ';
+        append_uint(out, cache_library_version);
+        out += '\n';
+        append_uint(out, platforms_.size());
+        out += '\n';
+        for (const auto& p : platforms_) {
+            append_string(out, p);
+            out += '\n';
+        }
+        if (has_slots_) {
+            append_uint(out, slots_.size());
+            out += '\n';
+            for (const auto& s : slots_)
+                append_record(out, s.name, s.key, s.layout_match, s.byte_copy_safe,
+                              s.safety, s.text(0), s.text(1));
+        } else {
+            append_uint(out, entries_.size());
+            out += '\n';
+            for (const auto& e : entries_)
+                append_record(out, e.name, e.key, e.layout_match, e.byte_copy_safe,
+                              e.safety, e.has_differ[0] ? &e.differ[0] : nullptr,
+                              e.has_differ[1] ? &e.differ[1] : nullptr);
+        }
+
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+            if (!f) return false;
+            f.write(out.data(), static_cast<std::streamsize>(out.size()));
+            if (!f) return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    void clear() {
+        platforms_.clear();
+        entries_.clear();
+        index_.reserve(0);
+        slots_.clear();
+        has_slots_ = false;
+    }
+
+    /// Keeps the loaded entries only if they were built for exactly `names`.
+    void bind_platforms(const std::vector<std::string>& names) {
+        if (names != platforms_) {
+            clear();
+            platforms_ = names;
+        }
+    }
+
+    /// Loaded entry for `name`, or nullptr.
+    const CachedResult* find(std::string_view name, std::uint64_t hash) const {
+        std::size_t i = index_.find(name, hash, name_at());
+        return i == NameIndex::npos ? nullptr : &entries_[i];
+    }
+
+    /// Results of the current run; replaces those of the previous one.
+    void set_slots(std::vector<CacheSlot> slots) {
+        slots_ = std::move(slots);
+        has_slots_ = true;
+    }
+
+    CacheSlot&       slot(std::size_t i) { return slots_[i]; }
+    const CacheSlot& slot(std::size_t i) const { return slots_[i]; }
+
+private:
+    std::vector<std::string>  platforms_;
+    std::vector<CachedResult> entries_;     // as loaded; never modified
+    NameIndex                 index_;
+    std::vector<CacheSlot>    slots_;
+    bool                      has_slots_ = false;
+
+    void rebuild_index() {
+        index_.reserve(entries_.size());
+        for (std::size_t i = 0; i < entries_.size(); ++i) {
+            std::string_view n(entries_[i].name);
+            index_.insert(n, name_hash(n), i, name_at());
+        }
+    }
+
+    // ---- Writing -------------------------------------------------------
+
+    static void append_uint(std::string& out, std::size_t v) {
+        char buf[24];
+        auto res = std::to_chars(buf, buf + sizeof(buf), v);
+        out.append(buf, res.ptr);
+    }
+
+    static void append_hex(std::string& out, std::uint64_t v) {
+        char buf[20];
+        auto res = std::to_chars(buf, buf + sizeof(buf), v, 16);
+        out.append(buf, res.ptr);
+    }
+
+    static void append_string(std::string& out, std::string_view s) {
+        append_uint(out, s.size());
+        out += ':';
+        out += s;
+    }
+
+    static void append_record(std::string& out, std::string_view name,
+                              std::uint64_t key, bool layout_match,
+                              bool byte_copy_safe, SafetyLevel safety,
+                              const std::string* plain, const std::string* diff) {
+        append_string(out, name);
+        out += ' ';
+        out += layout_match ? '1' : '0';
+        out += byte_copy_safe ? '1' : '0';
+        append_uint(out, static_cast<std::size_t>(safety));
+        out += ' ';
+        append_hex(out, key);
+        for (const std::string* text : {plain, diff}) {
+            out += ' ';
+            if (text) append_uint(out, text->size());
+            else out += '-';
+        }
+        out += '\n';
+        if (plain) out += *plain;
+        if (diff) out += *diff;
+    }
+
+    // ---- Reading -------------------------------------------------------
+
+    struct Reader {
+        std::string_view s;
+        std::size_t      pos = 0;
+
+        bool expect(char c) {
+            if (pos >= s.size() || s[pos] != c) return false;
+            ++pos;
+            return true;
+        }
+        bool peek(char c) const { return pos < s.size() && s[pos] == c; }
+        bool read_uint(std::size_t& v) {
+            auto [end, ec] = std::from_chars(s.data() + pos, s.data() + s.size(), v);
+            if (ec != std::errc{}) return false;
+            pos = static_cast<std::size_t>(end - s.data());
+            return true;
+        }
+        bool read_hash(std::uint64_t& v) {
+            auto [end, ec] = std::from_chars(s.data() + pos, s.data() + s.size(), v, 16);
+            if (ec != std::errc{}) return false;
+            pos = static_cast<std::size_t>(end - s.data());
+            return true;
+        }
+        bool read_bytes(std::size_t n, std::string& out) {
+            if (s.size() - pos < n) return false;
+            out.assign(s.substr(pos, n));
+            pos += n;
+            return true;
+        }
+        bool read_string(std::string& out) {
+            std::size_t n = 0;
+            return read_uint(n) && expect(':') && read_bytes(n, out);
+        }
+    };
+
+    bool parse(Reader& r) {
+        std::string head;
+        std::size_t format = 0, library = 0;
+        if (!r.read_bytes(magic.size(), head) || head != magic || !r.expect(' ') ||
+            !r.read_uint(format) || format != cache_format_version || !r.expect(' ') ||
+            !r.read_uint(library) || library != cache_library_version || !r.expect('\n'))
+            return false;
+
+        std::size_t pcount = 0;
+        if (!r.read_uint(pcount) || !r.expect('\n')) return false;
+        for (std::size_t i = 0; i < pcount; ++i) {
+            std::string name;
+            if (!r.read_string(name) || !r.expect('\n')) return false;
+            platforms_.push_back(std::move(name));
+        }
+
+        std::size_t tcount = 0;
+        if (!r.read_uint(tcount) || !r.expect('\n')) return false;
+        std::vector<CachedResult> entries;
+        entries.reserve(tcount < r.s.size() ? tcount : r.s.size());
+        for (std::size_t t = 0; t < tcount; ++t) {
+            CachedResult e;
+            std::size_t level = 0;
+            if (!r.read_string(e.name) || !r.expect(' ')) return false;
+            if (r.peek('1')) e.layout_match = r.expect('1');
+            else if (!r.expect('0')) return false;
+            if (r.peek('1')) e.byte_copy_safe = r.expect('1');
+            else if (!r.expect('0')) return false;
+            if (!r.read_uint(level) ||
+                level > static_cast<std::size_t>(SafetyLevel::Opaque) ||
+                !r.expect(' '))
+                return false;
+            e.safety = static_cast<SafetyLevel>(level);
+            if (!r.read_hash(e.key)) return false;
+            std::size_t len[2] = {0, 0};
+            for (int m = 0; m < 2; ++m) {
+                if (!r.expect(' ')) return false;
+                if (r.peek('-')) {
+                    r.expect('-');
+                } else {
+                    if (!r.read_uint(len[m])) return false;
+                    e.has_differ[m] = true;
+                }
+            }
+            if (!r.expect('\n')) return false;
+            for (int m = 0; m < 2; ++m)
+                if (!r.read_bytes(len[m], e.differ[m])) return false;
+            entries.push_back(std::move(e));
+        }
+        if (r.pos != r.s.size()) return false;
+
+        entries_ = std::move(entries);
+        rebuild_index();
+        // Duplicate names mean the file was not written by save().
+        for (std::size_t i = 0; i < entries_.size(); ++i) {
+            std::string_view n(entries_[i].name);
+            if (find(n, name_hash(n)) != &entries_[i]) return false;
+        }
+        return true;
+    }
+};
+
+} // namespace detail
+} // namespace compat
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_TOOLS_COMPAT_CACHE_HPP
@@ -1,8 +1,10 @@
 // Cross-platform compatibility checking (used in CI build steps).
 //
 // Public API:
-//   - layout_match(a, b)          -- constexpr signature comparison
+//   - layout_match(a, b)          -- constexpr signature / layout hash comparison
+//                                    (full and compact signatures mix freely)
 //   - CompatReporter              -- cross-platform compatibility report
+//                                    (.sig.hpp platforms or mapped .sigdb files)
 //
 // Copyright (c) 2024-2026 TypeLayout Development Team
 // Distributed under the Boost Software License, Version 1.0.
@@ -12,6 +14,13 @@
 
 #include <boost/typelayout/tools/sig_types.hpp>
 #include <boost/typelayout/tools/safety_level.hpp>
+#include <boost/typelayout/detail/layout_hash.hpp>
+#include <boost/typelayout/detail/sig_compact.hpp>
+#include <boost/typelayout/tools/compat_cache.hpp>
+#include <boost/typelayout/tools/sigdb.hpp>
+#include <boost/typelayout/tools/detail/myers_diff.hpp>
+#include <boost/typelayout/tools/detail/name_index.hpp>
+#include <boost/typelayout/tools/detail/parallel_for.hpp>
 
 #include <string_view>
 #include <string>
@@ -19,8 +28,11 @@
 #include <initializer_list>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
+#include <memory>
 
 namespace boost {
 namespace typelayout {
@@ -28,12 +40,39 @@ inline namespace v1 {
 namespace compat {
 
 /// Compare layout signatures. Usable in static_assert.
-constexpr bool layout_match(const char* a, const char* b) noexcept {
-    return std::string_view(a) == std::string_view(b);
+///
+/// Signatures in the same form compare directly (the compact form is
+/// canonical); a full and a compact signature compare after expansion.
+constexpr bool layout_match(const char* a, const char* b) {
+    std::string_view x(a), y(b);
+    if (is_compact_signature(x) == is_compact_signature(y)) return x == y;
+    return expand_signature(x) == expand_signature(y);
+}
+
+/// Compare layout hashes (get_layout_hash<T>() / <Name>_layout_hash).
+constexpr bool layout_match(std::uint64_t a, std::uint64_t b) noexcept {
+    return a == b;
 }
 
 namespace detail {
 
+/// Layout equality of two exported entries: O(1) when both carry a layout
+/// hash, signature comparison for headers exported without one.  Entries
+/// of a hash header (layout_sig null) compare by hash only.
+constexpr bool same_layout(const TypeEntry& a, const TypeEntry& b) {
+    if (a.layout_hash != 0 && b.layout_hash != 0)
+        return a.layout_hash == b.layout_hash;
+    if (!a.layout_sig || !b.layout_sig) return false;
+    return layout_match(a.layout_sig, b.layout_sig);
+}
+
+/// Full form of an exported signature, for display and field diffs.
+/// Malformed compact strings are kept as they are.
+inline std::string full_signature(std::string_view sig) {
+    std::string full = expand_signature(sig);
+    return full.empty() ? std::string(sig) : full;
+}
+
 inline const char* safety_stars(SafetyLevel level) noexcept {
     switch (level) {
         case SafetyLevel::TrivialSafe:     return "***";
@@ -61,62 +100,171 @@ struct SigField {
     std::string_view type_sig;
 };
 
-inline SigField make_sig_field(std::string_view seg) noexcept {
-    SigField f{seg, {}, {}};
-    if (!seg.empty() && seg[0] == '@') {
-        for (std::size_t j = 1; j < seg.size(); ++j) {
-            if (seg[j] == ':') {
-                f.offset = seg.substr(1, j - 1);
-                f.type_sig = seg.substr(j + 1);
-                break;
-            }
-        }
+using ::boost::typelayout::v1::detail::SigAst;
+using ::boost::typelayout::v1::detail::SigNode;
+using ::boost::typelayout::v1::detail::SigNodeKind;
+using ::boost::typelayout::v1::detail::sig_no_node;
+
+/// The outermost record/union of a signature: the root itself, or the
+/// element of a (nested) array/enum/opaque.  nullptr if there is none or
+/// the signature does not parse.
+inline const SigNode* sig_member_owner(const SigAst& ast) noexcept {
+    const SigNode* n = ast.root();
+    while (n && n->kind != SigNodeKind::Record && n->kind != SigNodeKind::Union)
+        n = (n->first_child == sig_no_node) ? nullptr : &ast.node(n->first_child);
+    return n;
+}
+
+/// Everything up to the member list of the outermost record/union (the
+/// whole string when there is none).
+inline std::string_view sig_header(const SigAst& ast) noexcept {
+    const SigNode* owner = sig_member_owner(ast);
+    if (!owner) return ast.signature();
+    return ast.signature().substr(0, owner->head_end);
+}
+
+/// Member list of the outermost record/union.
+inline std::vector<SigField> parse_sig_fields(const SigAst& ast) {
+    std::vector<SigField> fields;
+    const SigNode* owner = sig_member_owner(ast);
+    if (!owner) return fields;
+    fields.reserve(owner->child_count);
+    for (std::uint32_t i = owner->first_child; i != sig_no_node;
+         i = ast.node(i).next_sibling) {
+        const SigNode& f = ast.node(i);
+        fields.push_back({ast.text(f), ast.name(f), ast.field_type(f)});
     }
-    return f;
+    return fields;
 }
 
-inline std::string_view sig_header(std::string_view sig) noexcept {
-    auto brace = sig.find('{');
-    return (brace == std::string_view::npos) ? sig : sig.substr(0, brace);
+inline std::string_view sig_header(std::string_view sig) {
+    return sig_header(SigAst(sig));
 }
 
 inline std::vector<SigField> parse_sig_fields(std::string_view sig) {
-    auto open = sig.find('{');
-    if (open == std::string_view::npos) return {};
-    auto close = sig.rfind('}');
-    if (close == std::string_view::npos || close <= open) return {};
+    return parse_sig_fields(SigAst(sig));
+}
 
-    std::string_view content = sig.substr(open + 1, close - open - 1);
-    if (content.empty()) return {};
+/// Member nodes (Field / BitField) of a record or union node.
+inline std::vector<const SigNode*> sig_member_nodes(const SigAst& ast,
+                                                    const SigNode* owner) {
+    std::vector<const SigNode*> members;
+    if (!owner) return members;
+    members.reserve(owner->child_count);
+    for (std::uint32_t i = owner->first_child; i != sig_no_node;
+         i = ast.node(i).next_sibling)
+        members.push_back(&ast.node(i));
+    return members;
+}
 
-    std::vector<SigField> fields;
-    int depth = 0;
-    std::size_t start = 0;
-    for (std::size_t i = 0; i < content.size(); ++i) {
-        char c = content[i];
-        if (c == '[' || c == '{' || c == '<' || c == '(') ++depth;
-        else if (c == ']' || c == '}' || c == '>' || c == ')') {
-            if (depth > 0) --depth;
-        } else if (c == ',' && depth == 0) {
-            fields.push_back(make_sig_field(content.substr(start, i - start)));
-            start = i + 1;
+/// One entry of a field diff.  Indices are positions in the reference
+/// (`ref`) and other (`oth`) member lists.
+struct FieldEdit {
+    enum Kind : std::uint8_t {
+        changed,    // ref <-> oth, different type
+        removed,    // ref only
+        inserted,   // oth only
+        moved,      // `count` fields from ref/oth on, same types, offsets + delta
+    };
+    Kind          kind;
+    std::size_t   ref   = 0;
+    std::size_t   oth   = 0;
+    std::size_t   count = 1;
+    std::int64_t  delta = 0;
+};
+
+/// Structural diff of two member lists.  Fields pair up by type (the
+/// text after "@offset:") along a longest common subsequence
+/// (myers_matches), so an inserted or removed field costs one edit and
+/// the fields after it show up as one `moved` run, not as a cascade of
+/// mismatches.  Unpaired fields between two pairs are `changed` in
+/// order, then `removed` / `inserted`.
+inline std::vector<FieldEdit> diff_sig_members(const SigAst& ra,
+                                               const std::vector<const SigNode*>& ref,
+                                               const SigAst& oa,
+                                               const std::vector<const SigNode*>& oth) {
+    auto keys = [](const SigAst& ast, const std::vector<const SigNode*>& members) {
+        std::vector<std::uint64_t> k;
+        k.reserve(members.size());
+        for (const SigNode* m : members)
+            k.push_back(typelayout::detail::fnv1a_64(ast.field_type(*m)));
+        return k;
+    };
+    const std::vector<std::uint64_t> rk = keys(ra, ref);
+    const std::vector<std::uint64_t> ok = keys(oa, oth);
+    std::vector<diff_match> matches = myers_matches(rk, ok);
+    matches.emplace_back(ref.size(), oth.size());   // sentinel
+
+    std::vector<FieldEdit> edits;
+    std::size_t i = 0, j = 0;
+    for (const auto& [mi, mj] : matches) {
+        for (; i < mi && j < mj; ++i, ++j) edits.push_back({FieldEdit::changed, i, j});
+        for (; i < mi; ++i) edits.push_back({FieldEdit::removed, i, j});
+        for (; j < mj; ++j) edits.push_back({FieldEdit::inserted, i, j});
+        if (mi == ref.size()) break;
+
+        const SigNode& r = *ref[mi];
+        const SigNode& o = *oth[mj];
+        if (ra.text(r) != oa.text(o)) {
+            const std::int64_t delta = static_cast<std::int64_t>(o.offset) -
+                                       static_cast<std::int64_t>(r.offset);
+            if (delta == 0 || r.bit_offset != o.bit_offset) {
+                edits.push_back({FieldEdit::changed, mi, mj});
+            } else if (!edits.empty() && edits.back().kind == FieldEdit::moved &&
+                       edits.back().delta == delta &&
+                       edits.back().ref + edits.back().count == mi &&
+                       edits.back().oth + edits.back().count == mj) {
+                ++edits.back().count;
+            } else {
+                edits.push_back({FieldEdit::moved, mi, mj, 1, delta});
+            }
         }
+        i = mi + 1;
+        j = mj + 1;
     }
-    if (start < content.size())
-        fields.push_back(make_sig_field(content.substr(start)));
-
-    return fields;
+    return edits;
 }
 
-/// Result of comparing one type across platforms.
+/// Result of comparing one type across platforms.  Names and signatures
+/// view the registered TypeEntry arrays; signatures are as exported (full
+/// or compact), "<missing>" where a platform lacks the type and "<hash
+/// only>" where it came from a hash header.
 struct TypeResult {
-    std::string name;
-    bool        layout_match;
-    bool        byte_copy_safe;
-    SafetyLevel safety;
-    std::vector<std::string> layout_sigs;
+    std::string_view name;
+    bool             layout_match;
+    bool             byte_copy_safe;
+    SafetyLevel      safety;
+    std::vector<std::string_view> layout_sigs;
 };
 
+inline constexpr std::string_view missing_signature = "<missing>";
+inline constexpr std::string_view hash_only_signature = "<hash only>";
+
+/// `entry`'s signature as a TypeResult shows it.
+inline std::string_view result_signature(const TypeEntry& entry) noexcept {
+    return entry.layout_sig ? std::string_view(entry.layout_sig) : hash_only_signature;
+}
+
+/// A type is transfer-safe when its layout matches on every platform and
+/// every platform exported it as byte-copy safe.
+inline bool transfer_safe(const TypeResult& r) noexcept {
+    return r.layout_match && r.byte_copy_safe;
+}
+
+/// The report's verdict column for `r`.
+inline const char* type_verdict(const TypeResult& r) noexcept {
+    if (!r.layout_match) return "Layout mismatch";
+    if (!r.byte_copy_safe) return "Layout match (not byte-copy safe)";
+    switch (r.safety) {
+        case SafetyLevel::PlatformVariant:
+            return "Transfer-safe (platform-variant fields matched)";
+        case SafetyLevel::Opaque:
+            return "Transfer-safe (contains opaque fields)";
+        default:
+            return "Transfer-safe";
+    }
+}
+
 /// Platform info used by CompatReporter (runtime, owns strings).
 struct PlatformData {
     std::string       name;
@@ -130,6 +278,37 @@ struct PlatformData {
     const char*       arch_prefix       = "";
     std::string       data_model;
 
+    /// name_hash() of every entry, and name -> index into `types` (the
+    /// first entry wins on duplicates).  Built by build_index().
+    std::vector<std::uint64_t> name_hashes;
+    NameIndex                  index;
+
+    void build_index() {
+        name_hashes.resize(type_count);
+        for (std::size_t i = 0; i < type_count; ++i)
+            name_hashes[i] = name_hash(types[i].name);
+        build_index(std::move(name_hashes));
+    }
+
+    /// As build_index(), with the name hashes already known (.sigdb).
+    void build_index(std::vector<std::uint64_t> hashes) {
+        name_hashes = std::move(hashes);
+        index.reserve(type_count);
+        auto name_at = [this](std::size_t i) { return std::string_view(types[i].name); };
+        for (std::size_t i = 0; i < type_count; ++i)
+            index.insert(types[i].name, name_hashes[i], i, name_at);
+    }
+
+    const TypeEntry* find(std::string_view type_name, std::uint64_t hash) const {
+        std::size_t i = index.find(type_name, hash,
+            [this](std::size_t j) { return std::string_view(types[j].name); });
+        return i == NameIndex::npos ? nullptr : &types[i];
+    }
+
+    const TypeEntry* find(std::string_view type_name) const {
+        return find(type_name, name_hash(type_name));
+    }
+
     bool abi_matches(const PlatformData& other) const noexcept {
         return pointer_size      == other.pointer_size &&
                sizeof_long       == other.sizeof_long &&
@@ -151,15 +330,41 @@ public:
             pi.platform_name, pi.types, pi.type_count,
             pi.pointer_size, pi.sizeof_long, pi.sizeof_wchar_t,
             pi.sizeof_long_double, pi.max_align, pi.arch_prefix,
-            pi.data_model ? pi.data_model : ""
+            pi.data_model ? pi.data_model : "", {}, {}
         });
+        platforms_.back().build_index();
     }
 
-    void add_platform(const detail::PlatformData& pd) { platforms_.push_back(pd); }
+    void add_platform(const detail::PlatformData& pd) {
+        platforms_.push_back(pd);
+        platforms_.back().build_index();
+    }
 
     void add_platform(const std::string& name,
                       const TypeEntry* types, std::size_t count) {
-        platforms_.push_back({name, types, count, 0, 0, 0, 0, 0, "", {}});
+        platforms_.push_back({name, types, count, 0, 0, 0, 0, 0, "", {}, {}, {}});
+        platforms_.back().build_index();
+    }
+
+    /// Add a platform from a .sigdb file (SigExporter::write_sigdb).  The
+    /// file stays mapped for the reporter's lifetime and its names and
+    /// signatures are used in place.  False, with `error` set, when the
+    /// file cannot be mapped or is not a valid signature database.  Only
+    /// its structure is checked unless `verify_hashes` (SigDb::verify).
+    bool add_platform_mmap(const std::string& path, std::string* error = nullptr,
+                           bool verify_hashes = false) {
+        auto db = std::make_shared<SigDb>();
+        if (!db->open(path, error, verify_hashes)) return false;
+        const PlatformInfo pi = db->platform_info();
+        platforms_.push_back({
+            pi.platform_name, pi.types, pi.type_count,
+            pi.pointer_size, pi.sizeof_long, pi.sizeof_wchar_t,
+            pi.sizeof_long_double, pi.max_align, pi.arch_prefix,
+            pi.data_model, {}, {}
+        });
+        platforms_.back().build_index(db->name_hashes());
+        mapped_.push_back(std::move(db));
+        return true;
     }
 
     /// Check if the specified types are transfer-safe across the
@@ -183,30 +388,126 @@ public:
     }
 
     /// Print the report with diff annotations for mismatched signatures.
-    void print_diff_report(std::ostream& os = std::cout) const {
-        print_report_impl(os, true);
+    /// Returns the all_types_transfer_safe() verdict of the same comparison.
+    bool print_diff_report(std::ostream& os = std::cout) const {
+        return print_report_impl(os, true);
     }
 
-    /// Print the report to `os`.
-    void print_report(std::ostream& os = std::cout) const {
-        print_report_impl(os, false);
+    /// Print the report to `os`.  Returns the all_types_transfer_safe()
+    /// verdict of the same comparison.
+    bool print_report(std::ostream& os = std::cout) const {
+        return print_report_impl(os, false);
     }
 
     /// Returns true when every compared type has a matching layout signature
     /// and satisfies the exported byte-copy-safety preconditions.
     [[nodiscard]] bool all_types_transfer_safe() const {
-        auto results = compare();
-        return !results.empty() &&
-               std::all_of(results.begin(), results.end(),
-                           [](const detail::TypeResult& r) {
-                               return r.layout_match && r.byte_copy_safe;
-                           });
+        return for_each_result([](const detail::TypeResult&) {});
     }
 
+    /// Compare the types one at a time and pass each result to `visit`,
+    /// in report order (the first platform's types, then the types only
+    /// later platforms export).  Types are compared `chunk` at a time --
+    /// in parallel with set_threads() -- and a result lives only until it
+    /// has been visited, so memory for results does not grow with the
+    /// number of types; only an index of the names seen so far does.  The
+    /// result cache is not used.  Returns the all_types_transfer_safe()
+    /// verdict.
+    template <typename Visitor>
+    bool for_each_result(Visitor&& visit, std::size_t chunk = 1024) const {
+        if (chunk == 0) chunk = 1;
+        struct Pending {
+            std::string_view name;
+            std::uint64_t    hash;
+        };
+        std::vector<Pending> pending;
+        std::vector<detail::TypeResult> results;
+        pending.reserve(chunk);
+        bool any = false;
+        bool safe = true;
+        auto flush = [&] {
+            results.resize(pending.size());
+            detail::parallel_for(pending.size(), threads_,
+                [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t n = begin; n < end; ++n)
+                        results[n] = compare_type(pending[n].name, pending[n].hash);
+                });
+            for (const auto& r : results) {
+                any = true;
+                safe = safe && detail::transfer_safe(r);
+                visit(static_cast<const detail::TypeResult&>(r));
+            }
+            pending.clear();
+        };
+        // First occurrence only: one probe of the names seen so far, as
+        // in compare().
+        std::vector<std::string_view> seen_names;
+        detail::NameIndex seen;
+        if (!platforms_.empty()) {
+            seen.reserve(platforms_.front().type_count);
+            seen_names.reserve(platforms_.front().type_count);
+        }
+        auto name_at = [&](std::size_t i) { return seen_names[i]; };
+        for (const auto& plat : platforms_) {
+            for (std::size_t i = 0; i < plat.type_count; ++i) {
+                std::string_view name(plat.types[i].name);
+                const std::uint64_t hash = plat.name_hashes[i];
+                if (seen.insert(name, hash, seen_names.size(), name_at) !=
+                        seen_names.size())
+                    continue;
+                seen_names.push_back(name);
+                pending.push_back({name, hash});
+                if (pending.size() == chunk) flush();
+            }
+        }
+        flush();
+        return any && safe;
+    }
+
+    const std::vector<detail::PlatformData>& platforms() const noexcept {
+        return platforms_;
+    }
+
+    /// Number of threads used to compare types and render DIFFER
+    /// sections; 0 = one per hardware thread, 1 (default) = serial.
+    /// Reports are byte-identical for every setting.
+    void set_threads(unsigned n) noexcept { threads_ = n; }
+    unsigned threads() const noexcept { return threads_; }
+
+    /// Load cached per-type results from `path` (see compat_cache.hpp).
+    /// Types whose layout hash, byte-copy flag and entry kind (signature
+    /// or hash only) are unchanged on every platform replay their verdict
+    /// and DIFFER text instead of being compared again; save_cache()
+    /// writes the current results back.  A missing or unreadable file
+    /// starts an empty cache.  With a cache file set, the reporting
+    /// functions record their results in the reporter, so they must not
+    /// be called concurrently on the same reporter.
+    void set_cache_file(std::string path) {
+        cache_path_ = std::move(path);
+        cache_.load(cache_path_);
+    }
+
+    /// Write the results of the last comparison to the cache file.
+    bool save_cache() const {
+        return !cache_path_.empty() && cache_.save(cache_path_);
+    }
+
+    /// Types replayed from the cache by the last comparison.
+    std::size_t cache_hits() const noexcept { return cache_hits_; }
+
 private:
     std::vector<detail::PlatformData> platforms_;
-
-    void print_report_impl(std::ostream& os, bool with_diff) const {
+    std::vector<std::shared_ptr<const SigDb>> mapped_;   // add_platform_mmap
+    unsigned threads_ = 1;
+    std::string cache_path_;
+    // Filled by the const reporting functions: results of the last
+    // comparison, index-aligned with compare()'s output.  Their workers
+    // write disjoint slots; the calls themselves are not synchronised, so
+    // one reporter reports from one thread at a time (set_cache_file).
+    mutable detail::CompatCache cache_;
+    mutable std::size_t cache_hits_ = 0;
+
+    bool print_report_impl(std::ostream& os, bool with_diff) const {
         auto results = compare();
         int transfer_safe = 0;
         int layout_compatible = 0;
@@ -272,47 +573,37 @@ private:
 
         os << std::string(72, '-') << "\n\n";
 
-        for (const auto& r : results) {
-            if (!r.layout_match) {
-                os << "  [DIFFER] " << r.name << " layout signatures:\n";
-                if (with_diff) {
-                    std::size_t max_name = 0;
-                    for (const auto& p : platforms_)
-                        if (p.name.size() > max_name) max_name = p.name.size();
-                    const std::size_t prefix_w = 4 + max_name + 2;
-
-                    std::string ref_sig;
-                    for (const auto& s : r.layout_sigs) {
-                        if (s != "<missing>") {
-                            ref_sig = s;
-                            break;
-                        }
-                    }
-
-                    for (std::size_t i = 0; i < platforms_.size(); ++i) {
-                        os << "    " << platforms_[i].name;
-                        for (std::size_t pad = platforms_[i].name.size();
-                             pad < max_name; ++pad) {
-                            os << ' ';
-                        }
-                        os << ": " << r.layout_sigs[i] << "\n";
-
-                        if (i > 0 && r.layout_sigs[i] != ref_sig) {
-                            std::string ann =
-                                format_diff(ref_sig, r.layout_sigs[i], prefix_w);
-                            if (!ann.empty())
-                                os << ann << "\n";
-                            format_field_diff(os, ref_sig, r.layout_sigs[i]);
+        const bool caching = !cache_path_.empty();
+        if (!caching && detail::resolve_threads(threads_) <= 1) {
+            for (const auto& r : results)
+                if (!r.layout_match) print_differ(os, r, with_diff);
+        } else {
+            // Render DIFFER sections (expansion + diffs) in parallel, or
+            // take them from the cache, then write them in result order:
+            // output matches the serial path.
+            const int mode = with_diff ? 1 : 0;
+            std::vector<std::size_t> differ;
+            for (std::size_t n = 0; n < results.size(); ++n)
+                if (!results[n].layout_match) differ.push_back(n);
+            std::vector<std::string> local(caching ? 0 : differ.size());
+            detail::parallel_for(differ.size(), threads_,
+                [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        if (caching && cache_.slot(differ[i]).text(mode))
+                            continue;
+                        std::ostringstream section;
+                        print_differ(section, results[differ[i]], with_diff);
+                        if (!caching) {
+                            local[i] = std::move(section).str();
+                            continue;
                         }
+                        auto& slot = cache_.slot(differ[i]);
+                        slot.differ[mode] = std::move(section).str();
+                        slot.has_differ[mode] = true;
                     }
-                } else {
-                    for (std::size_t i = 0; i < platforms_.size(); ++i) {
-                        os << "    " << platforms_[i].name << ": "
-                           << r.layout_sigs[i] << "\n";
-                    }
-                }
-                os << "\n";
-            }
+                }, 8);
+            for (std::size_t i = 0; i < differ.size(); ++i)
+                os << (caching ? *cache_.slot(differ[i]).text(mode) : local[i]);
         }
 
         bool has_warnings = false;
@@ -350,87 +641,218 @@ private:
         os << "  Layout mismatches can be enforced with generated checks and "
               "compile-time assertions; transport preconditions are reported "
               "here and can be surfaced in CI.\n\n";
+        return total > 0 && transfer_safe == total;
     }
 
-    std::vector<detail::TypeResult> compare() const {
-        if (platforms_.empty()) return {};
+    void print_differ(std::ostream& os, const detail::TypeResult& r,
+                      bool with_diff) const {
+        os << "  [DIFFER] " << r.name << " layout signatures:\n";
+        std::vector<std::string> sigs;
+        sigs.reserve(r.layout_sigs.size());
+        for (std::string_view s : r.layout_sigs)
+            sigs.push_back(detail::full_signature(s));
+        if (with_diff) {
+            std::size_t max_name = 0;
+            for (const auto& p : platforms_)
+                if (p.name.size() > max_name) max_name = p.name.size();
+            const std::size_t prefix_w = 4 + max_name + 2;
+
+            // Only real signatures are diffed, not the placeholders.
+            auto is_signature = [](std::string_view s) {
+                return s != detail::missing_signature &&
+                       s != detail::hash_only_signature;
+            };
+            std::string ref_sig;
+            for (const auto& s : sigs) {
+                if (is_signature(s)) {
+                    ref_sig = s;
+                    break;
+                }
+            }
 
-        std::vector<std::string> all_names;
-        for (const auto& plat : platforms_) {
-            for (std::size_t i = 0; i < plat.type_count; ++i) {
-                std::string name(plat.types[i].name);
-                bool found = false;
-                for (const auto& existing : all_names) {
-                    if (existing == name) { found = true; break; }
+            for (std::size_t i = 0; i < platforms_.size(); ++i) {
+                os << "    " << platforms_[i].name;
+                for (std::size_t pad = platforms_[i].name.size();
+                     pad < max_name; ++pad) {
+                    os << ' ';
+                }
+                os << ": " << sigs[i] << "\n";
+
+                if (i > 0 && sigs[i] != ref_sig && is_signature(sigs[i]) &&
+                    !ref_sig.empty()) {
+                    std::string ann = format_diff(ref_sig, sigs[i], prefix_w);
+                    if (!ann.empty())
+                        os << ann << "\n";
+                    format_field_diff(os, ref_sig, sigs[i]);
                 }
-                if (!found) all_names.push_back(std::move(name));
+            }
+        } else {
+            for (std::size_t i = 0; i < platforms_.size(); ++i) {
+                os << "    " << platforms_[i].name << ": "
+                   << sigs[i] << "\n";
             }
         }
+        os << "\n";
+    }
 
-        std::vector<detail::TypeResult> results;
-        results.reserve(all_names.size());
-
-        for (const auto& name : all_names) {
-            detail::TypeResult tr;
-            tr.name = name;
-            tr.layout_match = true;
-            tr.byte_copy_safe = true;
-
-            detail::SafetyLevel worst_safety = detail::SafetyLevel::TrivialSafe;
-            std::string first_sig;
+    std::vector<detail::TypeResult> compare() const {
+        if (platforms_.empty()) return {};
 
+        // Union of type names in first-seen order.  Views point into the
+        // registered TypeEntry arrays, which outlive the reporter's use.
+        std::vector<std::string_view> all_names;
+        std::vector<std::uint64_t>    all_hashes;
+        {
+            // Platforms mostly share their types: size for the first and
+            // let the index grow for the rest.
+            detail::NameIndex seen;
+            seen.reserve(platforms_.front().type_count);
+            all_names.reserve(platforms_.front().type_count);
+            all_hashes.reserve(platforms_.front().type_count);
+            auto name_at = [&](std::size_t i) { return all_names[i]; };
             for (const auto& plat : platforms_) {
-                const TypeEntry* entry = find_type(plat, name);
-                if (!entry) {
-                    tr.layout_sigs.emplace_back("<missing>");
-                    tr.layout_match = false;
-                    tr.byte_copy_safe = false;
-                    continue;
-                }
-                std::string sig(entry->layout_sig);
-                if (first_sig.empty()) {
-                    first_sig = sig;
-                } else if (sig != first_sig) {
-                    tr.layout_match = false;
+                for (std::size_t i = 0; i < plat.type_count; ++i) {
+                    std::string_view name(plat.types[i].name);
+                    std::uint64_t hash = plat.name_hashes[i];
+                    if (seen.insert(name, hash, all_names.size(), name_at) ==
+                            all_names.size()) {
+                        all_names.push_back(name);
+                        all_hashes.push_back(hash);
+                    }
                 }
-                tr.layout_sigs.push_back(std::move(sig));
+            }
+        }
 
-                if (!entry->byte_copy_safe)
-                    tr.byte_copy_safe = false;
+        const bool caching = !cache_path_.empty();
+        std::vector<detail::CacheSlot> next;
+        std::vector<unsigned char> hit;
+        if (caching) {
+            std::vector<std::string> names;
+            names.reserve(platforms_.size());
+            for (const auto& plat : platforms_) names.push_back(plat.name);
+            cache_.bind_platforms(names);
+            next.resize(all_names.size());
+            hit.resize(all_names.size());
+        }
 
-                auto level = detail::classify_signature(entry->layout_sig);
-                if (static_cast<int>(level) > static_cast<int>(worst_safety))
-                    worst_safety = level;
-            }
-            tr.safety = worst_safety;
-            results.push_back(std::move(tr));
+        // Each type is compared independently and written to its own slot,
+        // so the result order does not depend on the thread count.
+        std::vector<detail::TypeResult> results(all_names.size());
+        detail::parallel_for(all_names.size(), threads_,
+            [&](std::size_t begin, std::size_t end) {
+                for (std::size_t n = begin; n < end; ++n) {
+                    if (caching && replay_cached(all_names[n], all_hashes[n],
+                                                 results[n], next[n])) {
+                        hit[n] = 1;
+                        continue;
+                    }
+                    results[n] = compare_type(all_names[n], all_hashes[n]);
+                    if (caching) {
+                        next[n].layout_match = results[n].layout_match;
+                        next[n].byte_copy_safe = results[n].byte_copy_safe;
+                        next[n].safety = results[n].safety;
+                    }
+                }
+            });
+
+        if (caching) {
+            cache_hits_ = static_cast<std::size_t>(
+                std::count(hit.begin(), hit.end(), 1));
+            cache_.set_slots(std::move(next));
         }
         return results;
     }
 
-    static std::string format_verdict(const detail::TypeResult& r,
-                                      int& transfer_safe,
-                                      int& layout_compatible) {
-        if (!r.layout_match)
-            return "Layout mismatch";
+    /// Fill `tr`'s signatures and the cache key of `name` into `key`;
+    /// when the cache holds the same key, replay its result and return true.
+    bool replay_cached(std::string_view name, std::uint64_t hash,
+                       detail::TypeResult& tr, detail::CacheSlot& key) const {
+        key.name = name;
+        key.key = detail::cache_key_basis;
+        tr.layout_sigs.reserve(platforms_.size());
+        bool cacheable = true;
+        for (const auto& plat : platforms_) {
+            const TypeEntry* entry = plat.find(name, hash);
+            if (!entry) {
+                tr.layout_sigs.push_back(detail::missing_signature);
+                key.key = detail::cache_key_step(key.key, 0, '-');
+                continue;
+            }
+            tr.layout_sigs.push_back(detail::result_signature(*entry));
+            const char state = entry->layout_sig ? (entry->byte_copy_safe ? 's' : 'u')
+                                                 : (entry->byte_copy_safe ? 'S' : 'U');
+            key.key = detail::cache_key_step(key.key, entry->layout_hash, state);
+            if (entry->layout_hash == 0) cacheable = false;
+        }
 
-        ++layout_compatible;
+        const detail::CachedResult* old =
+            cacheable ? cache_.find(name, hash) : nullptr;
+        if (!old || old->key != key.key) {
+            tr.layout_sigs.clear();
+            return false;
+        }
+        tr.name = name;
+        tr.layout_match = key.layout_match = old->layout_match;
+        tr.byte_copy_safe = key.byte_copy_safe = old->byte_copy_safe;
+        tr.safety = key.safety = old->safety;
+        key.replayed = old;
+        return true;
+    }
 
-        if (!r.byte_copy_safe)
-            return "Layout match (not byte-copy safe)";
+    detail::TypeResult compare_type(std::string_view name,
+                                    std::uint64_t hash) const {
+        detail::TypeResult tr;
+        tr.name = name;
+        tr.layout_match = true;
+        tr.byte_copy_safe = true;
+        tr.layout_sigs.reserve(platforms_.size());
 
-        ++transfer_safe;
+        detail::SafetyLevel worst_safety = detail::SafetyLevel::TrivialSafe;
+        const TypeEntry* first = nullptr;
+        bool classified = false;
 
-        switch (r.safety) {
-            case detail::SafetyLevel::TrivialSafe:
-                return "Transfer-safe";
-            case detail::SafetyLevel::PlatformVariant:
-                return "Transfer-safe (platform-variant fields matched)";
-            case detail::SafetyLevel::Opaque:
-                return "Transfer-safe (contains opaque fields)";
-            default:
-                return "Transfer-safe";
+        for (const auto& plat : platforms_) {
+            const TypeEntry* entry = plat.find(name, hash);
+            if (!entry) {
+                tr.layout_sigs.push_back(detail::missing_signature);
+                tr.layout_match = false;
+                tr.byte_copy_safe = false;
+                continue;
+            }
+            tr.layout_sigs.push_back(detail::result_signature(*entry));
+
+            if (!entry->byte_copy_safe)
+                tr.byte_copy_safe = false;
+
+            // A layout equal to the first one classifies the same;
+            // only the first and each differing signature are parsed.
+            // Hash-only entries have no signature to classify, so the
+            // first signature after them is parsed instead.
+            bool classify = true;
+            if (!first) {
+                first = entry;
+            } else if (!detail::same_layout(*first, *entry)) {
+                tr.layout_match = false;
+            } else {
+                classify = false;
+            }
+            if (!entry->layout_sig || (!classify && classified)) continue;
+            classified = true;
+
+            auto level = detail::classify_signature(entry->layout_sig);
+            if (static_cast<int>(level) > static_cast<int>(worst_safety))
+                worst_safety = level;
         }
+        tr.safety = worst_safety;
+        return tr;
+    }
+
+    static std::string format_verdict(const detail::TypeResult& r,
+                                      int& transfer_safe,
+                                      int& layout_compatible) {
+        if (r.layout_match) ++layout_compatible;
+        if (detail::transfer_safe(r)) ++transfer_safe;
+        return detail::type_verdict(r);
     }
 
     static std::string format_diff(const std::string& a, const std::string& b,
@@ -456,29 +878,42 @@ private:
         return arrow;
     }
 
+    // Field diff of the outermost member lists (detail::diff_sig_members):
+    // one line per changed, removed or inserted field and per run of
+    // fields moved by the same offset, so the output grows with the
+    // change, not with the record.
     static void format_field_diff(std::ostream& os,
                                   const std::string& ref_sig,
                                   const std::string& other_sig) {
-        auto ref_fields = detail::parse_sig_fields(ref_sig);
-        auto oth_fields = detail::parse_sig_fields(other_sig);
+        detail::SigAst ref_ast(ref_sig);
+        detail::SigAst oth_ast(other_sig);
+        const auto ref = detail::sig_member_nodes(ref_ast, detail::sig_member_owner(ref_ast));
+        const auto oth = detail::sig_member_nodes(oth_ast, detail::sig_member_owner(oth_ast));
+        if (ref.empty() && oth.empty()) return;
 
-        if (ref_fields.empty() && oth_fields.empty()) return;
+        const auto edits = detail::diff_sig_members(ref_ast, ref, oth_ast, oth);
+        if (edits.empty()) return;
 
-        std::size_t max_n = std::max(ref_fields.size(), oth_fields.size());
-        std::size_t diff_count = 0;
-        for (std::size_t i = 0; i < max_n; ++i) {
-            bool match = (i < ref_fields.size() && i < oth_fields.size() &&
-                          ref_fields[i].full == oth_fields[i].full);
-            if (!match) ++diff_count;
-        }
-        if (diff_count == 0) return;
+        std::size_t counts[4] = {};
+        for (const auto& e : edits) counts[e.kind] += e.count;
+        const std::size_t diff_count = counts[0] + counts[1] + counts[2] + counts[3];
 
-        auto ref_hdr = detail::sig_header(ref_sig);
-        auto oth_hdr = detail::sig_header(other_sig);
+        auto ref_hdr = detail::sig_header(ref_ast);
+        auto oth_hdr = detail::sig_header(oth_ast);
         bool hdr_diff = (ref_hdr != oth_hdr);
 
         os << "    Field diff: " << diff_count << " of "
-           << max_n << " field(s) differ";
+           << std::max(ref.size(), oth.size()) << " field(s) differ";
+        if (diff_count != counts[detail::FieldEdit::changed]) {
+            static constexpr const char* kinds[4] = {"changed", "removed", "inserted", "moved"};
+            const char* sep = " (";
+            for (std::size_t k = 0; k < 4; ++k) {
+                if (counts[k] == 0) continue;
+                os << sep << counts[k] << " " << kinds[k];
+                sep = ", ";
+            }
+            os << ")";
+        }
         if (hdr_diff) os << "; header differs";
         os << "\n";
 
@@ -486,23 +921,93 @@ private:
             os << "      header: " << ref_hdr << "\n"
                << "          vs: " << oth_hdr << "\n";
         }
-        for (std::size_t i = 0; i < max_n; ++i) {
-            if (i < ref_fields.size() && i < oth_fields.size()) {
-                if (ref_fields[i].full != oth_fields[i].full) {
-                    os << "      #" << (i + 1) << ": "
-                       << ref_fields[i].full << " vs "
-                       << oth_fields[i].full << "\n";
+        format_field_edits(os, ref_ast, ref, oth_ast, oth, edits, "      ");
+    }
+
+    static void format_field_edits(std::ostream& os,
+                                   const detail::SigAst& ra,
+                                   const std::vector<const detail::SigNode*>& ref,
+                                   const detail::SigAst& oa,
+                                   const std::vector<const detail::SigNode*>& oth,
+                                   const std::vector<detail::FieldEdit>& edits,
+                                   const std::string& indent) {
+        using detail::FieldEdit;
+        for (const auto& e : edits) {
+            switch (e.kind) {
+            case FieldEdit::changed:
+                os << indent << "#" << (e.ref + 1) << ": ";
+                if (!format_nested_diff(os, ra, *ref[e.ref], oa, *oth[e.oth], indent))
+                    os << ra.text(*ref[e.ref]) << " vs " << oa.text(*oth[e.oth]) << "\n";
+                break;
+            case FieldEdit::removed:
+                os << indent << "#" << (e.ref + 1) << ": "
+                   << ra.text(*ref[e.ref]) << " (only in reference)\n";
+                break;
+            case FieldEdit::inserted:
+                os << indent << "#" << (e.oth + 1) << ": "
+                   << oa.text(*oth[e.oth]) << " (only in other)\n";
+                break;
+            case FieldEdit::moved:
+                if (e.count == 1) {
+                    os << indent << "#" << (e.ref + 1) << ": " << ra.text(*ref[e.ref])
+                       << " vs " << oa.text(*oth[e.oth]) << "\n";
+                } else {
+                    os << indent << "#" << (e.ref + 1) << "..#" << (e.ref + e.count)
+                       << ": " << e.count << " field(s) moved by "
+                       << (e.delta > 0 ? "+" : "") << e.delta << " byte(s) (@"
+                       << ref[e.ref]->offset << " -> @" << oth[e.oth]->offset << ")\n";
                 }
-            } else if (i < ref_fields.size()) {
-                os << "      #" << (i + 1) << ": "
-                   << ref_fields[i].full << " (only in reference)\n";
-            } else {
-                os << "      #" << (i + 1) << ": "
-                   << oth_fields[i].full << " (only in other)\n";
+                break;
             }
         }
     }
 
+    // A changed field whose types are both array<...> / enum<...> of the
+    // same shape, down to a record or union on each side: print the two
+    // heads and diff the element's members one level deeper.  Returns
+    // false (nothing printed) for any other pair.
+    static bool format_nested_diff(std::ostream& os,
+                                   const detail::SigAst& ra, const detail::SigNode& rf,
+                                   const detail::SigAst& oa, const detail::SigNode& of,
+                                   const std::string& indent) {
+        using detail::SigNodeKind;
+        using detail::sig_no_node;
+        if (rf.kind != SigNodeKind::Field || of.kind != SigNodeKind::Field) return false;
+        const detail::SigNode* r = &ra.node(rf.first_child);
+        const detail::SigNode* o = &oa.node(of.first_child);
+        if (r->kind != o->kind ||
+            (r->kind != SigNodeKind::Array && r->kind != SigNodeKind::Enum))
+            return false;
+
+        std::string path;
+        std::string counts;
+        while (r->kind == o->kind &&
+               (r->kind == SigNodeKind::Array || r->kind == SigNodeKind::Enum) &&
+               r->first_child != sig_no_node && o->first_child != sig_no_node) {
+            if (r->kind == SigNodeKind::Array && r->count != o->count)
+                counts += "; count " + std::to_string(r->count) + " vs " +
+                          std::to_string(o->count);
+            path += r->kind == SigNodeKind::Array ? " element" : " underlying";
+            r = &ra.node(r->first_child);
+            o = &oa.node(o->first_child);
+        }
+        const bool records = (r->kind == SigNodeKind::Record || r->kind == SigNodeKind::Union) &&
+                             (o->kind == SigNodeKind::Record || o->kind == SigNodeKind::Union);
+        if (!records) return false;
+
+        os << "@" << ra.name(rf) << ":" << ra.head(ra.node(rf.first_child)) << "<...> vs @"
+           << oa.name(of) << ":" << oa.head(oa.node(of.first_child)) << "<...>" << counts
+           << "\n";
+        const std::string inner = indent + "  ";
+        if (ra.head(*r) != oa.head(*o))
+            os << inner << path.substr(1) << ": " << ra.head(*r) << " vs " << oa.head(*o) << "\n";
+        const auto ref = detail::sig_member_nodes(ra, r);
+        const auto oth = detail::sig_member_nodes(oa, o);
+        format_field_edits(os, ra, ref, oa, oth,
+                           detail::diff_sig_members(ra, ref, oa, oth), inner);
+        return true;
+    }
+
     template <typename TIter, typename PIter>
     bool check_transfer_safe(TIter t_begin, TIter t_end,
                                   PIter p_begin, PIter p_end) const {
@@ -525,19 +1030,18 @@ private:
 
         for (auto it = t_begin; it != t_end; ++it) {
             std::string_view tname(*it);
-            std::string_view first_sig;
+            const std::uint64_t hash = detail::name_hash(tname);
+            const TypeEntry* first = nullptr;
             for (std::size_t pi : plat_idx) {
-                const TypeEntry* entry = find_type(platforms_[pi],
-                                                   std::string(tname));
+                const TypeEntry* entry = platforms_[pi].find(tname, hash);
                 if (!entry) return false;
 
                 if (!entry->byte_copy_safe)
                     return false;
 
-                std::string_view sig(entry->layout_sig);
-                if (first_sig.empty())
-                    first_sig = sig;
-                else if (sig != first_sig)
+                if (!first)
+                    first = entry;
+                else if (!detail::same_layout(*first, *entry))
                     return false;
             }
         }
@@ -567,15 +1071,6 @@ private:
         }
         return groups;
     }
-
-    static const TypeEntry* find_type(const detail::PlatformData& plat,
-                                      const std::string& name) {
-        for (std::size_t i = 0; i < plat.type_count; ++i) {
-            if (std::string_view(plat.types[i].name) == name)
-                return &plat.types[i];
-        }
-        return nullptr;
-    }
 };
 
 } // namespace compat
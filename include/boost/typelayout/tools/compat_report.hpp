@@ -0,0 +1,368 @@
+// Machine-readable compatibility reports (JSON Lines, JUnit XML, SARIF).
+//
+// Public API:
+//   - ReportFormat                  -- text, jsonl, junit, sarif
+//   - parse_report_format(s, out)   -- "text" / "jsonl" / "junit" / "sarif"
+//   - write_report(reporter, os, f) -- write a report, return the verdict
+//
+// The machine-readable writers stream: they visit the types through
+// CompatReporter::for_each_result() and write each one as soon as it has
+// been compared, so memory stays bounded however many types a registry
+// holds.  The verdict (CompatReporter::all_types_transfer_safe()) comes
+// from the same pass.
+//
+// A platform that exported a type hash-only (no layout_sig) has no
+// signature to show: the JSON formats give it a null signature and list
+// its layout hash under "hash_only", and JUnit prints the hash.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_COMPAT_REPORT_HPP
+#define BOOST_TYPELAYOUT_TOOLS_COMPAT_REPORT_HPP
+
+#include <boost/typelayout/tools/compat_check.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace compat {
+
+enum class ReportFormat {
+    text,    // CompatReporter::print_report()
+    jsonl,   // one JSON object per line: platforms, each type, summary
+    junit,   // JUnit XML, one testcase per type
+    sarif    // SARIF 2.1.0, one result per type that is not transfer-safe
+};
+
+/// Parse a format name; false (and `out` unchanged) if it is not one.
+inline bool parse_report_format(std::string_view s, ReportFormat& out) noexcept {
+    if (s == "text")  { out = ReportFormat::text;  return true; }
+    if (s == "jsonl") { out = ReportFormat::jsonl; return true; }
+    if (s == "junit") { out = ReportFormat::junit; return true; }
+    if (s == "sarif") { out = ReportFormat::sarif; return true; }
+    return false;
+}
+
+namespace detail {
+
+/// Write `s` as a JSON string literal.
+inline void write_json_string(std::ostream& os, std::string_view s) {
+    os << '"';
+    for (char c : s) {
+        switch (c) {
+            case '"':  os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\r': os << "\\r"; break;
+            case '\t': os << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x",
+                                  static_cast<unsigned>(static_cast<unsigned char>(c)));
+                    os << buf;
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+/// Write `s` as XML character data or attribute text.
+inline void write_xml_text(std::ostream& os, std::string_view s) {
+    for (char c : s) {
+        switch (c) {
+            case '&':  os << "&amp;"; break;
+            case '<':  os << "&lt;"; break;
+            case '>':  os << "&gt;"; break;
+            case '"':  os << "&quot;"; break;
+            case '\'': os << "&apos;"; break;
+            default:
+                // Control characters other than TAB/LF/CR are not XML.
+                if (static_cast<unsigned char>(c) >= 0x20 || c == '\t' ||
+                    c == '\n' || c == '\r')
+                    os << c;
+                else
+                    os << '?';
+        }
+    }
+}
+
+inline const char* safety_level_id(SafetyLevel level) noexcept {
+    switch (level) {
+        case SafetyLevel::TrivialSafe:     return "trivial";
+        case SafetyLevel::PointerRisk:     return "pointer-risk";
+        case SafetyLevel::PlatformVariant: return "platform-variant";
+        case SafetyLevel::Opaque:          return "opaque";
+    }
+    return "unknown";
+}
+
+/// "name [arch] model", as in the text report's platform list.
+inline std::string platform_label(const PlatformData& p) {
+    std::string s = p.name;
+    if (p.arch_prefix[0] != '\0') (s += ' ') += p.arch_prefix;
+    if (!p.data_model.empty()) (s += ' ') += p.data_model;
+    return s;
+}
+
+/// Running totals of a streamed report.
+struct ReportCounts {
+    std::size_t total = 0;
+    std::size_t transfer_safe = 0;
+    std::size_t layout_compatible = 0;
+
+    void add(const TypeResult& r) noexcept {
+        ++total;
+        if (r.layout_match) ++layout_compatible;
+        if (detail::transfer_safe(r)) ++transfer_safe;
+    }
+};
+
+/// "0x..." layout hash of `name` on `p`, for an entry exported hash-only.
+inline std::string hash_only_layout_hash(const PlatformData& p, std::string_view name) {
+    const TypeEntry* e = p.find(name);
+    char buf[24];
+    std::snprintf(buf, sizeof(buf), "0x%016llx",
+                  static_cast<unsigned long long>(e ? e->layout_hash : 0));
+    return buf;
+}
+
+/// One line per platform-signature pair, for failure messages.  A
+/// hash-only entry shows its layout hash.
+inline void write_signature_lines(std::ostream& os, const TypeResult& r,
+                                  const std::vector<PlatformData>& platforms) {
+    for (std::size_t i = 0; i < platforms.size(); ++i) {
+        os << platforms[i].name << ": ";
+        if (r.layout_sigs[i] == missing_signature)
+            write_xml_text(os, missing_signature);
+        else if (r.layout_sigs[i] == hash_only_signature)
+            os << "layout hash " << hash_only_layout_hash(platforms[i], r.name);
+        else
+            write_xml_text(os, full_signature(r.layout_sigs[i]));
+        os << '\n';
+    }
+}
+
+/// `"signatures": {platform: signature, ...}` for a mismatched type, and
+/// `"hash_only": {platform: "0x...", ...}` when some platform exported it
+/// hash-only.  Missing and hash-only entries have a null signature.
+/// `comma` and `colon` are the separators of the surrounding document.
+inline void write_json_signatures(std::ostream& os, const TypeResult& r,
+                                  const std::vector<PlatformData>& platforms,
+                                  const char* comma, const char* colon) {
+    bool any_hash_only = false;
+    os << "\"signatures\"" << colon << '{';
+    for (std::size_t i = 0; i < platforms.size(); ++i) {
+        if (i > 0) os << comma;
+        write_json_string(os, platforms[i].name);
+        os << colon;
+        if (r.layout_sigs[i] == missing_signature ||
+            r.layout_sigs[i] == hash_only_signature) {
+            any_hash_only = any_hash_only || r.layout_sigs[i] == hash_only_signature;
+            os << "null";
+        } else {
+            write_json_string(os, full_signature(r.layout_sigs[i]));
+        }
+    }
+    os << '}';
+    if (!any_hash_only) return;
+    os << comma << "\"hash_only\"" << colon << '{';
+    bool first = true;
+    for (std::size_t i = 0; i < platforms.size(); ++i) {
+        if (r.layout_sigs[i] != hash_only_signature) continue;
+        if (!first) os << comma;
+        first = false;
+        write_json_string(os, platforms[i].name);
+        os << colon;
+        write_json_string(os, hash_only_layout_hash(platforms[i], r.name));
+    }
+    os << '}';
+}
+
+inline bool write_jsonl(const CompatReporter& reporter, std::ostream& os) {
+    const auto& platforms = reporter.platforms();
+    os << "{\"record\":\"platforms\",\"platforms\":[";
+    for (std::size_t i = 0; i < platforms.size(); ++i) {
+        const auto& p = platforms[i];
+        if (i > 0) os << ',';
+        os << "{\"name\":";
+        write_json_string(os, p.name);
+        os << ",\"arch\":";
+        write_json_string(os, p.arch_prefix);
+        os << ",\"data_model\":";
+        write_json_string(os, p.data_model);
+        os << ",\"pointer_size\":" << p.pointer_size
+           << ",\"sizeof_long\":" << p.sizeof_long
+           << ",\"sizeof_wchar_t\":" << p.sizeof_wchar_t
+           << ",\"sizeof_long_double\":" << p.sizeof_long_double
+           << ",\"max_align\":" << p.max_align << '}';
+    }
+    os << "]}\n";
+
+    ReportCounts counts;
+    const bool ok = reporter.for_each_result([&](const TypeResult& r) {
+        counts.add(r);
+        os << "{\"record\":\"type\",\"name\":";
+        write_json_string(os, r.name);
+        os << ",\"layout_match\":" << (r.layout_match ? "true" : "false")
+           << ",\"byte_copy_safe\":" << (r.byte_copy_safe ? "true" : "false")
+           << ",\"transfer_safe\":" << (transfer_safe(r) ? "true" : "false")
+           << ",\"safety\":\"" << safety_level_id(r.safety) << "\""
+           << ",\"verdict\":";
+        write_json_string(os, type_verdict(r));
+        // Signatures only where they tell something: a matching layout
+        // is the same on every platform.
+        if (!r.layout_match) {
+            os << ',';
+            write_json_signatures(os, r, platforms, ",", ":");
+        }
+        os << "}\n";
+    });
+
+    os << "{\"record\":\"summary\",\"total\":" << counts.total
+       << ",\"transfer_safe\":" << counts.transfer_safe
+       << ",\"layout_compatible\":" << counts.layout_compatible
+       << ",\"layout_mismatch\":" << (counts.total - counts.layout_compatible)
+       << ",\"ok\":" << (ok ? "true" : "false") << "}\n";
+    return ok;
+}
+
+// The testsuite's tests/failures counts are attributes of its opening
+// tag, which a streaming writer cannot know yet; consumers count the
+// testcases instead, and the totals are repeated in <system-out>.
+inline bool write_junit(const CompatReporter& reporter, std::ostream& os) {
+    const auto& platforms = reporter.platforms();
+    os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+       << "<testsuites name=\"typelayout\">\n"
+       << "  <testsuite name=\"typelayout.compat\">\n"
+       << "    <properties>\n";
+    for (const auto& p : platforms) {
+        os << "      <property name=\"platform\" value=\"";
+        write_xml_text(os, platform_label(p));
+        os << "\"/>\n";
+    }
+    os << "    </properties>\n";
+
+    ReportCounts counts;
+    const bool ok = reporter.for_each_result([&](const TypeResult& r) {
+        counts.add(r);
+        os << "    <testcase classname=\"typelayout.compat\" name=\"";
+        write_xml_text(os, r.name);
+        if (transfer_safe(r)) {
+            os << "\"/>\n";
+            return;
+        }
+        os << "\">\n      <failure type=\""
+           << (r.layout_match ? "not-byte-copy-safe" : "layout-mismatch")
+           << "\" message=\"" << type_verdict(r) << "\">";
+        if (!r.layout_match)
+            write_signature_lines(os, r, platforms);
+        else
+            write_xml_text(os, safety_reason(r.safety));
+        os << "</failure>\n    </testcase>\n";
+    });
+
+    os << "    <system-out>" << counts.transfer_safe << '/' << counts.total
+       << " type(s) transfer-safe, " << counts.layout_compatible << '/'
+       << counts.total << " layout-compatible</system-out>\n"
+       << "  </testsuite>\n"
+       << "</testsuites>\n";
+    return ok;
+}
+
+inline bool write_sarif(const CompatReporter& reporter, std::ostream& os) {
+    const auto& platforms = reporter.platforms();
+    os << "{\n"
+          "  \"$schema\": \"https://json.schemastore.org/sarif-2.1.0.json\",\n"
+          "  \"version\": \"2.1.0\",\n"
+          "  \"runs\": [{\n"
+          "    \"tool\": {\"driver\": {\n"
+          "      \"name\": \"typelayout-compat\",\n"
+          "      \"rules\": [\n"
+          "        {\"id\": \"TL001\", \"name\": \"LayoutMismatch\", "
+          "\"shortDescription\": {\"text\": \"Type layout differs between platforms\"}},\n"
+          "        {\"id\": \"TL002\", \"name\": \"NotByteCopySafe\", "
+          "\"shortDescription\": {\"text\": \"Layout matches but the type is not byte-copy safe\"}},\n"
+          "        {\"id\": \"TL003\", \"name\": \"SafetyWarning\", "
+          "\"shortDescription\": {\"text\": \"Transfer-safe type with platform-dependent fields\"}}\n"
+          "      ]\n"
+          "    }},\n"
+          "    \"results\": [";
+
+    ReportCounts counts;
+    bool first = true;
+    const bool ok = reporter.for_each_result([&](const TypeResult& r) {
+        counts.add(r);
+        const char* rule;
+        const char* level;
+        if (!r.layout_match)          { rule = "TL001"; level = "error"; }
+        else if (!r.byte_copy_safe)   { rule = "TL002"; level = "error"; }
+        else if (r.safety != SafetyLevel::TrivialSafe)
+                                      { rule = "TL003"; level = "warning"; }
+        else return;
+
+        os << (first ? "\n" : ",\n")
+           << "      {\"ruleId\": \"" << rule << "\", \"level\": \"" << level
+           << "\", \"message\": {\"text\": ";
+        first = false;
+        std::string text(r.name);
+        (text += ": ") += type_verdict(r);
+        if (r.layout_match) (text += " -- ") += safety_reason(r.safety);
+        write_json_string(os, text);
+        os << "}, \"locations\": [{\"logicalLocations\": [{\"name\": ";
+        write_json_string(os, r.name);
+        os << ", \"kind\": \"type\"}]}]";
+        if (!r.layout_match) {
+            os << ", \"properties\": {";
+            write_json_signatures(os, r, platforms, ", ", ": ");
+            os << '}';
+        }
+        os << '}';
+    });
+
+    os << (first ? "],\n" : "\n    ],\n")
+       << "    \"properties\": {\"platforms\": [";
+    for (std::size_t i = 0; i < platforms.size(); ++i) {
+        if (i > 0) os << ", ";
+        write_json_string(os, platform_label(platforms[i]));
+    }
+    os << "], \"total\": " << counts.total
+       << ", \"transfer_safe\": " << counts.transfer_safe
+       << ", \"layout_compatible\": " << counts.layout_compatible
+       << ", \"ok\": " << (ok ? "true" : "false") << "}\n"
+       << "  }]\n"
+       << "}\n";
+    return ok;
+}
+
+} // namespace detail
+
+/// Write `reporter`'s report to `os` in `format` and return its verdict
+/// (all_types_transfer_safe()), from a single comparison.  The text
+/// format is print_report(); the others stream and skip the result cache.
+inline bool write_report(const CompatReporter& reporter, std::ostream& os,
+                         ReportFormat format) {
+    switch (format) {
+        case ReportFormat::jsonl: return detail::write_jsonl(reporter, os);
+        case ReportFormat::junit: return detail::write_junit(reporter, os);
+        case ReportFormat::sarif: return detail::write_sarif(reporter, os);
+        case ReportFormat::text:  break;
+    }
+    return reporter.print_report(os);
+}
+
+} // namespace compat
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_TOOLS_COMPAT_REPORT_HPP
@@ -1,4 +1,5 @@
 // FOR_EACH(macro, ...) -- up to 32 args. Used by sig_export.hpp and compat_auto.hpp.
+// Larger type lists: SigExporter::add_namespace (no macro expansion).
 // TODO(P1306/P2996): Replace with template-based variadic API when C++26
 // pack indexing and reflection are stable (e.g., fold over type list).
 //
@@ -0,0 +1,184 @@
+// MappedFile -- read-only memory mapping of a whole file, and
+// replace_file_if_changed() -- atomic, write-if-changed file output.
+//
+// MappedFile maps with mmap() on POSIX and MapViewOfFile() on Windows; the
+// mapping lives until close() or destruction and does not move when the
+// MappedFile is moved.  An empty file maps to (nullptr, 0).
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_DETAIL_MAPPED_FILE_HPP
+#define BOOST_TYPELAYOUT_TOOLS_DETAIL_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace detail {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile() { close(); }
+
+    /// Maps `path` read-only; false (with `error` set) on failure.
+    bool open(const std::string& path, std::string* error = nullptr) {
+        close();
+#if defined(_WIN32)
+        HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                                    nullptr);
+        if (file == INVALID_HANDLE_VALUE) return fail(error, "cannot open " + path);
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file, &size)) {
+            ::CloseHandle(file);
+            return fail(error, "cannot stat " + path);
+        }
+        if (size.QuadPart == 0) {
+            ::CloseHandle(file);
+            return true;
+        }
+        HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(file);
+        if (!mapping) return fail(error, "cannot map " + path);
+        void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mapping);
+        if (!view) return fail(error, "cannot map " + path);
+        data_ = static_cast<const unsigned char*>(view);
+        size_ = static_cast<std::size_t>(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return fail(error, "cannot open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return fail(error, "cannot stat " + path);
+        }
+        if (st.st_size == 0) {
+            ::close(fd);
+            return true;
+        }
+        void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return fail(error, "cannot map " + path);
+        data_ = static_cast<const unsigned char*>(p);
+        size_ = static_cast<std::size_t>(st.st_size);
+#endif
+        return true;
+    }
+
+    void close() noexcept {
+        if (!data_) return;
+#if defined(_WIN32)
+        ::UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const unsigned char* data() const noexcept { return data_; }
+    std::size_t          size() const noexcept { return size_; }
+
+private:
+    const unsigned char* data_ = nullptr;
+    std::size_t          size_ = 0;
+
+    static bool fail(std::string* error, std::string message) {
+        if (error) *error = std::move(message);
+        return false;
+    }
+};
+
+enum class ReplaceResult { unchanged, written, failed };
+
+/// Makes `path` hold `contents`.  A file that already does is left
+/// untouched, so its mtime -- and everything a build tool derives from it
+/// -- stays the same; otherwise the contents go to `path`.tmp, which is
+/// renamed over `path` so readers never see a partial file.
+inline ReplaceResult replace_file_if_changed(const std::string& path,
+                                             std::string_view contents,
+                                             std::ios::openmode mode = std::ios::binary,
+                                             std::string* error = nullptr) {
+    {
+        std::ifstream in(path, mode);
+        if (in) {
+            std::string current((std::istreambuf_iterator<char>(in)),
+                                std::istreambuf_iterator<char>());
+            if (current == contents) return ReplaceResult::unchanged;
+        }
+    }
+
+    const std::string tmp = path + ".tmp";
+    std::error_code ec;
+    {
+        std::ofstream out(tmp, mode | std::ios::trunc);
+        if (!out.is_open()) {
+            if (error) *error = "cannot open " + tmp + " for writing";
+            return ReplaceResult::failed;
+        }
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        out.close();
+        if (!out) {
+            if (error) *error = "cannot write " + tmp;
+            std::filesystem::remove(tmp, ec);
+            return ReplaceResult::failed;
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        if (error) *error = "cannot replace " + path + ": " + ec.message();
+        std::filesystem::remove(tmp, ec);
+        return ReplaceResult::failed;
+    }
+    return ReplaceResult::written;
+}
+
+} // namespace detail
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_TOOLS_DETAIL_MAPPED_FILE_HPP
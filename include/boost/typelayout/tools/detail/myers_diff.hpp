@@ -0,0 +1,151 @@
+// myers_matches(a, b) -- longest common subsequence of two key sequences
+// by Myers' O(ND) difference algorithm, in linear space.  Used by
+// CompatReporter's field diffs.
+//
+// The result lists the matched index pairs (i, j), a[i] == b[j], in
+// increasing order; every index not listed is a deletion (a) or an
+// insertion (b).  Time is O((N + M) D) for D edits after the common
+// prefix and suffix are stripped, so two records that differ in a few
+// fields diff in near-linear time however long they are.  Space is
+// O(N + M): the middle snake of each subproblem is found with one
+// forward and one reverse frontier and the halves are solved separately.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_DETAIL_MYERS_DIFF_HPP
+#define BOOST_TYPELAYOUT_TOOLS_DETAIL_MYERS_DIFF_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace compat {
+namespace detail {
+
+using diff_match = std::pair<std::size_t, std::size_t>;
+
+class MyersDiff {
+public:
+    MyersDiff(const std::vector<std::uint64_t>& a, const std::vector<std::uint64_t>& b)
+        : a_(a), b_(b) {
+        const std::size_t frontier = a.size() + b.size() + 4;
+        fwd_.resize(frontier);
+        rev_.resize(frontier);
+    }
+
+    std::vector<diff_match> run() {
+        matches_.clear();
+        solve(0, a_.size(), 0, b_.size());
+        return std::move(matches_);
+    }
+
+private:
+    const std::vector<std::uint64_t>& a_;
+    const std::vector<std::uint64_t>& b_;
+    std::vector<std::ptrdiff_t>       fwd_;   // furthest x per diagonal, forward
+    std::vector<std::ptrdiff_t>       rev_;   // same, from the end
+    std::vector<diff_match>           matches_;
+
+    struct Snake {
+        std::size_t x, y, u, v;   // diagonal run [x, u) x [y, v)
+        std::size_t d;            // edit distance of the subproblem
+    };
+
+    // Solve a_[a0, a1) against b_[b0, b1), appending matches in order.
+    void solve(std::size_t a0, std::size_t a1, std::size_t b0, std::size_t b1) {
+        while (a0 < a1 && b0 < b1 && a_[a0] == b_[b0]) matches_.emplace_back(a0++, b0++);
+        std::size_t suffix = 0;
+        while (a0 < a1 - suffix && b0 < b1 - suffix &&
+               a_[a1 - suffix - 1] == b_[b1 - suffix - 1])
+            ++suffix;
+        a1 -= suffix;
+        b1 -= suffix;
+
+        if (a0 < a1 && b0 < b1) {
+            const Snake s = middle_snake(a0, a1, b0, b1);
+            if (s.d > 1) {
+                solve(a0, s.x, b0, s.y);
+                for (std::size_t x = s.x, y = s.y; x < s.u; ++x, ++y)
+                    matches_.emplace_back(x, y);
+                solve(s.u, a1, s.v, b1);
+            } else {
+                // One insertion or deletion left: everything else pairs up.
+                for (std::size_t x = a0, y = b0; x < a1 && y < b1;) {
+                    if (a_[x] == b_[y]) matches_.emplace_back(x++, y++);
+                    else if (a1 - a0 > b1 - b0) ++x;
+                    else ++y;
+                }
+            }
+        }
+
+        for (std::size_t k = 0; k < suffix; ++k) matches_.emplace_back(a1 + k, b1 + k);
+    }
+
+    Snake middle_snake(std::size_t a0, std::size_t a1, std::size_t b0, std::size_t b1) {
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(a1 - a0);
+        const std::ptrdiff_t m = static_cast<std::ptrdiff_t>(b1 - b0);
+        const std::ptrdiff_t delta = n - m;
+        const bool odd = (delta & 1) != 0;
+        const std::ptrdiff_t max_d = (n + m + 1) / 2;
+        const std::ptrdiff_t off = max_d + 1;   // diagonal k lives at [k + off]
+        fwd_[static_cast<std::size_t>(off + 1)] = 0;
+        rev_[static_cast<std::size_t>(off + 1)] = 0;
+        auto at = [off](std::vector<std::ptrdiff_t>& v, std::ptrdiff_t k) -> std::ptrdiff_t& {
+            return v[static_cast<std::size_t>(k + off)];
+        };
+        auto a = [&](std::ptrdiff_t i) { return a_[a0 + static_cast<std::size_t>(i)]; };
+        auto b = [&](std::ptrdiff_t j) { return b_[b0 + static_cast<std::size_t>(j)]; };
+        auto pos = [](std::size_t base, std::ptrdiff_t i) {
+            return base + static_cast<std::size_t>(i);
+        };
+
+        for (std::ptrdiff_t d = 0; d <= max_d; ++d) {
+            for (std::ptrdiff_t k = -d; k <= d; k += 2) {
+                std::ptrdiff_t x = (k == -d || (k != d && at(fwd_, k - 1) < at(fwd_, k + 1)))
+                                       ? at(fwd_, k + 1)
+                                       : at(fwd_, k - 1) + 1;
+                std::ptrdiff_t y = x - k;
+                const std::ptrdiff_t xs = x, ys = y;
+                while (x < n && y < m && a(x) == b(y)) ++x, ++y;
+                at(fwd_, k) = x;
+                const std::ptrdiff_t rk = delta - k;
+                if (odd && rk >= -(d - 1) && rk <= d - 1 && x + at(rev_, rk) >= n)
+                    return {pos(a0, xs), pos(b0, ys), pos(a0, x), pos(b0, y),
+                            static_cast<std::size_t>(2 * d - 1)};
+            }
+            for (std::ptrdiff_t k = -d; k <= d; k += 2) {
+                std::ptrdiff_t x = (k == -d || (k != d && at(rev_, k - 1) < at(rev_, k + 1)))
+                                       ? at(rev_, k + 1)
+                                       : at(rev_, k - 1) + 1;
+                std::ptrdiff_t y = x - k;
+                const std::ptrdiff_t xs = x, ys = y;
+                while (x < n && y < m && a(n - x - 1) == b(m - y - 1)) ++x, ++y;
+                at(rev_, k) = x;
+                const std::ptrdiff_t fk = delta - k;
+                if (!odd && fk >= -d && fk <= d && x + at(fwd_, fk) >= n)
+                    return {pos(a0, n - x), pos(b0, m - y), pos(a0, n - xs), pos(b0, m - ys),
+                            static_cast<std::size_t>(2 * d)};
+            }
+        }
+        return {a0, b0, a0, b0, static_cast<std::size_t>(n + m)};   // not reached
+    }
+};
+
+/// Matched index pairs of a longest common subsequence of `a` and `b`.
+inline std::vector<diff_match> myers_matches(const std::vector<std::uint64_t>& a,
+                                             const std::vector<std::uint64_t>& b) {
+    return MyersDiff(a, b).run();
+}
+
+} // namespace detail
+} // namespace compat
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_TOOLS_DETAIL_MYERS_DIFF_HPP
@@ -0,0 +1,108 @@
+// NameIndex -- open-addressed name lookup used by CompatReporter's
+// per-platform tables and by CompatCache.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_DETAIL_NAME_INDEX_HPP
+#define BOOST_TYPELAYOUT_TOOLS_DETAIL_NAME_INDEX_HPP
+
+#include <boost/typelayout/detail/layout_hash.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace compat {
+namespace detail {
+
+inline std::uint64_t name_hash(std::string_view name) noexcept {
+    return typelayout::detail::fnv1a_64(name);
+}
+
+/// Open-addressed set of names, stored as positions into a caller-owned
+/// sequence (`name_at(pos)` yields the name).  Slots keep the full 64-bit
+/// hash, so a probe compares strings only on a hash hit.  The table
+/// doubles when it would exceed load factor 1/2.
+class NameIndex {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// Empties the index, sized for `n` names without rehashing.
+    void reserve(std::size_t n) {
+        std::size_t cap = 16;
+        while (cap < 2 * n) cap *= 2;
+        slots_.assign(cap, Slot{0, 0});
+        mask_ = cap - 1;
+        size_ = 0;
+    }
+
+    /// Position of `name`, inserting `pos` first if absent.
+    template <typename NameAt>
+    std::size_t insert(std::string_view name, std::uint64_t hash,
+                       std::size_t pos, NameAt&& name_at) {
+        if (2 * (size_ + 1) > slots_.size()) grow();
+        for (std::size_t i = start(hash);; i = (i + 1) & mask_) {
+            Slot& s = slots_[i];
+            if (s.pos1 == 0) {
+                s = Slot{hash, pos + 1};
+                ++size_;
+                return pos;
+            }
+            if (s.hash == hash && name_at(s.pos1 - 1) == name)
+                return s.pos1 - 1;
+        }
+    }
+
+    /// Position of `name`, or npos.
+    template <typename NameAt>
+    std::size_t find(std::string_view name, std::uint64_t hash,
+                     NameAt&& name_at) const {
+        if (slots_.empty()) return npos;
+        for (std::size_t i = start(hash);; i = (i + 1) & mask_) {
+            const Slot& s = slots_[i];
+            if (s.pos1 == 0) return npos;
+            if (s.hash == hash && name_at(s.pos1 - 1) == name)
+                return s.pos1 - 1;
+        }
+    }
+
+private:
+    struct Slot {
+        std::uint64_t hash;
+        std::size_t   pos1;   // position + 1; 0 = empty
+    };
+
+    std::size_t start(std::uint64_t hash) const noexcept {
+        return static_cast<std::size_t>(hash ^ (hash >> 32)) & mask_;
+    }
+
+    void grow() {
+        std::vector<Slot> old = std::move(slots_);
+        std::size_t cap = old.empty() ? 16 : 2 * old.size();
+        slots_.assign(cap, Slot{0, 0});
+        mask_ = cap - 1;
+        for (const Slot& s : old) {
+            if (s.pos1 == 0) continue;
+            std::size_t i = start(s.hash);
+            while (slots_[i].pos1 != 0) i = (i + 1) & mask_;
+            slots_[i] = s;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::size_t       mask_ = 0;
+    std::size_t       size_ = 0;
+};
+
+} // namespace detail
+} // namespace compat
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_TOOLS_DETAIL_NAME_INDEX_HPP
@@ -0,0 +1,110 @@
+// parallel_for(count, threads, fn) -- run fn(begin, end) over [0, count)
+// on up to `threads` threads.  Used by CompatReporter's parallel mode.
+//
+// Work is claimed in fixed-size chunks from one shared counter, so a
+// thread that finishes early keeps taking chunks from the rest; every
+// index is visited exactly once and callers write results by index, which
+// keeps output independent of scheduling.  threads <= 1 (or a range of one
+// chunk) runs inline on the calling thread.  The first exception thrown by
+// fn is rethrown on the calling thread after all workers have joined.
+//
+// Built with BOOST_TYPELAYOUT_NO_THREADS (the CMake targets define it when
+// no thread library is found), every call runs inline: same results,
+// one thread.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_DETAIL_PARALLEL_FOR_HPP
+#define BOOST_TYPELAYOUT_TOOLS_DETAIL_PARALLEL_FOR_HPP
+
+#include <cstddef>
+
+#if !defined(BOOST_TYPELAYOUT_NO_THREADS)
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+namespace compat {
+namespace detail {
+
+#if defined(BOOST_TYPELAYOUT_NO_THREADS)
+
+inline unsigned resolve_threads(unsigned) noexcept { return 1; }
+
+template <typename Fn>
+void parallel_for(std::size_t count, unsigned, Fn&& fn, std::size_t = 64) {
+    if (count != 0) fn(std::size_t{0}, count);
+}
+
+#else
+
+/// Thread count for a requested value: 0 means one per hardware thread.
+inline unsigned resolve_threads(unsigned requested) noexcept {
+    if (requested != 0) return requested;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw != 0 ? hw : 1;
+}
+
+template <typename Fn>
+void parallel_for(std::size_t count, unsigned threads, Fn&& fn,
+                  std::size_t grain = 64) {
+    if (grain == 0) grain = 1;
+    const std::size_t chunks = (count + grain - 1) / grain;
+    const std::size_t workers =
+        std::min<std::size_t>(resolve_threads(threads), chunks);
+    if (workers <= 1) {
+        if (count != 0) fn(std::size_t{0}, count);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool>        failed{false};
+    std::exception_ptr       error;
+    std::mutex               error_mutex;
+
+    auto work = [&] {
+        try {
+            for (;;) {
+                if (failed.load(std::memory_order_relaxed)) return;
+                std::size_t c = next.fetch_add(1, std::memory_order_relaxed);
+                if (c >= chunks) return;
+                std::size_t begin = c * grain;
+                fn(begin, std::min(count, begin + grain));
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+            failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    try {
+        for (std::size_t i = 1; i < workers; ++i) pool.emplace_back(work);
+    } catch (...) {
+        // Could not start every thread: the ones running plus this one
+        // still drain the counter.
+    }
+    work();
+    for (auto& t : pool) t.join();
+    if (error) std::rethrow_exception(error);
+}
+
+#endif // BOOST_TYPELAYOUT_NO_THREADS
+
+} // namespace detail
+} // namespace compat
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_TOOLS_DETAIL_PARALLEL_FOR_HPP
@@ -11,6 +11,7 @@
 #define BOOST_TYPELAYOUT_TOOLS_SAFETY_LEVEL_HPP
 
 #include <boost/typelayout/detail/sig_parser.hpp>
+#include <boost/typelayout/detail/sig_compact.hpp>
 
 namespace boost {
 namespace typelayout {
@@ -42,30 +43,31 @@ constexpr const char* safety_level_name(SafetyLevel level) noexcept {
     return "?";
 }
 
-/// Runtime classify: scans signature string for safety level.
-inline SafetyLevel classify_signature(std::string_view sig) noexcept {
-    using ::boost::typelayout::v1::detail::sig_contains_token;
-
-    if (sig_contains_token(sig, "O("))
+/// O(1) classify from structural flags (TypeSignature<T> /
+/// layout_traits<T>::flags at compile time).
+constexpr SafetyLevel classify_flags(
+        ::boost::typelayout::v1::detail::SigFlags flags) noexcept {
+    if (flags.has_opaque)
         return SafetyLevel::Opaque;
-
-    if (::boost::typelayout::v1::detail::sig_has_pointer(sig))
+    if (!flags.pointer_free)
         return SafetyLevel::PointerRisk;
-
-    bool has_platform_variant =
-        sig.find("bits<") != std::string_view::npos ||
-        sig.find("wchar[") != std::string_view::npos ||
-        sig_contains_token(sig, "fld64[") ||
-        sig_contains_token(sig, "fld80[") ||
-        sig_contains_token(sig, "fld106[") ||
-        sig_contains_token(sig, "fld128[");
-
-    if (has_platform_variant)
+    if (flags.has_bitfield || flags.has_platform_variant)
         return SafetyLevel::PlatformVariant;
-
     return SafetyLevel::TrivialSafe;
 }
 
+/// Runtime classify of a signature string (full or compact form).  The
+/// scan stops at the first opaque type: nothing outranks it.
+inline SafetyLevel classify_signature(std::string_view sig) {
+    namespace tl = ::boost::typelayout::v1;
+    std::string full;
+    if (tl::is_compact_signature(sig)) {
+        full = tl::expand_signature(sig);
+        if (!full.empty()) sig = full;
+    }
+    return classify_flags(tl::detail::sig_scan_flags(sig, tl::detail::opaque_sig_flags));
+}
+
 } // namespace detail
 } // namespace compat
 } // inline namespace v1
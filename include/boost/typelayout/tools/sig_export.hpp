@@ -10,18 +10,31 @@
 #define BOOST_TYPELAYOUT_TOOLS_SIG_EXPORT_HPP
 
 #include <boost/typelayout.hpp>
+#include <boost/typelayout/signature_table.hpp>
+#include <boost/typelayout/tools/abi_model.hpp>
 #include <boost/typelayout/tools/platform_detect.hpp>
 #include <boost/typelayout/tools/sig_types.hpp>
+#include <boost/typelayout/tools/sigdb.hpp>
 #include <boost/typelayout/tools/detail/foreach.hpp>
+#include <boost/typelayout/tools/detail/mapped_file.hpp>
 
+#include <deque>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <chrono>
 #include <ctime>
+#include <cstdint>
+#include <cstdio>
 #include <algorithm>
+#include <array>
 #include <filesystem>
+#include <utility>
 
 namespace boost {
 namespace typelayout {
@@ -30,10 +43,32 @@ inline namespace v1 {
 namespace detail {
 
 /// One registered type's name + signature (internal to SigExporter).
+/// Signatures view static constexpr storage (layout_signature_v<T> or a
+/// signature_table pool); names view static storage or a string owned
+/// by the exporter.
 struct ExportEntry {
-    std::string name;
-    std::string layout_sig;
-    bool        byte_copy_safe;
+    std::string_view name;
+    std::string_view layout_sig;
+    bool             byte_copy_safe;
+    std::uint64_t    layout_hash;
+};
+
+} // namespace detail
+
+/// Class selection for SigExporter::add_namespace.
+enum class namespace_filter {
+    trivially_copyable,   // every trivially copyable class; others are skipped
+    annotated,            // classes annotated [[=export_layout]] (must be
+                          // trivially copyable)
+};
+
+namespace detail {
+
+// Static names of namespace_classes_v<NS, AnnotatedOnly>[Is...].
+template <std::meta::info NS, bool AnnotatedOnly, std::size_t... Is>
+inline constexpr std::array<std::string_view, sizeof...(Is)> namespace_class_names_v = {
+    std::string_view(std::define_static_string(
+        std::meta::identifier_of(namespace_classes_v<NS, AnnotatedOnly>[Is])))...
 };
 
 } // namespace detail
@@ -53,6 +88,15 @@ public:
         , display_name_(platform_name)
     {}
 
+    /// Export for another platform: its name and metadata come from
+    /// `target`, and its signatures are added with add_signature()
+    /// (AbiEmulator::predict, tools/abi_emulate.hpp).
+    SigExporter(const AbiModel& target, const std::string& display_name)
+        : platform_name_(target.platform_name)
+        , display_name_(display_name)
+        , abi_(target)
+    {}
+
     /// Register a type for export.
     template <typename T>
     void add(const std::string& name) {
@@ -62,13 +106,7 @@ public:
             "memcpy'd, and the cross-platform compatibility report cannot detect this "
             "from the signature string alone.");
 
-        constexpr auto layout = get_layout_signature<T>();
-
-        entries_.push_back({
-            name,
-            std::string(layout.value, layout.size),  // .size is exact capacity (no scan needed)
-            is_byte_copy_safe_v<T>
-        });
+        push_entry<T>(name);
     }
 
     /// Register a relocatable type for export (no trivially_copyable check).
@@ -82,56 +120,192 @@ public:
             "SigExporter::add_relocatable<T>: type must be pointer-free "
             "(all opaque members must have pointer_free = true).");
 
-        constexpr auto layout = get_layout_signature<T>();
+        push_entry<T>(name);
+    }
 
-        entries_.push_back({
-            name,
-            std::string(layout.value, layout.size),
-            is_byte_copy_safe_v<T>
-        });
+    /// Register a signature computed at run time (arch prefix included);
+    /// the exporter keeps a copy.
+    void add_signature(const std::string& name, std::string layout_sig,
+                       bool byte_copy_safe) {
+        const std::string& sig = owned_sigs_.emplace_back(std::move(layout_sig));
+        entries_.push_back({owned_names_.emplace_back(name), sig, byte_copy_safe,
+                            layout_hash(sig)});
+    }
+
+    /// Register Ts... from one signature_table<Ts...>: the entries view the
+    /// table's static pool and `names`, so no per-type heap allocation is
+    /// made.  `names` (one per type, in order) must outlive the exporter.
+    template <typename... Ts>
+    void add_table(std::span<const std::string_view, sizeof...(Ts)> names) {
+        static_assert((std::is_trivially_copyable_v<Ts> && ...),
+            "SigExporter::add_table<Ts...>: only trivially copyable types should be "
+            "exported (see SigExporter::add).");
+
+        using table = signature_table<Ts...>;
+        entries_.reserve(entries_.size() + table::size);
+        for (std::size_t i = 0; i < table::size; ++i) {
+            const signature_table_row& row = table::row(i);
+            entries_.push_back({names[i], table::signature(i),
+                                row.byte_copy_safe, row.layout_hash});
+        }
     }
 
+    /// Register every named, complete class declared directly in the
+    /// namespace reflected by NS, e.g. add_namespace<^^wire>().  All of
+    /// them go through one signature_table, under their unqualified names.
+    /// Nested namespaces are not entered; register them separately.  No
+    /// macro expansion is involved, so there is no limit on the number of
+    /// types.
+    ///
+    /// The unqualified names must be unique across the exporter: if one is
+    /// already registered (wire::Header, then wire::md::Header), nothing
+    /// from NS is added and false is returned, with the clash on stderr.
+    template <std::meta::info NS,
+              namespace_filter Filter = namespace_filter::trivially_copyable>
+    bool add_namespace() {
+        constexpr bool annotated = Filter == namespace_filter::annotated;
+        return add_namespace_classes<NS, annotated>(std::make_index_sequence<
+            detail::namespace_classes_v<NS, annotated>.size()>{});
+    }
+
+    /// Write signatures in the canonical compact form (runs and
+    /// back-references, see detail/sig_compact.hpp) instead of the full
+    /// form.  Layout hashes are unaffected; CompatReporter and
+    /// layout_match accept either form.
+    void set_compact(bool compact) { compact_ = compact; }
+    bool compact() const { return compact_; }
+
+    /// Reproducible output: the "Generated:" timestamp is replaced by a
+    /// digest of the file contents and the per-type constants are written in
+    /// name order, so re-exporting unchanged layouts yields the same bytes.
+    void set_deterministic(bool deterministic) { deterministic_ = deterministic; }
+    bool deterministic() const { return deterministic_; }
+
+    /// Split output for compile-time-only checks: the platform metadata,
+    /// byte-copy flags and layout hashes go to a hash header
+    /// (<platform>.sighash.hpp, render_hash_header()), and the .sig.hpp
+    /// includes it and adds only the signature strings.  A TU that only
+    /// uses TYPELAYOUT_ASSERT_COMPAT includes the hash header and parses no
+    /// signatures; TYPELAYOUT_CHECK_COMPAT reports still include .sig.hpp.
+    void set_hash_header(bool split) { hash_header_ = split; }
+    bool hash_header() const { return hash_header_; }
+
+    /// File name of the hash header, as included by the split .sig.hpp.
+    std::string hash_header_name() const { return platform_name_ + ".sighash.hpp"; }
+
     const std::string& platform_name() const { return platform_name_; }
     const std::string& display_name() const { return display_name_; }
     const std::vector<detail::ExportEntry>& entries() const { return entries_; }
 
+    /// Contents of the .sig.hpp header.
+    std::string render() const {
+        return render_part(hash_header_ ? Part::signatures : Part::whole);
+    }
+
+    /// Contents of the hash header (see set_hash_header): metadata and
+    /// `hash_types`, whose entries carry no signature (layout_sig is null),
+    /// behind get_hash_info().
+    std::string render_hash_header() const {
+        return render_part(Part::hashes);
+    }
+
     /// Write the .sig.hpp header. Returns 0 on success.
+    ///
+    /// An existing file with the same contents is left untouched (same
+    /// mtime, so build tools do not recompile its includers); otherwise
+    /// the new contents go to a temporary file that is renamed over `path`.
     int write(const std::string& path) const {
-        std::ofstream out(path);
-        if (!out.is_open()) {
-            std::cerr << "Error: cannot open " << path << " for writing\n";
-            return 1;
+        return write_file(path, render(), std::ios::openmode{});
+    }
+
+    /// Write the hash header (see set_hash_header), with the same
+    /// write-if-changed rule as write(). Returns 0 on success.
+    int write_hash_header(const std::string& path) const {
+        return write_file(path, render_hash_header(), std::ios::openmode{});
+    }
+
+    /// Contents of the binary signature database (tools/sigdb.hpp): the
+    /// same platform metadata and types as the header, sorted by name.
+    std::string render_sigdb() const {
+        const std::string arch_prefix(abi_.arch_prefix());
+        const PlatformInfo meta{platform_name_.c_str(), arch_prefix.c_str(), nullptr, 0,
+                                abi_.pointer_size, abi_.sizeof_long, abi_.sizeof_wchar_t,
+                                abi_.sizeof_long_double, abi_.max_align, abi_.data_model};
+        SigDbWriter db(meta);
+        db.set_compact(compact_);
+        std::string compact;
+        for (const auto& e : entries_) {
+            if (compact_) compact = compact_signature(e.layout_sig);
+            db.add(e.name, compact_ ? std::string_view(compact) : e.layout_sig,
+                   e.byte_copy_safe, e.layout_hash);
         }
+        return db.image();
+    }
 
-        write_header(out);
-        write_platform_metadata(out);
-        write_type_signatures(out);
-        write_type_registry(out);
-        write_platform_info(out);
-        write_footer(out);
-
-        out.close();
-        std::cout << "Exported " << entries_.size() << " type(s) to " << path
-                  << " [" << platform_name_ << "]\n";
-        return 0;
+    /// Write the .sigdb database (CompatReporter::add_platform_mmap), with
+    /// the same write-if-changed rule as write(). Returns 0 on success.
+    int write_sigdb(const std::string& path) const {
+        return write_file(path, render_sigdb(), std::ios::binary);
     }
 
     /// Write to stdout.
     void write_stdout() const {
-        write_header(std::cout);
-        write_platform_metadata(std::cout);
-        write_type_signatures(std::cout);
-        write_type_registry(std::cout);
-        write_platform_info(std::cout);
-        write_footer(std::cout);
+        std::cout << render();
     }
 
 private:
     std::string platform_name_;
     std::string display_name_;
     std::vector<detail::ExportEntry> entries_;
+    std::deque<std::string> owned_names_;   // names passed to add / add_relocatable
+    std::deque<std::string> owned_sigs_;    // signatures passed to add_signature
+    AbiModel abi_ = host_abi_model();       // platform metadata
+    bool compact_ = false;
+    bool deterministic_ = false;
+    bool hash_header_ = false;
+
+    // What a rendered header holds: everything (the default), the hash
+    // header, or the split .sig.hpp that includes it.
+    enum class Part { whole, hashes, signatures };
+
+    template <std::meta::info NS, bool Annotated, std::size_t... Is>
+    bool add_namespace_classes(std::index_sequence<Is...>) {
+        static_assert(!Annotated ||
+            (std::is_trivially_copyable_v<
+                 typename [:detail::namespace_classes_v<NS, Annotated>[Is]:]> && ...),
+            "SigExporter::add_namespace<NS, namespace_filter::annotated>: every class "
+            "annotated [[=export_layout]] must be trivially copyable.");
+
+        constexpr auto& names = detail::namespace_class_names_v<NS, Annotated, Is...>;
+        std::unordered_set<std::string_view> taken;
+        taken.reserve(entries_.size());
+        for (const auto& e : entries_) taken.insert(e.name);
+        for (std::string_view name : names) {
+            if (taken.count(name)) {
+                std::cerr << "Error: add_namespace<"
+                          << std::define_static_string(std::meta::display_string_of(NS))
+                          << ">: a type named " << name
+                          << " is already registered; exported names are unqualified "
+                             "and must be unique\n";
+                return false;
+            }
+        }
+        add_table<typename [:detail::namespace_classes_v<NS, Annotated>[Is]:]...>(names);
+        return true;
+    }
 
-    static std::string escape(const std::string& s) {
+    template <typename T>
+    void push_entry(const std::string& name) {
+        constexpr auto& layout = detail::layout_signature_v<T>;
+        entries_.push_back({
+            owned_names_.emplace_back(name),
+            std::string_view(layout.value, layout.size),  // static storage, no copy
+            is_byte_copy_safe_v<T>,
+            get_layout_hash<T>()
+        });
+    }
+
+    static std::string escape(std::string_view s) {
         std::string result;
         result.reserve(s.size() + 8);
         for (char c : s) {
@@ -143,14 +317,22 @@ private:
         return result;
     }
 
-    std::string include_guard() const {
-        std::string guard = "BOOST_TYPELAYOUT_SIG_" + platform_name_;
+    std::string include_guard(Part part) const {
+        std::string guard = (part == Part::hashes ? "BOOST_TYPELAYOUT_SIGHASH_"
+                                                  : "BOOST_TYPELAYOUT_SIG_") + platform_name_;
         std::transform(guard.begin(), guard.end(), guard.begin(),
             [](unsigned char c) { return std::toupper(c); });
         guard += "_HPP";
         return guard;
     }
 
+    static std::string hex64(std::uint64_t v) {
+        char buf[19];
+        std::snprintf(buf, sizeof(buf), "0x%016llx",
+                      static_cast<unsigned long long>(v));
+        return buf;
+    }
+
     static std::string timestamp() {
         auto now = std::chrono::system_clock::now();
         auto time = std::chrono::system_clock::to_time_t(now);
@@ -159,18 +341,83 @@ private:
         return buf;
     }
 
-    void write_header(std::ostream& os) const {
-        std::string guard = include_guard();
+    int write_file(const std::string& path, std::string_view contents,
+                   std::ios::openmode mode) const {
+        std::string error;
+        switch (detail::replace_file_if_changed(path, contents, mode, &error)) {
+        case detail::ReplaceResult::unchanged:
+            std::cout << "Unchanged " << entries_.size() << " type(s) in " << path
+                      << " [" << platform_name_ << "]\n";
+            return 0;
+        case detail::ReplaceResult::written:
+            std::cout << "Exported " << entries_.size() << " type(s) to " << path
+                      << " [" << platform_name_ << "]\n";
+            return 0;
+        case detail::ReplaceResult::failed:
+            break;
+        }
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
+
+    /// Entries in registration order, or stably sorted by name.
+    std::vector<const detail::ExportEntry*> ordered_entries(bool by_name) const {
+        std::vector<const detail::ExportEntry*> order;
+        order.reserve(entries_.size());
+        for (const auto& e : entries_) order.push_back(&e);
+        if (by_name)
+            std::stable_sort(order.begin(), order.end(),
+                             [](const detail::ExportEntry* a, const detail::ExportEntry* b) {
+                                 return a->name < b->name;
+                             });
+        return order;
+    }
+
+    std::string render_part(Part part) const {
+        std::ostringstream body;
+        write_prologue(body, part);
+        if (part != Part::signatures) write_platform_metadata(body);
+        write_type_signatures(body, part);
+        write_type_registry(body, part);
+        write_platform_info(body, part);
+        write_footer(body, part);
+        std::string text = std::move(body).str();
+
+        std::ostringstream os;
+        write_banner(os, text, part);
+        os << text;
+        return std::move(os).str();
+    }
+
+    // `body` is everything after the banner; deterministic output stamps
+    // its digest instead of the export time.
+    void write_banner(std::ostream& os, std::string_view body, Part part) const {
         os << "// AUTO-GENERATED by Boost.TypeLayout Signature Export Tool\n";
         os << "// Platform: " << platform_name_ << " (" << display_name_ << ")\n";
-        os << "// Generated: " << timestamp() << "\n";
+        if (deterministic_)
+            os << "// Content: fnv1a-64 " << hex64(detail::fnv1a_64(body)) << "\n";
+        else
+            os << "// Generated: " << timestamp() << "\n";
         os << "//\n";
-        os << "// This file contains constexpr signature data.\n";
+        if (part == Part::hashes)
+            os << "// This file contains constexpr layout hashes only; the signatures\n"
+               << "// are in " << platform_name_ << ".sig.hpp.\n";
+        else
+            os << "// This file contains constexpr signature data.\n";
+        if (compact_ && part != Part::hashes)
+            os << "// Signatures are in compact form (boost/typelayout/detail/sig_compact.hpp).\n";
         os << "\n";
+    }
+
+    void write_prologue(std::ostream& os, Part part) const {
+        std::string guard = include_guard(part);
         os << "#ifndef " << guard << "\n";
         os << "#define " << guard << "\n";
         os << "\n";
-        os << "#include <boost/typelayout/tools/sig_types.hpp>\n";
+        if (part == Part::signatures)
+            os << "#include \"" << hash_header_name() << "\"\n";
+        else
+            os << "#include <boost/typelayout/tools/sig_types.hpp>\n";
         os << "\n";
         os << "namespace boost { namespace typelayout { namespace platform {\n";
         os << "namespace " << platform_name_ << " {\n";
@@ -178,78 +425,137 @@ private:
     }
 
     void write_platform_metadata(std::ostream& os) const {
-        constexpr auto arch = detail::get_arch_prefix();
-
         os << "// ---- Platform Metadata ----\n";
         os << "\n";
         os << "inline constexpr const char platform_name[] = \""
            << escape(platform_name_) << "\";\n";
         os << "inline constexpr const char arch_prefix[] = \""
-           << std::string(arch.value, arch.length()) << "\";\n";
+           << abi_.arch_prefix() << "\";\n";
         os << "inline constexpr std::size_t pointer_size      = "
-           << sizeof(void*) << ";\n";
+           << abi_.pointer_size << ";\n";
         os << "inline constexpr std::size_t sizeof_long        = "
-           << sizeof(long) << ";\n";
+           << abi_.sizeof_long << ";\n";
         os << "inline constexpr std::size_t sizeof_wchar_t     = "
-           << sizeof(wchar_t) << ";\n";
+           << abi_.sizeof_wchar_t << ";\n";
         os << "inline constexpr std::size_t sizeof_long_double = "
-           << sizeof(long double) << ";\n";
+           << abi_.sizeof_long_double << ";\n";
         os << "inline constexpr std::size_t max_align          = "
-           << alignof(std::max_align_t) << ";\n";
+           << abi_.max_align << ";\n";
         os << "inline constexpr const char data_model[]        = \""
-           << platform::get_data_model() << "\";\n";
+           << abi_.data_model << "\";\n";
         os << "\n";
     }
 
-    void write_type_signatures(std::ostream& os) const {
-        os << "// ---- Type Signatures ----\n";
+    void write_type_signatures(std::ostream& os, Part part) const {
+        os << (part == Part::hashes ? "// ---- Type Hashes ----\n"
+                                    : "// ---- Type Signatures ----\n");
         os << "\n";
 
-        for (const auto& e : entries_) {
+        std::string compact;
+        for (const auto* p : ordered_entries(deterministic_)) {
+            const auto& e = *p;
             os << "// --- " << e.name << " ---\n";
-            os << "inline constexpr const char " << e.name << "_layout[] =\n";
-            os << "    \"" << escape(e.layout_sig) << "\";\n";
-            os << "inline constexpr bool " << e.name
-               << "_byte_copy_safe = " << (e.byte_copy_safe ? "true" : "false") << ";\n";
+            if (part != Part::hashes) {
+                if (compact_) compact = compact_signature(e.layout_sig);
+                os << "inline constexpr const char " << e.name << "_layout[] =\n";
+                os << "    \""
+                   << escape(compact_ ? std::string_view(compact) : e.layout_sig)
+                   << "\";\n";
+            }
+            if (part != Part::signatures) {
+                os << "inline constexpr bool " << e.name
+                   << "_byte_copy_safe = " << (e.byte_copy_safe ? "true" : "false") << ";\n";
+                os << "inline constexpr std::uint64_t " << e.name
+                   << "_layout_hash = " << hex64(e.layout_hash) << "ull;\n";
+            }
             os << "\n";
         }
     }
 
-    void write_type_registry(std::ostream& os) const {
+    // The registry is sorted by name so TYPELAYOUT_ASSERT_COMPAT can pair
+    // types across platforms with a merge-join.
+    void write_type_registry(std::ostream& os, Part part) const {
+        const bool hashes = part == Part::hashes;
         os << "// ---- Type Registry ----\n";
         os << "\n";
-        os << "inline constexpr ::boost::typelayout::TypeEntry types[] = {\n";
-        for (const auto& e : entries_) {
-            os << "    {\"" << escape(e.name) << "\", "
-               << e.name << "_layout, "
-               << e.name << "_byte_copy_safe},\n";
+        os << "inline constexpr ::boost::typelayout::TypeEntry "
+           << (hashes ? "hash_types" : "types") << "[] = {\n";
+        for (const auto* p : ordered_entries(true)) {
+            const auto& e = *p;
+            os << "    {\"" << escape(e.name) << "\", ";
+            if (hashes) os << "nullptr, ";
+            else os << e.name << "_layout, ";
+            os << e.name << "_byte_copy_safe, "
+               << e.name << "_layout_hash},\n";
         }
         os << "};\n";
         os << "\n";
-        os << "inline constexpr std::size_t type_count = "
-           << entries_.size() << ";\n";
+        os << "inline constexpr std::size_t " << (hashes ? "hash_type_count" : "type_count")
+           << " = " << entries_.size() << ";\n";
         os << "\n";
     }
 
-    void write_platform_info(std::ostream& os) const {
+    void write_platform_info(std::ostream& os, Part part) const {
+        const bool hashes = part == Part::hashes;
         os << "// ---- Platform Info Accessor ----\n";
         os << "\n";
-        os << "inline constexpr ::boost::typelayout::PlatformInfo get_platform_info() {\n";
-        os << "    return { platform_name, arch_prefix, types, type_count,\n";
+        os << "inline constexpr ::boost::typelayout::PlatformInfo "
+           << (hashes ? "get_hash_info" : "get_platform_info") << "() {\n";
+        os << "    return { platform_name, arch_prefix, "
+           << (hashes ? "hash_types, hash_type_count" : "types, type_count") << ",\n";
         os << "             pointer_size, sizeof_long, sizeof_wchar_t,\n";
         os << "             sizeof_long_double, max_align, data_model };\n";
         os << "}\n";
         os << "\n";
     }
 
-    void write_footer(std::ostream& os) const {
-        std::string guard = include_guard();
+    void write_footer(std::ostream& os, Part part) const {
+        std::string guard = include_guard(part);
         os << "}}}} // namespace boost::typelayout::platform::" << platform_name_ << "\n";
         os << "\n";
         os << "#endif // " << guard << "\n";
     }
 };
 
+namespace detail {
+
+/// Body of the main() generated by the export macros: write
+/// <dir>/<platform>.sig.hpp, or stdout without a directory argument.
+/// `--deterministic` selects SigExporter::set_deterministic(true);
+/// `--sigdb` also writes <dir>/<platform>.sigdb, and `--hash-header`
+/// splits out <dir>/<platform>.sighash.hpp (SigExporter::set_hash_header).
+inline int run_export(SigExporter& ex, int argc, char* argv[]) {
+    const char* out_dir = nullptr;
+    bool sigdb = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--deterministic") ex.set_deterministic(true);
+        else if (arg == "--sigdb") sigdb = true;
+        else if (arg == "--hash-header") ex.set_hash_header(true);
+        else if (arg.starts_with("--predict")) {
+            std::cerr << "[typelayout] --predict needs TYPELAYOUT_EXPORT_TYPES_PREDICTED "
+                         "(tools/abi_emulate.hpp)\n";
+            return 2;
+        }
+        else if (!out_dir) out_dir = argv[i];
+    }
+    if (out_dir) {
+        std::string dir = out_dir;
+        std::filesystem::create_directories(dir);
+        std::string path = dir;
+        if (path.back() != '/') path += '/';
+        int rc = ex.hash_header() ? ex.write_hash_header(path + ex.hash_header_name()) : 0;
+        path += ex.platform_name();
+        if (rc == 0) rc = ex.write(path + ".sig.hpp");
+        if (rc == 0 && sigdb) rc = ex.write_sigdb(path + ".sigdb");
+        return rc;
+    }
+    ex.write_stdout();
+    return 0;
+}
+
+} // namespace detail
+
 } // inline namespace v1
 } // namespace typelayout
 } // namespace boost
@@ -258,19 +564,23 @@ private:
 // TYPELAYOUT_REGISTER_TYPES(exporter, ...)
 //
 // Register types on an existing SigExporter instance. Does NOT generate main().
+// All types go through one signature_table<...>; the type names are a
+// static array, so registration allocates once, not once per type.
 // ---------------------------------------------------------------------------
-#define TYPELAYOUT_DETAIL_ADD_TYPE(T) ex.add<T>(#T);
+#define TYPELAYOUT_DETAIL_TYPE_NAME(T) std::string_view(#T),
 
-// NOTE: TYPELAYOUT_REGISTER_TYPES temporarily binds `exporter_var` to a
-// local reference named `ex` so that the TYPELAYOUT_DETAIL_ADD_TYPE helper
-// macro (shared with TYPELAYOUT_EXPORT_TYPES) resolves correctly.
-#define TYPELAYOUT_REGISTER_TYPES(exporter_var, ...)                    \
+#define TYPELAYOUT_DETAIL_ADD_TYPES(exporter_var, ...)                  \
     do {                                                                \
-        auto& ex = (exporter_var);                                      \
-        TYPELAYOUT_DETAIL_FOR_EACH(TYPELAYOUT_DETAIL_ADD_TYPE,          \
-                                   __VA_ARGS__)                         \
+        static constexpr std::string_view typelayout_type_names_[] = {  \
+            TYPELAYOUT_DETAIL_FOR_EACH(TYPELAYOUT_DETAIL_TYPE_NAME,     \
+                                       __VA_ARGS__)                     \
+        };                                                              \
+        (exporter_var).add_table<__VA_ARGS__>(typelayout_type_names_);  \
     } while (0)
 
+#define TYPELAYOUT_REGISTER_TYPES(exporter_var, ...)                    \
+    TYPELAYOUT_DETAIL_ADD_TYPES(exporter_var, __VA_ARGS__)
+
 // ---------------------------------------------------------------------------
 // TYPELAYOUT_EXPORT_TYPES(...)
 //
@@ -280,18 +590,30 @@ private:
 #define TYPELAYOUT_EXPORT_TYPES(...)                                    \
     int main(int argc, char* argv[]) {                                  \
         ::boost::typelayout::SigExporter ex;                            \
-        TYPELAYOUT_DETAIL_FOR_EACH(TYPELAYOUT_DETAIL_ADD_TYPE,          \
+        TYPELAYOUT_DETAIL_ADD_TYPES(ex, __VA_ARGS__);                   \
+        return ::boost::typelayout::detail::run_export(ex, argc, argv); \
+    }
+
+// ---------------------------------------------------------------------------
+// TYPELAYOUT_EXPORT_NAMESPACES(...)
+//
+// Like TYPELAYOUT_EXPORT_TYPES, for every trivially copyable class of the
+// listed namespaces (SigExporter::add_namespace).  Arguments are namespace
+// reflections:
+//
+//   TYPELAYOUT_EXPORT_NAMESPACES(^^wire, ^^wire::md)
+//
+// The 32-argument limit applies to namespaces, not to the types in them.
+// A type name that two of the namespaces share fails the export.
+// ---------------------------------------------------------------------------
+#define TYPELAYOUT_DETAIL_ADD_NAMESPACE(ns) if (!ex.add_namespace<ns>()) return 1;
+
+#define TYPELAYOUT_EXPORT_NAMESPACES(...)                               \
+    int main(int argc, char* argv[]) {                                  \
+        ::boost::typelayout::SigExporter ex;                            \
+        TYPELAYOUT_DETAIL_FOR_EACH(TYPELAYOUT_DETAIL_ADD_NAMESPACE,     \
                                    __VA_ARGS__)                         \
-        if (argc >= 2) {                                                \
-            std::string dir = argv[1];                                  \
-            std::filesystem::create_directories(dir);                   \
-            std::string path = dir;                                     \
-            if (path.back() != '/') path += '/';                        \
-            path += ex.platform_name() + ".sig.hpp";                    \
-            return ex.write(path);                                      \
-        }                                                               \
-        ex.write_stdout();                                              \
-        return 0;                                                       \
+        return ::boost::typelayout::detail::run_export(ex, argc, argv); \
     }
 
 #endif // BOOST_TYPELAYOUT_TOOLS_SIG_EXPORT_HPP
@@ -7,6 +7,7 @@
 #define BOOST_TYPELAYOUT_TOOLS_SIG_TYPES_HPP
 
 #include <cstddef>
+#include <cstdint>
 
 namespace boost {
 namespace typelayout {
@@ -16,6 +17,7 @@ struct TypeEntry {
     const char* name;
     const char* layout_sig;
     bool        byte_copy_safe;   // is_byte_copy_safe_v<T>, computed at export time
+    std::uint64_t layout_hash = 0; // layout_hash(layout_sig); 0 = not exported
 };
 
 struct PlatformInfo {
@@ -0,0 +1,322 @@
+// Binary signature database (.sigdb): one platform's exported signatures
+// in a form that can be memory-mapped and compared without compiling a
+// .sig.hpp.
+//
+//   SigDbWriter  -- builds the file image (SigExporter::write_sigdb)
+//   SigDb        -- maps a .sigdb and presents it as a PlatformInfo
+//                   (CompatReporter::add_platform_mmap)
+//
+// Layout, version 1 (host byte order, recorded in the header; offsets are
+// from the start of the file):
+//
+//   SigDbHeader                      magic, version, sizes, platform metadata
+//   SigDbType[type_count]            at types_offset, sorted by name
+//   string pool                      at pool_offset; every string is
+//                                    followed by a NUL
+//
+// Names and signatures are used in place: a mapped database allocates one
+// TypeEntry per type and copies no strings.  Every offset is checked when
+// the file is opened, so a truncated or corrupt file is rejected rather
+// than read out of bounds.  The stored hashes are not recomputed then --
+// that reads every string and expands every compact signature -- but
+// verify() (or open() with verify_hashes) checks each against the string
+// it was computed from.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BOOST_TYPELAYOUT_TOOLS_SIGDB_HPP
+#define BOOST_TYPELAYOUT_TOOLS_SIGDB_HPP
+
+#include <boost/typelayout/detail/layout_hash.hpp>
+#include <boost/typelayout/detail/sig_compact.hpp>
+#include <boost/typelayout/tools/sig_types.hpp>
+#include <boost/typelayout/tools/detail/mapped_file.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace typelayout {
+inline namespace v1 {
+
+inline constexpr char          sigdb_magic[8]      = {'T', 'L', 'S', 'I', 'G', 'D', 'B', '\0'};
+inline constexpr std::uint32_t sigdb_version       = 1;
+inline constexpr std::uint32_t sigdb_byte_order    = 0x01020304u;
+inline constexpr std::uint32_t sigdb_flag_compact  = 1u << 0;   // compact signatures
+inline constexpr std::uint32_t sigdb_type_byte_copy_safe = 1u << 0;
+
+/// A string in the pool: `size` bytes at `offset`, then a NUL.
+struct SigDbString {
+    std::uint32_t offset;
+    std::uint32_t size;
+};
+
+struct SigDbHeader {
+    char          magic[8];          // sigdb_magic
+    std::uint32_t version;           // sigdb_version
+    std::uint32_t byte_order;        // sigdb_byte_order as written
+    std::uint64_t file_size;
+    std::uint32_t flags;             // sigdb_flag_*
+    std::uint32_t type_count;
+    std::uint64_t types_offset;      // SigDbType[type_count]
+    std::uint64_t pool_offset;
+    std::uint64_t pool_size;
+    SigDbString   platform_name;
+    SigDbString   arch_prefix;
+    SigDbString   data_model;
+    std::uint32_t pointer_size;
+    std::uint32_t sizeof_long;
+    std::uint32_t sizeof_wchar_t;
+    std::uint32_t sizeof_long_double;
+    std::uint32_t max_align;
+    std::uint32_t reserved;
+};
+
+struct SigDbType {
+    std::uint64_t layout_hash;       // 0 = not exported
+    std::uint64_t name_hash;         // fnv1a_64(name)
+    SigDbString   name;
+    SigDbString   layout_sig;
+    std::uint32_t flags;             // sigdb_type_*
+    std::uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable_v<SigDbHeader> && sizeof(SigDbHeader) == 104);
+static_assert(std::is_trivially_copyable_v<SigDbType> && sizeof(SigDbType) == 40);
+
+/// Builds a .sigdb image for one platform.
+class SigDbWriter {
+public:
+    /// Platform metadata is taken from `platform`; its types are not added.
+    explicit SigDbWriter(const PlatformInfo& platform)
+        : platform_name_(platform.platform_name ? platform.platform_name : "")
+        , arch_prefix_(platform.arch_prefix ? platform.arch_prefix : "")
+        , data_model_(platform.data_model ? platform.data_model : "")
+        , pointer_size_(platform.pointer_size)
+        , sizeof_long_(platform.sizeof_long)
+        , sizeof_wchar_t_(platform.sizeof_wchar_t)
+        , sizeof_long_double_(platform.sizeof_long_double)
+        , max_align_(platform.max_align)
+    {}
+
+    void set_compact(bool compact) { compact_ = compact; }
+
+    void add(std::string_view name, std::string_view layout_sig,
+             bool byte_copy_safe, std::uint64_t layout_hash) {
+        types_.push_back({std::string(name), std::string(layout_sig),
+                          byte_copy_safe, layout_hash});
+    }
+
+    /// The file contents.  Types are sorted by name (stably, so the image
+    /// depends only on what was added).
+    std::string image() const {
+        std::vector<const Type*> order;
+        order.reserve(types_.size());
+        for (const auto& t : types_) order.push_back(&t);
+        std::stable_sort(order.begin(), order.end(), [](const Type* a, const Type* b) {
+            return a->name < b->name;
+        });
+
+        std::string pool;
+        SigDbHeader h{};
+        std::memcpy(h.magic, sigdb_magic, sizeof(h.magic));
+        h.version            = sigdb_version;
+        h.byte_order         = sigdb_byte_order;
+        h.flags              = compact_ ? sigdb_flag_compact : 0;
+        h.type_count         = static_cast<std::uint32_t>(types_.size());
+        h.platform_name      = intern(pool, platform_name_);
+        h.arch_prefix        = intern(pool, arch_prefix_);
+        h.data_model         = intern(pool, data_model_);
+        h.pointer_size       = static_cast<std::uint32_t>(pointer_size_);
+        h.sizeof_long        = static_cast<std::uint32_t>(sizeof_long_);
+        h.sizeof_wchar_t     = static_cast<std::uint32_t>(sizeof_wchar_t_);
+        h.sizeof_long_double = static_cast<std::uint32_t>(sizeof_long_double_);
+        h.max_align          = static_cast<std::uint32_t>(max_align_);
+
+        std::vector<SigDbType> records(order.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            const Type& t = *order[i];
+            SigDbType& r = records[i];
+            r.layout_hash = t.layout_hash;
+            r.name_hash   = detail::fnv1a_64(t.name);
+            r.name        = intern(pool, t.name);
+            r.layout_sig  = intern(pool, t.layout_sig);
+            r.flags       = t.byte_copy_safe ? sigdb_type_byte_copy_safe : 0;
+        }
+
+        h.types_offset = sizeof(SigDbHeader);
+        h.pool_offset  = h.types_offset + records.size() * sizeof(SigDbType);
+        h.pool_size    = pool.size();
+        h.file_size    = h.pool_offset + pool.size();
+
+        std::string out(static_cast<std::size_t>(h.file_size), '\0');
+        std::memcpy(out.data(), &h, sizeof(h));
+        if (!records.empty())
+            std::memcpy(out.data() + h.types_offset, records.data(),
+                        records.size() * sizeof(SigDbType));
+        if (!pool.empty())
+            std::memcpy(out.data() + h.pool_offset, pool.data(), pool.size());
+        return out;
+    }
+
+private:
+    struct Type {
+        std::string   name;
+        std::string   layout_sig;
+        bool          byte_copy_safe;
+        std::uint64_t layout_hash;
+    };
+
+    std::string       platform_name_;
+    std::string       arch_prefix_;
+    std::string       data_model_;
+    std::size_t       pointer_size_;
+    std::size_t       sizeof_long_;
+    std::size_t       sizeof_wchar_t_;
+    std::size_t       sizeof_long_double_;
+    std::size_t       max_align_;
+    bool              compact_ = false;
+    std::vector<Type> types_;
+
+    static SigDbString intern(std::string& pool, std::string_view s) {
+        SigDbString r{static_cast<std::uint32_t>(pool.size()),
+                      static_cast<std::uint32_t>(s.size())};
+        pool.append(s);
+        pool += '\0';
+        return r;
+    }
+};
+
+/// .sigdb image of an exported platform, e.g. to convert a .sig.hpp.
+inline std::string sigdb_image(const PlatformInfo& platform, bool compact = false) {
+    SigDbWriter w(platform);
+    w.set_compact(compact);
+    for (std::size_t i = 0; i < platform.type_count; ++i) {
+        const TypeEntry& e = platform.types[i];
+        w.add(e.name, e.layout_sig, e.byte_copy_safe, e.layout_hash);
+    }
+    return w.image();
+}
+
+/// A memory-mapped .sigdb.  platform_info() stays valid while the SigDb
+/// lives; the SigDb may be moved without invalidating it.
+class SigDb {
+public:
+    /// Maps `path` and validates its structure; false (with `error` set)
+    /// on failure.  With `verify_hashes`, also verify() it.
+    bool open(const std::string& path, std::string* error = nullptr,
+              bool verify_hashes = false) {
+        types_.clear();
+        name_hashes_.clear();
+        if (!file_.open(path, error)) return false;
+        if (!load() || (verify_hashes && !verify())) {
+            file_.close();
+            types_.clear();
+            name_hashes_.clear();
+            if (error) *error = path + ": not a valid signature database";
+            return false;
+        }
+        return true;
+    }
+
+    /// True when every stored hash is that of its string: comparisons
+    /// trust layout_hash, and lookups trust name_hash.
+    bool verify() const {
+        for (std::size_t i = 0; i < types_.size(); ++i)
+            if (!verify_type(i)) return false;
+        return true;
+    }
+
+    /// verify() for the type at `i` of platform_info().types.  Layout
+    /// hashes are of the full signature, so a compact one is expanded.
+    bool verify_type(std::size_t i) const {
+        if (i >= types_.size()) return false;
+        SigDbType t;
+        std::memcpy(&t, file_.data() + header_.types_offset + i * sizeof(SigDbType),
+                    sizeof(t));
+        const std::string_view name(types_[i].name, t.name.size);
+        const std::string_view sig(types_[i].layout_sig, t.layout_sig.size);
+        if (t.name_hash != detail::fnv1a_64(name)) return false;
+        if (t.layout_hash == 0) return true;
+        if (!is_compact_signature(sig)) return t.layout_hash == layout_hash(sig);
+        const std::string full = expand_signature(sig);
+        return !full.empty() && t.layout_hash == layout_hash(full);
+    }
+
+    PlatformInfo platform_info() const noexcept {
+        return {platform_name_, arch_prefix_, types_.data(), types_.size(),
+                header_.pointer_size, header_.sizeof_long, header_.sizeof_wchar_t,
+                header_.sizeof_long_double, header_.max_align, data_model_};
+    }
+
+    /// fnv1a_64 of each type name, index-aligned with platform_info().types.
+    const std::vector<std::uint64_t>& name_hashes() const noexcept { return name_hashes_; }
+
+    bool compact() const noexcept { return (header_.flags & sigdb_flag_compact) != 0; }
+
+private:
+    detail::MappedFile         file_;
+    SigDbHeader                header_{};
+    const char*                platform_name_ = "";
+    const char*                arch_prefix_   = "";
+    const char*                data_model_    = "";
+    std::vector<TypeEntry>     types_;          // strings point into file_
+    std::vector<std::uint64_t> name_hashes_;
+
+    bool load() {
+        const unsigned char* base = file_.data();
+        const std::uint64_t  size = file_.size();
+        if (size < sizeof(SigDbHeader)) return false;
+        std::memcpy(&header_, base, sizeof(header_));
+        const SigDbHeader& h = header_;
+        if (std::memcmp(h.magic, sigdb_magic, sizeof(h.magic)) != 0 ||
+            h.version != sigdb_version || h.byte_order != sigdb_byte_order ||
+            h.file_size != size)
+            return false;
+        if (h.types_offset < sizeof(SigDbHeader) || h.types_offset > size ||
+            (size - h.types_offset) / sizeof(SigDbType) < h.type_count)
+            return false;
+        if (h.pool_offset > size || h.pool_size > size - h.pool_offset ||
+            h.pool_offset < h.types_offset + std::uint64_t{h.type_count} * sizeof(SigDbType))
+            return false;
+
+        const char* pool = reinterpret_cast<const char*>(base + h.pool_offset);
+        auto str = [&](const SigDbString& s, const char*& out) {
+            if (s.offset > h.pool_size || s.size >= h.pool_size - s.offset ||
+                pool[s.offset + s.size] != '\0')
+                return false;
+            out = pool + s.offset;
+            return true;
+        };
+        if (!str(h.platform_name, platform_name_) || !str(h.arch_prefix, arch_prefix_) ||
+            !str(h.data_model, data_model_))
+            return false;
+
+        types_.resize(h.type_count);
+        name_hashes_.resize(h.type_count);
+        const unsigned char* rec = base + h.types_offset;
+        for (std::size_t i = 0; i < h.type_count; ++i, rec += sizeof(SigDbType)) {
+            SigDbType t;
+            std::memcpy(&t, rec, sizeof(t));
+            TypeEntry& e = types_[i];
+            if (!str(t.name, e.name) || !str(t.layout_sig, e.layout_sig)) return false;
+            e.byte_copy_safe = (t.flags & sigdb_type_byte_copy_safe) != 0;
+            e.layout_hash    = t.layout_hash;
+            name_hashes_[i]  = t.name_hash;
+        }
+        return true;
+    }
+};
+
+} // inline namespace v1
+} // namespace typelayout
+} // namespace boost
+
+#endif // BOOST_TYPELAYOUT_TOOLS_SIGDB_HPP
@@ -12,5 +12,6 @@
 #include <boost/typelayout/signature.hpp>
 #include <boost/typelayout/opaque.hpp>
 #include <boost/typelayout/admission.hpp>
+#include <boost/typelayout/signature_table.hpp>
 
 #endif // BOOST_TYPELAYOUT_HPP
\ No newline at end of file
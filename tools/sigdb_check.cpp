@@ -0,0 +1,85 @@
+// typelayout_sigdb_check -- generic Phase 2 checker over .sigdb files.
+//
+// Compares any set of signature databases written by SigExporter (the
+// export macros with --sigdb) and prints the same report as
+// TYPELAYOUT_CHECK_COMPAT, without compiling a per-project check program.
+// The databases are memory-mapped (CompatReporter::add_platform_mmap).
+//
+// Usage: typelayout_sigdb_check [--diff] [--verify] [--format F]
+//                               [--threads N] [--cache PATH] platform.sigdb...
+//
+//   --diff       annotate DIFFER rows with field diffs (print_diff_report)
+//   --verify     check every stored hash against its string (SigDb::verify)
+//   --format F   text (default), jsonl, junit or sarif; the machine-readable
+//                formats stream with bounded memory (TYPELAYOUT_COMPAT_FORMAT)
+//   --threads N  as for TYPELAYOUT_CHECK_COMPAT (TYPELAYOUT_COMPAT_THREADS)
+//   --cache P    result cache file (TYPELAYOUT_COMPAT_CACHE)
+//
+// Exit status: 0 when every type is transfer-safe, 1 when not, 2 on a
+// usage error or an unreadable database.
+//
+// Copyright (c) 2024-2026 TypeLayout Development Team
+// Distributed under the Boost Software License, Version 1.0.
+
+#include <boost/typelayout/tools/compat_auto.hpp>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tlc = boost::typelayout::compat;
+
+int main(int argc, char* argv[]) {
+    bool with_diff = false;
+    bool verify = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--diff") {
+            with_diff = true;
+        } else if (arg == "--verify") {
+            verify = true;
+        } else if (arg == "--threads" || arg == "--cache" || arg == "--format") {
+            ++i;   // the value is read by compat_*_option() below
+        } else if (arg.starts_with("--threads=") || arg.starts_with("--cache=") ||
+                   arg.starts_with("--format=")) {
+            continue;
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "usage: " << argv[0]
+                      << " [--diff] [--verify] [--format F] [--threads N]"
+                         " [--cache PATH] platform.sigdb...\n";
+            return 0;
+        } else if (arg.starts_with("--")) {
+            std::cerr << argv[0] << ": unknown option " << arg << "\n";
+            return 2;
+        } else {
+            paths.emplace_back(arg);
+        }
+    }
+    if (paths.empty()) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--diff] [--verify] [--format F] [--threads N]"
+                     " [--cache PATH] platform.sigdb...\n";
+        return 2;
+    }
+
+    tlc::CompatReporter reporter;
+    reporter.set_threads(tlc::detail::compat_threads_option(argc, argv));
+    if (const char* cache = tlc::detail::compat_cache_option(argc, argv))
+        reporter.set_cache_file(cache);
+    for (const auto& path : paths) {
+        std::string error;
+        if (!reporter.add_platform_mmap(path, &error, verify)) {
+            std::cerr << argv[0] << ": " << error << "\n";
+            return 2;
+        }
+    }
+
+    const tlc::ReportFormat format = tlc::detail::compat_format_option(argc, argv);
+    const bool safe = with_diff && format == tlc::ReportFormat::text
+                          ? reporter.print_diff_report()
+                          : tlc::write_report(reporter, std::cout, format);
+    reporter.save_cache();
+    return safe ? 0 : 1;
+}